@@ -68,7 +68,7 @@ int main()
 
     aig = cleanup_dangling( aig );
 
-    const auto cec = benchmark == "hyp" ? true : abc_cec( aig, benchmark );
+    const auto cec = benchmark == "hyp" ? true : mockturtle_cec( aig, benchmark );
 
     exp( benchmark, size_before, aig.num_gates(), to_seconds( st.time_total ), cec );
   }
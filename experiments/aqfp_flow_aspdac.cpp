@@ -165,7 +165,7 @@ int main()
     }
 
     /* cec */
-    auto cec = abc_cec( buffered_aqfp, benchmark );
+    auto cec = mockturtle_cec( buffered_aqfp, benchmark );
     std::vector<uint32_t> pi_levels;
     for ( auto i = 0u; i < buffered_aqfp.num_pis(); ++i )
       pi_levels.emplace_back( 0 );
@@ -28,14 +28,9 @@
 #include <vector>
 
 #include <fmt/format.h>
-#include <mockturtle/algorithms/collapse_mapped.hpp>
-#include <mockturtle/algorithms/cut_enumeration/cnf_cut.hpp>
 #include <mockturtle/algorithms/equivalence_checking.hpp>
-#include <mockturtle/algorithms/lut_mapping.hpp>
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
-#include <mockturtle/networks/klut.hpp>
-#include <mockturtle/views/mapping_view.hpp>
 
 #include <experiments.hpp>
 
@@ -44,7 +39,7 @@ int main()
   using namespace experiments;
   using namespace mockturtle;
 
-  experiment<std::string, double, bool, double, double, bool> exp( "cnf_map", "benchmark", "time_tseytin", "eq_tseytin", "time_mapping", "time_cnfmap", "eq_cnfmap" );
+  experiment<std::string, double, bool, double, bool> exp( "cnf_map", "benchmark", "time_tseytin", "eq_tseytin", "time_cnfmap", "eq_cnfmap" );
 
   for ( auto i = 4u; i < 6u; ++i )
   {
@@ -65,20 +60,16 @@ int main()
                     [&]( auto const& a, auto const& b ) { return aig.create_xor( a, b ); } );
     aig.create_po( aig.create_nary_or( xors ) );
 
+    equivalence_checking_params ps;
+    ps.functional_reduction = false;
     equivalence_checking_stats st;
-    const auto result = *equivalence_checking( aig, {}, &st );
-
-    lut_mapping_params lmps;
-    lmps.cut_enumeration_ps.cut_size = 8;
-    lut_mapping_stats lmst;
-    mapping_view<aig_network, true> mapped_aig{ aig };
-    lut_mapping<decltype( mapped_aig ), true, cut_enumeration_mf_cut>( mapped_aig, lmps, &lmst );
-    const auto klut = *collapse_mapped_network<klut_network>( mapped_aig );
+    const auto result = *equivalence_checking( aig, ps, &st );
 
+    ps.cut_based_cnf = true;
     equivalence_checking_stats st2;
-    const auto result2 = *equivalence_checking( klut, {}, &st2 );
+    const auto result2 = *equivalence_checking( aig, ps, &st2 );
 
-    exp( benchmark, to_seconds( st.time_total ), result, to_seconds( lmst.time_total ), to_seconds( st2.time_total ), result2 );
+    exp( benchmark, to_seconds( st.time_total ), result, to_seconds( st2.time_total ), result2 );
   }
 
   exp.save();
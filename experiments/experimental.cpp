@@ -59,7 +59,7 @@ int main()
     window_aig_enumerative_resub( aig, ps, &st );
     aig = cleanup_dangling( aig );
 
-    const auto cec = ps.dry_run || benchmark == "hyp" ? true : abc_cec( aig, benchmark );
+    const auto cec = ps.dry_run || benchmark == "hyp" ? true : mockturtle_cec( aig, benchmark );
     exp( benchmark, st.initial_size, st.initial_size - aig.num_gates(), st.estimated_gain, st.num_solutions, to_seconds( st.time_total ), cec );
   }
 
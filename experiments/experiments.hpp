@@ -46,8 +46,12 @@
 
 #include <fmt/color.h>
 #include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/output_equivalence_checking.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
 #include <mockturtle/io/write_bench.hpp>
 #include <mockturtle/io/write_verilog.hpp>
+#include <mockturtle/networks/aig.hpp>
 #include <nlohmann/json.hpp>
 
 namespace experiments
@@ -607,4 +611,33 @@ inline bool abc_cec_mapped_cell( Ntk const& ntk, std::string const& benchmark, s
   return abc_cec_mapped_cell_impl( ntk, benchmark_path( benchmark ), cell_libraries_path( library ) );
 }
 
+/*! \brief Checks `ntk` against the AIGER file `benchmark_fullpath` in-process.
+ *
+ * Unlike `abc_cec_impl`, no files are written and no external process is
+ * started.  Mapped networks (`binding_view<klut_network>`,
+ * `cell_view<block_network>`) are checked from their node functions, i.e.,
+ * without the cell library.
+ */
+template<class Ntk>
+inline bool mockturtle_cec_impl( Ntk const& ntk, std::string const& benchmark_fullpath, uint32_t num_threads = 1u )
+{
+  mockturtle::aig_network aig;
+  if ( lorina::read_aiger( benchmark_fullpath, mockturtle::aiger_reader( aig ) ) != lorina::return_code::success )
+  {
+    return false;
+  }
+
+  mockturtle::output_equivalence_checking_params ps;
+  ps.num_threads = num_threads;
+  ps.stop_at_first_cex = true;
+  auto const result = mockturtle::output_equivalence_checking( ntk, aig, ps );
+  return result && *result;
+}
+
+template<class Ntk>
+inline bool mockturtle_cec( Ntk const& ntk, std::string const& benchmark, uint32_t num_threads = 1u )
+{
+  return mockturtle_cec_impl( ntk, benchmark_path( benchmark ), num_threads );
+}
+
 } // namespace experiments
@@ -216,7 +216,7 @@ int main( int argc, char* argv[] )
     stopwatch<>::duration rt{0};
     Ntk opt = call_with_stopwatch( rt, [&](){ return deepsyn_mig_v1( ntk, ps ); } );
     //write_verilog( opt, "best_MIGs/" + benchmark + ".v" );
-    bool const cec = ( benchmark == "hyp" ) ? true : abc_cec_impl( opt, benchmark_path( benchmark ) );
+    bool const cec = ( benchmark == "hyp" ) ? true : mockturtle_cec( opt, benchmark );
     depth_view d( opt );
 
     exp( benchmark, ntk.num_gates(), opt.num_gates(), d.depth(), to_seconds(rt), cec );
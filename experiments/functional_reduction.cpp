@@ -58,7 +58,7 @@ int main()
     functional_reduction( aig, ps, &st );
     aig = cleanup_dangling( aig );
 
-    const auto cec = benchmark == "hyp" ? true : abc_cec( aig, benchmark );
+    const auto cec = benchmark == "hyp" ? true : mockturtle_cec( aig, benchmark );
 
     exp( benchmark, size_before, aig.num_gates(), st.num_const_accepts, st.num_equ_accepts, to_seconds( st.time_total ), cec );
   }
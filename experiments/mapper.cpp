@@ -104,8 +104,8 @@ int main()
 
     binding_view<klut_network> res2 = map( aig, tech_lib, ps2, &st2 );
 
-    const auto cec1 = benchmark == "hyp" ? true : abc_cec( res1, benchmark );
-    const auto cec2 = benchmark == "hyp" ? true : abc_cec( res2, benchmark );
+    const auto cec1 = benchmark == "hyp" ? true : mockturtle_cec( res1, benchmark );
+    const auto cec2 = benchmark == "hyp" ? true : mockturtle_cec( res2, benchmark );
 
     const uint32_t depth_mig = depth_view( res1 ).depth();
 
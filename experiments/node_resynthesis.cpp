@@ -73,7 +73,7 @@ int main()
     dsd_resynthesis<aig_network, decltype( exact_resyn )> resyn( exact_resyn );
     aig_network aig2 = node_resynthesis<aig_network>( klut, resyn, {}, &nrst );
 
-    auto cec = abc_cec( aig2, benchmark ); //*equivalence_checking( *miter<aig_network>( aig, aig2 ) );
+    auto cec = mockturtle_cec( aig2, benchmark ); //*equivalence_checking( *miter<aig_network>( aig, aig2 ) );
 
     exp( benchmark, aig2.num_gates(), to_seconds( st.time_total ) + to_seconds( nrst.time_total ), cec );
   }
@@ -91,7 +91,7 @@ int main()
 
     satlut_mapping<mapping_view<aig_network, true>, true>( mapped_aig, 32u, slps, &st );
 
-    auto cec = abc_cec( aig, benchmark );
+    auto cec = mockturtle_cec( aig, benchmark );
 
     exp( benchmark, baseline[benchmark], cells_init, mapped_aig.num_cells(), to_seconds( st.time_total ), cec );
   }
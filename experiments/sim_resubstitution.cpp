@@ -63,7 +63,7 @@ int main()
     sim_resubstitution( aig, ps, &st );
     aig = cleanup_dangling( aig );
 
-    const auto cec = benchmark == "hyp" ? true : abc_cec( aig, benchmark );
+    const auto cec = benchmark == "hyp" ? true : mockturtle_cec( aig, benchmark );
 
     exp( benchmark, size_before, size_before - aig.num_gates(), to_seconds( st.time_total ), cec );
   }
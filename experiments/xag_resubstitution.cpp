@@ -66,7 +66,7 @@ int main()
     xag_resubstitution( fanout_xag, ps, &st );
     xag = cleanup_dangling( xag );
 
-    bool const cec = benchmark == "hyp" ? true : abc_cec( fanout_xag, benchmark );
+    bool const cec = benchmark == "hyp" ? true : mockturtle_cec( fanout_xag, benchmark );
     exp( benchmark, size_before, xag.num_gates(), to_seconds( st.time_total ), cec );
   }
 
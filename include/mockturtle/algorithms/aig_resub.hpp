@@ -841,6 +841,18 @@ void aig_resubstitution( Ntk& ntk, resubstitution_params const& ps = {}, resubst
   static_assert( has_value_v<Ntk>, "Ntk does not implement the has_value method" );
   static_assert( has_visited_v<Ntk>, "Ntk does not implement the has_visited method" );
 
+  if constexpr ( std::is_same_v<Ntk, typename Ntk::base_type> )
+  {
+    if ( ps.num_threads > 1u )
+    {
+      detail::parallel_resubstitution( ntk, ps, pst, []( Ntk& part, resubstitution_params const& part_ps, resubstitution_stats* part_st ) {
+        aig_resubstitution( part, part_ps, part_st );
+      } );
+      return;
+    }
+  }
+
+
   using resub_view_t = fanout_view<depth_view<Ntk>>;
   depth_view<Ntk> depth_view{ ntk };
   resub_view_t resub_view{ depth_view };
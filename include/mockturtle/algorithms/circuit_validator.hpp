@@ -36,12 +36,18 @@
 #include "../networks/events.hpp"
 #include "../utils/index_list/index_list.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/portfolio_solver.hpp"
+#include "../utils/stopwatch.hpp"
 #include "cnf.hpp"
 
 #include <bill/sat/interface/abc_bsat2.hpp>
 #include <bill/sat/interface/common.hpp>
 #include <bill/sat/interface/glucose.hpp>
 #include <bill/sat/interface/z3.hpp>
+#include <fmt/format.h>
+
+#include <tuple>
+#include <vector>
 
 namespace mockturtle
 {
@@ -59,8 +65,61 @@ struct validator_params
 
   /*! \brief Seed for randomized solving. */
   uint32_t random_seed{ 0 };
+
+  /*! \brief Maximum number of retired clauses (of validation miters and of deleted nodes) before the solver is restarted. */
+  uint32_t max_retired_clauses{ 10000 };
+
+  /*! \brief Additional SAT solvers which run concurrently on hard problems (see `portfolio_solver`). */
+  std::vector<portfolio_member> portfolio{};
+};
+
+struct validator_stats
+{
+  /*! \brief Number of encoded nodes. */
+  uint32_t num_encoded_nodes{ 0 };
+
+  /*! \brief Number of clauses of encoded nodes. */
+  uint64_t num_encoded_clauses{ 0 };
+
+  /*! \brief Number of retired clauses. */
+  uint64_t num_retired_clauses{ 0 };
+
+  /*! \brief Number of SAT calls. */
+  uint32_t num_solves{ 0 };
+
+  /*! \brief Number of solver restarts. */
+  uint32_t num_restarts{ 0 };
+
+  /*! \brief Time for encoding nodes. */
+  stopwatch<>::duration time_encode{ 0 };
+
+  /*! \brief Time for SAT solving. */
+  stopwatch<>::duration time_solve{ 0 };
+
+  void report() const
+  {
+    // clang-format off
+    fmt::print( "[i] encoded nodes   = {:8d} ({} clauses)\n", num_encoded_nodes, num_encoded_clauses );
+    fmt::print( "[i] retired clauses = {:8d}\n", num_retired_clauses );
+    fmt::print( "[i] SAT calls       = {:8d}\n", num_solves );
+    fmt::print( "[i] restarts        = {:8d}\n", num_restarts );
+    fmt::print( "[i] encoding time   = {:>5.2f} secs\n", to_seconds( time_encode ) );
+    fmt::print( "[i] solving time    = {:>5.2f} secs\n", to_seconds( time_solve ) );
+    // clang-format on
+  }
 };
 
+/*! \brief SAT-based validation of functional equivalence in a network.
+ *
+ * The CNF of the network is built incrementally: the cone of a node is only
+ * encoded when a validation involves it, and it is kept in the solver for
+ * later validations.  Clauses which are only needed for one validation (the
+ * miter and candidate circuits given as index lists) are guarded by an
+ * activation literal and retired after solving by asserting its negation.
+ * The clauses of nodes deleted from the network are retired as well.  The
+ * solver is restarted when the live clauses exceed `max_clauses` or the
+ * retired clauses exceed `max_retired_clauses`.
+ */
 template<class Ntk, bill::solvers Solver = bill::solvers::glucose_41, bool use_pushpop = false, bool randomize = false, bool use_odc = false>
 class circuit_validator
 {
@@ -79,7 +138,7 @@ public:
   };
 
   explicit circuit_validator( Ntk const& ntk, validator_params const& ps = {} )
-      : ntk( ntk ), ps( ps ), literals( ntk ), constructed( ntk ), num_invoke( 0u ), cex( ntk.num_pis() )
+      : ntk( ntk ), ps( ps ), literals( ntk ), constructed( ntk ), solver( ps.portfolio ), num_invoke( 0u ), cex( ntk.num_pis() )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
@@ -124,6 +183,17 @@ public:
       literals.resize();
     } );
 
+    /* the clauses of deleted nodes stay in the solver until the next restart */
+    delete_event = ntk.events().register_delete_event( [&]( node const& n ) {
+      if ( constructed.has( n ) )
+      {
+        live_clauses -= constructed[n];
+        retired_clauses += constructed[n];
+        st.num_retired_clauses += constructed[n];
+        constructed.erase( n );
+      }
+    } );
+
     /* constants are mapped to var 0 */
     literals[ntk.get_constant( false )] = bill::lit_type( 0, bill::lit_type::polarities::positive );
     if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
@@ -142,6 +212,13 @@ public:
   ~circuit_validator()
   {
     ntk.events().release_add_event( add_event );
+    ntk.events().release_delete_event( delete_event );
+  }
+
+  /*! \brief Statistics of encoding and solving. */
+  validator_stats const& stats() const
+  {
+    return st;
   }
 
   /*! \brief Set ODC levels */
@@ -158,10 +235,7 @@ public:
       construct( ntk.get_node( d ) );
     }
     auto const res = validate( ntk.get_node( f ), lit_not_cond( literals[d], ntk.is_complemented( f ) ^ ntk.is_complemented( d ) ) );
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    restart_if_needed();
     return res;
   }
 
@@ -173,10 +247,7 @@ public:
       construct( ntk.get_node( d ) );
     }
     auto const res = validate( root, lit_not_cond( literals[d], ntk.is_complemented( d ) ) );
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    restart_if_needed();
     return res;
   }
 
@@ -234,6 +305,7 @@ public:
       lits.emplace_back( literals[*it] );
     }
 
+    begin_temporary();
     if constexpr ( use_pushpop )
     {
       push();
@@ -285,11 +357,9 @@ public:
     {
       pop();
     }
+    end_temporary();
 
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    restart_if_needed();
 
     return res;
   }
@@ -317,7 +387,9 @@ public:
         {
           push();
         }
+        begin_temporary();
         res = solve( { build_odc_window( root, ~literals[root] ), lit_not_cond( literals[root], value ) } );
+        end_temporary();
         if constexpr ( use_pushpop )
         {
           pop();
@@ -333,10 +405,7 @@ public:
       res = solve( { lit_not_cond( literals[root], value ) } );
     }
 
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    restart_if_needed();
     return res;
   }
 
@@ -400,10 +469,7 @@ public:
     }
 
     pop();
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    restart_if_needed();
     return generated;
   }
 
@@ -414,13 +480,26 @@ public:
    */
   void update()
   {
+    ++st.num_restarts;
     restart();
   }
 
 private:
+  void restart_if_needed()
+  {
+    if ( num_invoke >= MIN_NUM_INVOKE && ( live_clauses > ps.max_clauses || retired_clauses > ps.max_retired_clauses ) )
+    {
+      ++st.num_restarts;
+      restart();
+    }
+  }
+
   void restart()
   {
+    assert( temporary_depth == 0u );
     num_invoke = 0u;
+    live_clauses = 0u;
+    retired_clauses = 0u;
     solver.restart();
     if constexpr ( randomize )
     {
@@ -479,6 +558,20 @@ private:
   }
 
   bill::lit_type construct( node const& n )
+  {
+    if ( encoding )
+    {
+      return construct_rec( n );
+    }
+
+    stopwatch<> t( st.time_encode );
+    encoding = true;
+    auto const lit = construct_rec( n );
+    encoding = false;
+    return lit;
+  }
+
+  bill::lit_type construct_rec( node const& n )
   {
     assert( !constructed.has( n ) && !ntk.is_pi( n ) && !ntk.is_constant( n ) );
     if constexpr ( use_pushpop )
@@ -493,12 +586,12 @@ private:
     ntk.foreach_fanin( n, [&]( auto const& f ) {
       if ( !constructed.has( f ) && !ntk.is_pi( ntk.get_node( f ) ) && !ntk.is_constant( ntk.get_node( f ) ) )
       {
-        construct( ntk.get_node( f ) );
+        construct_rec( ntk.get_node( f ) );
       }
       child_lits.push_back( lit_not_cond( literals[f], ntk.is_complemented( f ) ) );
     } );
     bill::lit_type node_lit = literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-    constructed[n] = true;
+    auto const num_clauses_before = live_clauses;
 
     if ( ntk.is_and( n ) )
     {
@@ -520,14 +613,59 @@ private:
     {
       detail::on_ite<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], add_clause_fn );
     }
+
+    constructed[n] = live_clauses - num_clauses_before;
+    ++st.num_encoded_nodes;
+    st.num_encoded_clauses += constructed[n];
     return node_lit;
   }
 
+  /* clauses added outside of `construct` while a temporary scope is open are
+     guarded by its activation literal, which is assumed in every SAT call of
+     the scope and negated when the scope is closed */
+  void begin_temporary()
+  {
+    if ( temporary_depth++ == 0u )
+    {
+      activation = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+      num_temporary = 0u;
+    }
+  }
+
+  void end_temporary()
+  {
+    assert( temporary_depth > 0u );
+    /* clauses added after `push` are removed by `pop` instead */
+    if ( --temporary_depth == 0u && !between_push_pop )
+    {
+      solver.add_clause( ~activation );
+      retired_clauses += num_temporary;
+      st.num_retired_clauses += num_temporary;
+    }
+  }
+
+  void add_clause( std::vector<bill::lit_type> const& clause )
+  {
+    if ( temporary_depth > 0u && !encoding )
+    {
+      auto guarded = clause;
+      guarded.emplace_back( ~activation );
+      solver.add_clause( guarded );
+      ++num_temporary;
+    }
+    else
+    {
+      solver.add_clause( clause );
+      ++live_clauses;
+    }
+  }
+
   void push()
   {
     solver.push();
     between_push_pop = true;
     tmp.clear();
+    saved_counters = { live_clauses, retired_clauses, num_temporary };
   }
 
   void pop()
@@ -538,6 +676,7 @@ private:
       constructed.erase( n );
     }
     between_push_pop = false;
+    std::tie( live_clauses, retired_clauses, num_temporary ) = saved_counters;
   }
 
   bill::lit_type add_clauses_for_2input_gate( bill::lit_type a, bill::lit_type b, std::optional<bill::lit_type> c = std::nullopt, gate_type type = AND )
@@ -581,7 +720,12 @@ private:
   std::optional<bool> solve( std::vector<bill::lit_type> assumptions )
   {
     ++num_invoke;
-    auto const res = solver.solve( assumptions, ps.conflict_limit );
+    ++st.num_solves;
+    if ( temporary_depth > 0u )
+    {
+      assumptions.emplace_back( activation );
+    }
+    auto const res = call_with_stopwatch( st.time_solve, [&]() { return solver.solve( assumptions, ps.conflict_limit ); } );
 
     if ( res == bill::result::states::satisfiable )
     {
@@ -623,27 +767,23 @@ private:
         {
           push();
         }
+        begin_temporary();
         res = solve( { build_odc_window( root, lit ) } );
+        end_temporary();
         if constexpr ( use_pushpop )
         {
           pop();
         }
-      }
-      else
-      {
-        auto nlit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-        solver.add_clause( { literals[root], lit, nlit } );
-        solver.add_clause( { ~( literals[root] ), ~lit, nlit } );
-        res = solve( { ~nlit } );
+        return res;
       }
     }
-    else
-    {
-      auto nlit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-      solver.add_clause( { literals[root], lit, nlit } );
-      solver.add_clause( { ~( literals[root] ), ~lit, nlit } );
-      res = solve( { ~nlit } );
-    }
+
+    /* miter of `root` and `lit` */
+    begin_temporary();
+    add_clause( { literals[root], lit } );
+    add_clause( { ~literals[root], ~lit } );
+    res = solve( {} );
+    end_temporary();
 
     return res;
   }
@@ -681,8 +821,8 @@ private:
         auto assump = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
         ntk.foreach_po( [&]( auto const& f, auto i ) {
           auto dup_po_lit = lit_not_cond( lits.has( ntk.get_node( f ) ) ? lits[f] : literals[f], ntk.is_complemented( f ) );
-          solver.add_clause( {~assump, ~po_lits_link[i], dup_po_lit} );
-          solver.add_clause( {~assump, po_lits_link[i], ~dup_po_lit} );
+          add_clause( { ~assump, ~po_lits_link[i], dup_po_lit } );
+          add_clause( { ~assump, po_lits_link[i], ~dup_po_lit } );
         } );
         return assump;
       }
@@ -699,7 +839,7 @@ private:
     assert( miter.size() > 0 && "no fanout node at distance odc_levels and there is no PO in TFO cone (possibly due to a dangling cone)" );
     auto assump = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
     miter.emplace_back( ~assump );
-    solver.add_clause( miter );
+    add_clause( miter );
     return assump;
   }
 
@@ -778,9 +918,9 @@ private:
   validator_params ps;
 
   node_map<bill::lit_type, Ntk> literals;
-  unordered_node_map<bool, Ntk> constructed;
-  bill::solver<Solver> solver;
-  add_clause_fn_t add_clause_fn = [&]( auto const& clause ) { solver.add_clause( clause ); };
+  unordered_node_map<uint32_t, Ntk> constructed;
+  portfolio_solver<Solver> solver;
+  add_clause_fn_t add_clause_fn = [&]( auto const& clause ) { add_clause( clause ); };
 
   static const uint32_t MIN_NUM_INVOKE = 20u;
   uint32_t num_invoke;
@@ -789,6 +929,18 @@ private:
   std::vector<node> tmp;
 
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
+
+  /* clause lifetime management */
+  uint32_t live_clauses{ 0u };
+  uint32_t retired_clauses{ 0u };
+  bool encoding{ false };
+  uint32_t temporary_depth{ 0u };
+  uint32_t num_temporary{ 0u };
+  bill::lit_type activation;
+  std::tuple<uint32_t, uint32_t, uint32_t> saved_counters;
+
+  validator_stats st;
 
   std::vector<bill::lit_type> po_lits_link;
 
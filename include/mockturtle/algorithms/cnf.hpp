@@ -37,6 +37,7 @@
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include <bill/sat/interface/common.hpp>
@@ -44,9 +45,16 @@
 #include <fmt/format.h>
 #include <kitty/cnf.hpp>
 #include <kitty/constructors.hpp>
+#include <kitty/cube.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
+#include "../views/mapping_view.hpp"
+#include "cut_enumeration/cnf_cut.hpp"
+#include "lut_mapping.hpp"
 
 namespace mockturtle
 {
@@ -257,6 +265,30 @@ inline void on_function( bill::lit_type f, std::vector<bill::lit_type> const& ch
 template<class lit_t>
 using clause_callback_t = std::function<void( std::vector<lit_t> const& )>;
 
+/*! \brief Parameters for generate_cnf.
+ *
+ * The data structure `generate_cnf_params` holds configurable parameters with
+ * default arguments for `generate_cnf`.
+ */
+struct generate_cnf_params
+{
+  /*! \brief Encode cuts instead of single gates.
+   *
+   * If true, the network is first covered with cuts that minimize the total
+   * number of clauses (using `lut_mapping` with `cut_enumeration_cnf_cut`),
+   * and each cut is encoded with the ISOP-based CNF of its function.  Only
+   * the constant, the primary inputs, and the roots of the selected cuts are
+   * constrained, the literals of all other nodes are left unused.
+   */
+  bool cut_based{ false };
+
+  /*! \brief Maximum number of leaves in a cut (for `cut_based`). */
+  uint32_t cut_size{ 4u };
+
+  /*! \brief Maximum number of cuts per node (for `cut_based`). */
+  uint32_t cut_limit{ 8u };
+};
+
 /*! \brief Create a default node literal map.
  *
  * In the default map, constants are mapped to variable `0` (literal `1` for
@@ -326,14 +358,74 @@ node_map<lit_t, Ntk> node_literals( Ntk const& ntk, std::optional<uint32_t> cons
 namespace detail
 {
 
+/* CNFs of cut functions, shared by all functions in the same NPN class */
+class cnf_template_cache
+{
+public:
+  /* clauses of the characteristic function of `function`, the last variable is the output */
+  std::vector<kitty::cube> const& operator()( kitty::dynamic_truth_table const& function )
+  {
+    if ( auto it = templates_.find( function ); it != templates_.end() )
+    {
+      return it->second;
+    }
+
+    /* exact canonization is cheap enough for small functions, otherwise any
+       consistent representative works as key */
+    auto const config = function.num_vars() <= 4u ? kitty::exact_npn_canonization( function ) : kitty::sifting_npn_canonization( function );
+    auto const& repr = std::get<0>( config );
+    auto const phase = std::get<1>( config );
+    auto const& perm = std::get<2>( config );
+
+    auto it_class = classes_.find( repr );
+    if ( it_class == classes_.end() )
+    {
+      it_class = classes_.emplace( repr, kitty::cnf_characteristic( repr ) ).first;
+    }
+
+    /* function = repr( x_perm[0] ^ phase_perm[0], ... ) ^ phase_n */
+    auto const num_vars = function.num_vars();
+    std::vector<kitty::cube> clauses;
+    clauses.reserve( it_class->second.size() );
+    for ( auto const& c : it_class->second )
+    {
+      kitty::cube clause;
+      for ( auto i = 0u; i < num_vars; ++i )
+      {
+        if ( c.get_mask( i ) )
+        {
+          clause.add_literal( perm[i], c.get_bit( i ) != ( ( phase >> perm[i] ) & 1 ) );
+        }
+      }
+      if ( c.get_mask( num_vars ) )
+      {
+        clause.add_literal( num_vars, c.get_bit( num_vars ) != ( ( phase >> num_vars ) & 1 ) );
+      }
+      clauses.push_back( clause );
+    }
+
+    return templates_.emplace( function, std::move( clauses ) ).first->second;
+  }
+
+  uint32_t num_classes() const
+  {
+    return static_cast<uint32_t>( classes_.size() );
+  }
+
+private:
+  std::unordered_map<kitty::dynamic_truth_table, std::vector<kitty::cube>, kitty::hash<kitty::dynamic_truth_table>> classes_;
+  std::unordered_map<kitty::dynamic_truth_table, std::vector<kitty::cube>, kitty::hash<kitty::dynamic_truth_table>> templates_;
+};
+
 template<class Ntk, typename lit_t>
 class generate_cnf_impl
 {
 public:
-  generate_cnf_impl( Ntk const& ntk, clause_callback_t<lit_t> const& fn, std::optional<node_map<lit_t, Ntk>> const& node_lits )
+  generate_cnf_impl( Ntk const& ntk, clause_callback_t<lit_t> const& fn, std::optional<node_map<lit_t, Ntk>> const& node_lits, generate_cnf_params const& ps )
       : ntk_( ntk ),
         fn_( fn ),
-        node_lits_( node_lits ? *node_lits : node_literals<Ntk, lit_t>( ntk ) )
+        node_lits_( node_lits ? *node_lits : node_literals<Ntk, lit_t>( ntk ) ),
+        ps_( ps )
   {
   }
 
@@ -342,6 +434,14 @@ public:
     /* unit clause for constant-0 */
     fn_( { lit_not( node_lits_[ntk_.get_constant( false )] ) } );
 
+    if constexpr ( has_size_v<Ntk> && has_is_ci_v<Ntk> && has_node_to_index_v<Ntk> && has_index_to_node_v<Ntk> && has_foreach_co_v<Ntk> && has_fanout_size_v<Ntk> )
+    {
+      if ( ps_.cut_based )
+      {
+        return run_cuts();
+      }
+    }
+
     /* compute clauses for nodes */
     ntk_.foreach_gate( [&]( auto const& n ) {
       std::vector<lit_t> child_lits;
@@ -435,6 +535,52 @@ public:
       return true;
     } );
 
+    return output_literals();
+  }
+
+private:
+  std::vector<lit_t> run_cuts()
+  {
+    mapping_view<Ntk, true> mapped{ ntk_ };
+
+    lut_mapping_params mps;
+    mps.cut_enumeration_ps.cut_size = ps_.cut_size;
+    mps.cut_enumeration_ps.cut_limit = ps_.cut_limit;
+    lut_mapping<mapping_view<Ntk, true>, true, cut_enumeration_cnf_cut>( mapped, mps );
+
+    cnf_template_cache cache;
+    std::vector<lit_t> lits;
+    mapped.foreach_gate( [&]( auto const& n ) {
+      if ( !mapped.is_cell_root( n ) )
+      {
+        return;
+      }
+
+      lits.clear();
+      mapped.foreach_cell_fanin( n, [&]( auto const& leaf ) {
+        lits.push_back( node_lits_[leaf] );
+      } );
+      lits.push_back( node_lits_[n] );
+
+      for ( auto const& c : cache( mapped.cell_function( n ) ) )
+      {
+        std::vector<lit_t> clause;
+        for ( auto i = 0u; i < lits.size(); ++i )
+        {
+          if ( c.get_mask( i ) )
+          {
+            clause.push_back( lit_not_cond( lits[i], !c.get_bit( i ) ) );
+          }
+        }
+        fn_( clause );
+      }
+    } );
+
+    return output_literals();
+  }
+
+  std::vector<lit_t> output_literals() const
+  {
     std::vector<lit_t> output_lits;
     ntk_.foreach_po( [&]( auto const& f ) {
       output_lits.push_back( lit_not_cond( node_lits_[f], ntk_.is_complemented( f ) ) );
@@ -448,6 +594,7 @@ private:
   clause_callback_t<lit_t> const& fn_;
 
   node_map<lit_t, Ntk> node_lits_;
+  generate_cnf_params const& ps_;
 };
 
 } // namespace detail
@@ -470,12 +617,17 @@ private:
  * output in the network, following the same order as the primary outputs have
  * been created.
  *
+ * If `ps.cut_based` is set, the network is first covered with cuts and one
+ * ISOP-based CNF is generated for each cut instead of each gate, which
+ * usually results in fewer clauses.
+ *
  * \param ntk Logic network
  * \param fn Clause creation function
  * \param node_lits (optional) custom node literal map
+ * \param ps Parameters
  */
 template<class Ntk>
-std::vector<uint32_t> generate_cnf( Ntk const& ntk, clause_callback_t<uint32_t> const& fn, std::optional<node_map<uint32_t, Ntk>> const& node_lits = {} )
+std::vector<uint32_t> generate_cnf( Ntk const& ntk, clause_callback_t<uint32_t> const& fn, std::optional<node_map<uint32_t, Ntk>> const& node_lits = {}, generate_cnf_params const& ps = {} )
 {
   static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
   static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
@@ -485,12 +637,12 @@ std::vector<uint32_t> generate_cnf( Ntk const& ntk, clause_callback_t<uint32_t>
   static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
   static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
 
-  detail::generate_cnf_impl<Ntk, uint32_t> impl( ntk, fn, node_lits );
+  detail::generate_cnf_impl<Ntk, uint32_t> impl( ntk, fn, node_lits, ps );
   return impl.run();
 }
 
 template<class Ntk, typename lit_t = bill::lit_type>
-std::vector<lit_t> generate_cnf( Ntk const& ntk, clause_callback_t<lit_t> const& fn, std::optional<node_map<lit_t, Ntk>> const& node_lits = {} )
+std::vector<lit_t> generate_cnf( Ntk const& ntk, clause_callback_t<lit_t> const& fn, std::optional<node_map<lit_t, Ntk>> const& node_lits = {}, generate_cnf_params const& ps = {} )
 {
   static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
   static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
@@ -500,7 +652,7 @@ std::vector<lit_t> generate_cnf( Ntk const& ntk, clause_callback_t<lit_t> const&
   static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
   static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
 
-  detail::generate_cnf_impl<Ntk, lit_t> impl( ntk, fn, node_lits );
+  detail::generate_cnf_impl<Ntk, lit_t> impl( ntk, fn, node_lits, ps );
   return impl.run();
 }
 
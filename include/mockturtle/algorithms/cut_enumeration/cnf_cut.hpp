@@ -82,8 +82,8 @@ struct cut_enumeration_update_cut<cut_enumeration_cnf_cut>
     uint32_t delay{ 0 };
     auto tt = cuts.truth_table( cut );
     auto cnf = kitty::cnf_characteristic( tt );
-    cut->data.cost = cnf;
-    float flow = cut.size() < 2 ? 0.0f : 1.0f;
+    cut->data.cost = static_cast<float>( cnf.size() );
+    float flow = cut.size() < 2 ? 0.0f : cut->data.cost;
 
     for ( auto leaf : cut )
     {
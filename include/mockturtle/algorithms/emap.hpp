@@ -35,6 +35,7 @@
 #include <chrono>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -54,6 +55,7 @@
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/tech_library.hpp"
+#include "../utils/thread_pool.hpp"
 #include "../views/binding_view.hpp"
 #include "../views/cell_view.hpp"
 #include "../views/choice_view.hpp"
@@ -137,6 +139,15 @@ struct emap_params
   /*! \brief Remove the cuts that are contained in others */
   bool remove_dominated_cuts{ false };
 
+  /*! \brief Number of threads for matching and area flow.
+   *
+   * The delay-oriented and area-flow passes process each topological
+   * level in parallel.  The result does not depend on the number of
+   * threads.  Exact area recovery, multi-output matching, and networks
+   * with don't touch gates are processed sequentially.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Remove overlapping multi-output cuts */
   bool remove_overlapping_multicuts{ false };
 
@@ -778,6 +789,7 @@ public:
   using klut_map = std::unordered_map<uint32_t, std::array<signal<klut_network>, 2>>;
   using block_map = std::unordered_map<uint32_t, std::array<signal<block_network>, 2>>;
 
+  static constexpr uint32_t parallel_grain = 8;
   static constexpr uint32_t max_multioutput_cut_size = 3;
   static constexpr uint32_t max_multioutput_output_size = 2;
   using multi_cuts_t = fast_network_cuts<Ntk, max_multioutput_cut_size, true, cut_enumeration_emap_multi_cut>;
@@ -802,12 +814,17 @@ public:
         node_match( ntk.size() ),
         node_tuple_match( ntk.size() ),
         switch_activity( ps.eswp_rounds ? switching_activity( ntk, ps.switching_activity_patterns ) : std::vector<float>( 0 ) ),
-        cuts( ntk.size() )
+        cuts( ntk.size() ),
+        threads_data( std::max( ps.num_threads, 1u ) )
   {
     std::memset( node_tuple_match.data(), 0, sizeof( multioutput_info ) * ntk.size() );
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
     tmp_visited.reserve( 100 );
+    if ( ps.num_threads > 1u )
+    {
+      pool = std::make_unique<thread_pool>( ps.num_threads );
+    }
   }
 
   explicit emap_impl( Ntk const& ntk, tech_library<NInputs, Configuration> const& library, std::vector<float> const& switch_activity, emap_params const& ps, emap_stats& st )
@@ -818,12 +835,17 @@ public:
         node_match( ntk.size() ),
         node_tuple_match( ntk.size() ),
         switch_activity( switch_activity ),
-        cuts( ntk.size() )
+        cuts( ntk.size() ),
+        threads_data( std::max( ps.num_threads, 1u ) )
   {
     std::memset( node_tuple_match.data(), 0, sizeof( multioutput_info ) * ntk.size() );
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
     tmp_visited.reserve( 100 );
+    if ( ps.num_threads > 1u )
+    {
+      pool = std::make_unique<thread_pool>( ps.num_threads );
+    }
   }
 
   cell_view<block_network> run_block()
@@ -1030,41 +1052,19 @@ private:
   {
     bool warning_box = false;
 
-    for ( auto const& n : topo_order )
+    if ( use_parallel_matching() )
     {
-      auto const index = ntk.node_to_index( n );
-
-      if ( !compute_matches_node<DO_AREA>( n, warning_box ) )
-      {
-        continue;
-      }
-
-      /* load multi-output cuts and data */
-      if ( ps.map_multioutput && node_tuple_match[index].has_info )
-      {
-        match_multi_add_cuts( n );
-      }
-
-      /* match positive phase */
-      match_phase<DO_AREA>( n, 0u );
-
-      /* match negative phase */
-      match_phase<DO_AREA>( n, 1u );
-
-      /* try to drop one phase */
-      match_drop_phase<DO_AREA, false>( n );
-
-      /* select alternative matches to use */
-      select_alternatives<DO_AREA>( n );
-
-      /* try multi-output matches */
-      if constexpr ( DO_AREA )
+      /* don't touch boxes are excluded from the parallel mode */
+      foreach_level_parallel( [&]( node<Ntk> const& n, uint32_t thread_id ) {
+        bool no_box = false;
+        match_node<DO_AREA>( n, no_box, thread_id );
+      } );
+    }
+    else
+    {
+      for ( auto const& n : topo_order )
       {
-        if ( ps.map_multioutput && node_tuple_match[index].highest_index )
-        {
-          if ( match_multioutput<DO_AREA>( n ) )
-            multi_node_update<DO_AREA>( n );
-        }
+        match_node<DO_AREA>( n, warning_box, 0u );
       }
     }
 
@@ -1100,7 +1100,46 @@ private:
   }
 
   template<bool DO_AREA>
-  inline bool compute_matches_node( node<Ntk> const& n, bool& warning_box )
+  inline void match_node( node<Ntk> const& n, bool& warning_box, uint32_t thread_id )
+  {
+    auto const index = ntk.node_to_index( n );
+
+    if ( !compute_matches_node<DO_AREA>( n, warning_box, thread_id ) )
+    {
+      return;
+    }
+
+    /* load multi-output cuts and data */
+    if ( ps.map_multioutput && node_tuple_match[index].has_info )
+    {
+      match_multi_add_cuts( n );
+    }
+
+    /* match positive phase */
+    match_phase<DO_AREA>( n, 0u );
+
+    /* match negative phase */
+    match_phase<DO_AREA>( n, 1u );
+
+    /* try to drop one phase */
+    match_drop_phase<DO_AREA, false>( n );
+
+    /* select alternative matches to use */
+    select_alternatives<DO_AREA>( n );
+
+    /* try multi-output matches */
+    if constexpr ( DO_AREA )
+    {
+      if ( ps.map_multioutput && node_tuple_match[index].highest_index )
+      {
+        if ( match_multioutput<DO_AREA>( n ) )
+          multi_node_update<DO_AREA>( n );
+      }
+    }
+  }
+
+  template<bool DO_AREA>
+  inline bool compute_matches_node( node<Ntk> const& n, bool& warning_box, uint32_t thread_id )
   {
     auto const index = ntk.node_to_index( n );
     auto& node_data = node_match[index];
@@ -1155,28 +1194,30 @@ private:
     /* compute cuts for node */
     if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
     {
-      merge_cuts2<DO_AREA>( n );
+      merge_cuts2<DO_AREA>( n, thread_id );
     }
     else
     {
-      merge_cuts<DO_AREA>( n );
+      merge_cuts<DO_AREA>( n, thread_id );
     }
 
     return true;
   }
 
   template<bool DO_AREA>
-  void merge_cuts2( node<Ntk> const& n )
+  void merge_cuts2( node<Ntk> const& n, uint32_t thread_id )
   {
     static constexpr uint32_t max_cut_size = CutSize > 6 ? 6 : CutSize;
 
     auto index = ntk.node_to_index( n );
     auto& node_data = node_match[index];
+    auto& tdata = threads_data[thread_id];
     emap_cut_sort_type sort = emap_cut_sort_type::AREA;
 
     /* compute cuts */
     const auto fanin = 2;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this]( auto child, auto i ) {
+    cut_merge_t lcuts{};
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
     } );
     lcuts[2] = &cuts[index];
@@ -1186,13 +1227,13 @@ private:
     bool reinsert_cuts = false;
     if ( rcuts.size() )
     {
-      temp_cuts.clear();
+      tdata.temp_cuts.clear();
       for ( auto& cut : rcuts )
       {
         if ( ( *cut )->ignore )
           continue;
         recompute_cut_data( *cut, n );
-        temp_cuts.simple_insert( *cut );
+        tdata.temp_cuts.simple_insert( *cut );
         reinsert_cuts = true;
       }
       rcuts.clear();
@@ -1244,13 +1285,13 @@ private:
 
     if ( reinsert_cuts )
     {
-      for ( auto const& cut : temp_cuts )
+      for ( auto const& cut : tdata.temp_cuts )
       {
         rcuts.simple_insert( *cut, sort );
       }
     }
 
-    cuts_total += rcuts.size();
+    tdata.cuts_total += rcuts.size();
 
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_enumeration_ps.cut_limit );
@@ -1263,7 +1304,7 @@ private:
   }
 
   template<bool DO_AREA>
-  void merge_cuts( node<Ntk> const& n )
+  void merge_cuts( node<Ntk> const& n, uint32_t thread_id )
   {
     static constexpr uint32_t max_cut_size = CutSize > 6 ? 6 : CutSize;
 
@@ -1273,8 +1314,9 @@ private:
     cut_t best_cut;
 
     /* compute cuts */
+    cut_merge_t lcuts{};
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &cut_sizes]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
     } );
@@ -1355,7 +1397,7 @@ private:
       rcuts.limit( ps.cut_enumeration_ps.cut_limit );
     }
 
-    cuts_total += rcuts.size();
+    threads_data[thread_id].cuts_total += rcuts.size();
 
     add_unit_cut( index );
   }
@@ -1427,7 +1469,7 @@ private:
     /* round stats */
     if ( ps.verbose )
     {
-      st.round_stats.push_back( fmt::format( "[i] SCuts    : Cuts  = {:>12d}  Time = {:>12.2f}\n", cuts_total, to_seconds( clock::now() - time_begin ) ) );
+      st.round_stats.push_back( fmt::format( "[i] SCuts    : Cuts  = {:>12d}  Time = {:>12.2f}\n", num_cuts(), to_seconds( clock::now() - time_begin ) ) );
     }
 
     return true;
@@ -1441,6 +1483,7 @@ private:
 
     /* compute cuts */
     const auto fanin = 2;
+    cut_merge_t lcuts{};
     std::array<uint32_t, 2> children_phase;
     ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
@@ -1497,7 +1540,7 @@ private:
       }
     }
 
-    cuts_total += rcuts.size();
+    threads_data[0].cuts_total += rcuts.size();
 
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_enumeration_ps.cut_limit );
@@ -1606,63 +1649,24 @@ private:
     /* match cut and compute data */
     compute_cut_data( new_cut, n );
 
-    ++cuts_total;
+    ++threads_data[0].cuts_total;
   }
 
   template<bool DO_AREA>
   bool compute_mapping()
   {
-    for ( auto const& n : topo_order )
+    if ( use_parallel_matching() )
     {
-      uint32_t index = ntk.node_to_index( n );
-
-      /* reset mapping */
-      node_match[index].map_refs[0] = node_match[index].map_refs[1] = 0u;
-
-      if ( ntk.is_constant( n ) )
-        continue;
-      if ( ntk.is_pi( n ) )
-      {
-        node_match[index].flows[1] = lib_inv_area / node_match[index].est_refs[1];
-        node_match[index].best_alternative[1].flow = lib_inv_area / node_match[index].est_refs[1];
-        continue;
-      }
-
-      /* don't touch box */
-      if constexpr ( has_is_dont_touch_v<Ntk> )
-      {
-        if ( ntk.is_dont_touch( n ) )
-        {
-          if constexpr ( has_has_binding_v<Ntk> )
-          {
-            propagate_data_forward_white_box( n );
-          }
-          continue;
-        }
-      }
-
-      /* match positive phase */
-      match_phase<DO_AREA>( n, 0u );
-
-      /* match negative phase */
-      match_phase<DO_AREA>( n, 1u );
-
-      /* try to drop one phase */
-      match_drop_phase<DO_AREA, false>( n );
-
-      /* try a multi-output match */
-      if constexpr ( DO_AREA )
+      foreach_level_parallel( [&]( node<Ntk> const& n, uint32_t ) {
+        remap_node<DO_AREA>( n );
+      } );
+    }
+    else
+    {
+      for ( auto const& n : topo_order )
       {
-        if ( ps.map_multioutput && node_tuple_match[index].highest_index )
-        {
-          bool multi_success = match_multioutput<DO_AREA>( n );
-          if ( multi_success )
-            multi_node_update<DO_AREA>( n );
-        }
+        remap_node<DO_AREA>( n );
       }
-
-      assert( node_match[index].arrival[0] < node_match[index].required[0] + epsilon );
-      assert( node_match[index].arrival[1] < node_match[index].required[1] + epsilon );
     }
 
     double area_old = area;
@@ -1691,6 +1695,142 @@ private:
     return success;
   }
 
+  template<bool DO_AREA>
+  inline void remap_node( node<Ntk> const& n )
+  {
+    uint32_t index = ntk.node_to_index( n );
+
+    /* reset mapping */
+    node_match[index].map_refs[0] = node_match[index].map_refs[1] = 0u;
+
+    if ( ntk.is_constant( n ) )
+      return;
+    if ( ntk.is_pi( n ) )
+    {
+      node_match[index].flows[1] = lib_inv_area / node_match[index].est_refs[1];
+      node_match[index].best_alternative[1].flow = lib_inv_area / node_match[index].est_refs[1];
+      return;
+    }
+
+    /* don't touch box */
+    if constexpr ( has_is_dont_touch_v<Ntk> )
+    {
+      if ( ntk.is_dont_touch( n ) )
+      {
+        if constexpr ( has_has_binding_v<Ntk> )
+        {
+          propagate_data_forward_white_box( n );
+        }
+        return;
+      }
+    }
+
+    /* match positive phase */
+    match_phase<DO_AREA>( n, 0u );
+
+    /* match negative phase */
+    match_phase<DO_AREA>( n, 1u );
+
+    /* try to drop one phase */
+    match_drop_phase<DO_AREA, false>( n );
+
+    /* try a multi-output match */
+    if constexpr ( DO_AREA )
+    {
+      if ( ps.map_multioutput && node_tuple_match[index].highest_index )
+      {
+        bool multi_success = match_multioutput<DO_AREA>( n );
+        if ( multi_success )
+          multi_node_update<DO_AREA>( n );
+      }
+    }
+
+    assert( node_match[index].arrival[0] < node_match[index].required[0] + epsilon );
+    assert( node_match[index].arrival[1] < node_match[index].required[1] + epsilon );
+  }
+
+  /* The matching passes are run in parallel one topological level at a time:
+   * a node only reads the cuts and matches of its transitive fanin, which
+   * belongs to lower levels.  Multi-output matching and don't touch boxes
+   * update data of other nodes and are therefore run sequentially. */
+  bool use_parallel_matching()
+  {
+    if ( pool == nullptr || ps.map_multioutput )
+      return false;
+
+    if ( level_offsets.empty() )
+    {
+      init_levels();
+    }
+    return parallel_matching;
+  }
+
+  void init_levels()
+  {
+    parallel_matching = true;
+    std::vector<uint32_t> levels( ntk.size(), 0u );
+    uint32_t max_level = 0u;
+    for ( auto const& n : topo_order )
+    {
+      if constexpr ( has_is_dont_touch_v<Ntk> )
+      {
+        if ( ntk.is_dont_touch( n ) )
+          parallel_matching = false;
+      }
+
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+        continue;
+
+      uint32_t level = 0u;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        level = std::max( level, levels[ntk.node_to_index( ntk.get_node( f ) )] );
+      } );
+      levels[ntk.node_to_index( n )] = level + 1u;
+      max_level = std::max( max_level, level + 1u );
+    }
+
+    /* bucket the nodes by level, keeping the topological order inside each level */
+    level_offsets.assign( max_level + 2u, 0u );
+    for ( auto const& n : topo_order )
+    {
+      ++level_offsets[levels[ntk.node_to_index( n )] + 1u];
+    }
+    for ( auto i = 1u; i < level_offsets.size(); ++i )
+    {
+      level_offsets[i] += level_offsets[i - 1u];
+    }
+    level_nodes.resize( topo_order.size() );
+    std::vector<uint32_t> positions( level_offsets.begin(), level_offsets.end() - 1u );
+    for ( auto const& n : topo_order )
+    {
+      level_nodes[positions[levels[ntk.node_to_index( n )]]++] = n;
+    }
+  }
+
+  template<typename Fn>
+  void foreach_level_parallel( Fn&& fn )
+  {
+    for ( auto l = 0u; l + 1u < level_offsets.size(); ++l )
+    {
+      auto const begin = level_offsets[l];
+      pool->parallel_for(
+          level_offsets[l + 1u] - begin, [&]( uint64_t i, uint32_t thread_id ) {
+            fn( level_nodes[begin + i], thread_id );
+          },
+          parallel_grain );
+    }
+  }
+
+  uint32_t num_cuts() const
+  {
+    uint32_t total = 0u;
+    for ( auto const& data : threads_data )
+    {
+      total += data.cuts_total;
+    }
+    return total;
+  }
+
   template<bool SwitchActivity>
   bool compute_mapping_exact_reversed()
   {
@@ -4816,6 +4956,7 @@ private:
    */
   void compute_truth_table_support( cut_t const& sub, cut_t const& sup, TT& tt )
   {
+    support_t lsupport;
     size_t j = 0;
     auto itp = sup.begin();
     for ( auto i : sub )
@@ -4914,6 +5055,7 @@ private:
 
   void compute_truth_table( uint32_t index, fanin_cut_t const& vcuts, uint32_t fanin, cut_t& res )
   {
+    truth_compute_t ltruth;
     for ( uint32_t i = 0; i < fanin; ++i )
     {
       cut_t const* cut = vcuts[i];
@@ -5726,11 +5868,20 @@ private:
 
   /* cut computation */
   std::vector<cut_set_t> cuts; /* compressed representation of cuts */
-  cut_merge_t lcuts;           /* cut merger container */
-  cut_set_t temp_cuts;         /* temporary cut set container */
-  truth_compute_t ltruth;      /* truth table merger container */
-  support_t lsupport;          /* support merger container */
-  uint32_t cuts_total{ 0 };    /* current computed cuts */
+
+  /* per-thread scratch data */
+  struct alignas( 64 ) thread_data
+  {
+    cut_set_t temp_cuts;      /* temporary cut set container */
+    uint32_t cuts_total{ 0 }; /* current computed cuts */
+  };
+  std::vector<thread_data> threads_data;
+
+  /* parallel matching */
+  std::unique_ptr<thread_pool> pool;  /* worker threads, if `num_threads > 1` */
+  std::vector<node<Ntk>> level_nodes; /* nodes bucketed by level */
+  std::vector<uint32_t> level_offsets; /* first node of each level in `level_nodes` */
+  bool parallel_matching{ false };
 
   /* multi-output matching */
   multi_cut_set_t multi_cut_set;    /* set of multi-output cuts */
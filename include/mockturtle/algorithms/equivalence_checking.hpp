@@ -41,6 +41,7 @@
 #include "functional_reduction.hpp"
 #include "../traits.hpp"
 #include "../utils/include/percy.hpp"
+#include "../utils/portfolio_solver.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../networks/klut.hpp"
 #include "cnf.hpp"
@@ -70,6 +71,24 @@ struct equivalence_checking_params
   /*! \brief Whether to apply functional reduction before SAT solving. */
   bool functional_reduction{ true };
 
+  /*! \brief Whether to encode the miter with cut-based CNF generation.
+   *
+   * If true, the CNF is generated from a cover of the miter with cuts of up
+   * to `cnf_cut_size` leaves (see `generate_cnf_params::cut_based`), which
+   * results in fewer clauses than the gate-by-gate encoding.
+   */
+  bool cut_based_cnf{ false };
+
+  /*! \brief Maximum cut size for cut-based CNF generation. */
+  uint32_t cnf_cut_size{ 4u };
+
+  /*! \brief Additional SAT solvers which run concurrently on hard miters (see `portfolio_solver`).
+   *
+   * If not empty, the miter is solved with a `bsat2` solver and these
+   * solvers, and the first result is taken.
+   */
+  std::vector<portfolio_member> portfolio{};
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -104,6 +123,61 @@ struct equivalence_checking_stats
 namespace detail
 {
 
+template<class Ntk, class Solver>
+bill::lit_type miter_to_cnf( Ntk const& ntk, Solver& solver, generate_cnf_params const& cnf_ps = {} )
+{
+  node_map<bill::lit_type, Ntk> literals( ntk );
+
+  literals[ntk.get_constant( false )] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+  if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+  {
+    literals[ntk.get_constant( true )] = lit_not( literals[ntk.get_constant( false )] );
+  }
+  solver.add_clause( {~literals[ntk.get_constant( false )]} );
+
+  ntk.foreach_pi( [&]( auto const& n ) {
+    literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+  } );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+  } );
+
+  if constexpr ( has_EXCDC_interface_v<Ntk> )
+  {
+    ntk.add_EXCDC_clauses( solver );
+  }
+
+  return generate_cnf<Ntk, bill::lit_type>( ntk, [&]( bill::result::clause_type const& clause ) {
+    solver.add_clause( clause );
+  }, literals, cnf_ps )[0];
+}
+
+/* solves the miter, the counter-example is written to `counter_example` */
+template<class Ntk, class Solver>
+std::optional<bool> solve_miter( Ntk const& miter, Solver& solver, uint32_t conflict_limit, std::vector<bool>& counter_example, generate_cnf_params const& cnf_ps = {} )
+{
+  bill::lit_type output = miter_to_cnf( miter, solver, cnf_ps );
+
+  const auto res = solver.solve( { output }, conflict_limit );
+
+  switch ( res )
+  {
+  default:
+    return std::nullopt;
+  case bill::result::states::satisfiable:
+  {
+    counter_example.clear();
+    for ( auto i = 1u; i <= miter.num_pis(); ++i )
+    {
+      counter_example.push_back( solver.get_model().model().at( i ) == bill::lbool_type::true_ );
+    }
+    return false;
+  }
+  case bill::result::states::unsatisfiable:
+    return true;
+  }
+}
+
 template<class Ntk>
 class equivalence_checking_impl
 {
@@ -119,9 +193,6 @@ public:
   {
     stopwatch<> t( st_.time_total );
 
-    percy::bsat_wrapper solver;
-    int output;
-
     if ( ps_.functional_reduction )
     {
       Ntk opt = miter_.clone();
@@ -136,17 +207,30 @@ public:
         return opt.po_at( 0 ) == opt.get_constant( false );
       }
 
-      output = generate_cnf( opt, [&]( auto const& clause ) {
-        solver.add_clause( clause );
-      } )[0];
+      return solve( opt );
     }
     else
     {
-      output = generate_cnf( miter_, [&]( auto const& clause ) {
-        solver.add_clause( clause );
-      } )[0];
+      return solve( miter_ );
+    }
+  }
+
+private:
+  std::optional<bool> solve( Ntk const& ntk )
+  {
+    if ( !ps_.portfolio.empty() )
+    {
+      portfolio_solver<bill::solvers::bsat2> solver( ps_.portfolio );
+      return solve_miter( ntk, solver, ps_.conflict_limit, st_.counter_example, cnf_params() );
     }
 
+    percy::bsat_wrapper solver;
+    int output = generate_cnf(
+        ntk, [&]( auto const& clause ) {
+          solver.add_clause( clause );
+        },
+        {}, cnf_params() )[0];
+
     const auto res = solver.solve( &output, &output + 1, ps_.conflict_limit );
 
     switch ( res )
@@ -156,7 +240,7 @@ public:
     case percy::synth_result::success:
     {
       st_.counter_example.clear();
-      for ( auto i = 1u; i <= miter_.num_pis(); ++i )
+      for ( auto i = 1u; i <= ntk.num_pis(); ++i )
       {
         st_.counter_example.push_back( solver.var_value( i ) );
       }
@@ -167,6 +251,14 @@ public:
     }
   }
 
+  generate_cnf_params cnf_params() const
+  {
+    generate_cnf_params cnf_ps;
+    cnf_ps.cut_based = ps_.cut_based_cnf;
+    cnf_ps.cut_size = ps_.cnf_cut_size;
+    return cnf_ps;
+  }
+
 private:
   Ntk const& miter_;
   equivalence_checking_params const& ps_;
@@ -188,56 +280,12 @@ public:
   {
     stopwatch<> t( st_.time_total );
 
-    bill::solver<Solver> solver;
-    bill::lit_type output = convert_to_cnf( miter_, solver );
-
-    const auto res = solver.solve( {output}, ps_.conflict_limit );
-
-    switch ( res )
-    {
-    default:
-      return std::nullopt;
-    case bill::result::states::satisfiable:
-    {
-      st_.counter_example.clear();
-      for ( auto i = 1u; i <= miter_.num_pis(); ++i )
-      {
-        st_.counter_example.push_back( solver.get_model().model().at( i ) == bill::lbool_type::true_ );
-      }
-      return false;
-    }
-    case bill::result::states::unsatisfiable:
-      return true;
-    }
-  }
-
-private:
-  bill::lit_type convert_to_cnf( Ntk const& ntk, bill::solver<Solver>& solver )
-  {
-    node_map<bill::lit_type, Ntk> literals( ntk );
-
-    literals[ntk.get_constant( false )] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-    if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
-    {
-      literals[ntk.get_constant( true )] = lit_not( literals[ntk.get_constant( false )] );
-    }
-    solver.add_clause( {~literals[ntk.get_constant( false )]} );
-
-    ntk.foreach_pi( [&]( auto const& n ) {
-      literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-    } );
-    ntk.foreach_gate( [&]( auto const& n ) {
-      literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-    } );
-
-    if constexpr ( has_EXCDC_interface_v<Ntk> )
-    {
-      ntk.add_EXCDC_clauses( solver );
-    }
+    portfolio_solver<Solver> solver( ps_.portfolio );
 
-    return generate_cnf<Ntk, bill::lit_type>( ntk, [&]( bill::result::clause_type const& clause ) {
-      solver.add_clause( clause );
-    }, literals )[0];
+    generate_cnf_params cnf_ps;
+    cnf_ps.cut_based = ps_.cut_based_cnf;
+    cnf_ps.cut_size = ps_.cnf_cut_size;
+    return solve_miter( miter_, solver, ps_.conflict_limit, st_.counter_example, cnf_ps );
   }
 
 private:
@@ -86,6 +86,9 @@ struct simulation_guided_resynthesis_params
   /*! \brief Whether to save the appended patterns (with CEXs) into file. */
   std::optional<std::string> save_patterns{};
 
+  /*! \brief Whether to save the patterns in the binary pattern format instead of text. */
+  bool binary_patterns{ false };
+
   /*! \brief Maximum number of clauses of the SAT solver. */
   uint32_t max_clauses{ 1000 };
 
@@ -345,7 +348,14 @@ public:
     if ( ps.save_patterns )
     {
       call_with_stopwatch( st.time_patsave, [&]() {
-        write_patterns( sim, *ps.save_patterns );
+        if ( ps.binary_patterns )
+        {
+          write_binary_patterns( sim, *ps.save_patterns );
+        }
+        else
+        {
+          write_patterns( sim, *ps.save_patterns );
+        }
       } );
     }
 
@@ -33,15 +33,24 @@
 
 #pragma once
 
+#include "../utils/pattern_bank.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/fanout_view.hpp"
 
 #include <bill/sat/interface/abc_bsat2.hpp>
+#include <kitty/hash.hpp>
 #include <kitty/partial_truth_table.hpp>
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "../io/write_patterns.hpp"
 #include "circuit_validator.hpp"
+#include "incremental_simulation.hpp"
 #include "simulation.hpp"
 
 namespace mockturtle
@@ -66,6 +75,9 @@ struct functional_reduction_params
   /*! \brief Whether to save the appended patterns (with CEXs) into file. */
   std::optional<std::string> save_patterns{};
 
+  /*! \brief Whether to save the patterns in the binary pattern format instead of text. */
+  bool binary_patterns{ false };
+
   /*! \brief Maximum number of nodes in the transitive fanin cone (and their fanouts) to be compared to. */
   uint32_t max_TFI_nodes{ 1000 };
 
@@ -81,8 +93,28 @@ struct functional_reduction_params
   /*! \brief Initial number of (random) simulation patterns. */
   uint32_t num_patterns{ 256 };
 
-  /*! \brief Maximum number of simulation patterns. Discards all patterns and re-seeds with random patterns when exceeded. */
+  /*! \brief Maximum number of simulation patterns. The patterns are compacted (see `compact_patterns`) or re-seeded when exceeded. */
   uint32_t max_patterns{ 1024 };
+
+  /*! \brief Whether to compact the patterns with a `pattern_bank` when `max_patterns` is exceeded.
+   *
+   * If true, the patterns which split no equivalence class are dropped and
+   * at most `max_patterns / 2` patterns are kept.  Saved patterns are
+   * compacted in the same way.  If false, all patterns are discarded and
+   * re-seeded with random patterns.
+   */
+  bool compact_patterns{ true };
+
+  /*! \brief Number of threads for SAT sweeping.
+   *
+   * With more than one thread, every node is compared to the first node of
+   * its equivalence class (with respect to simulation signatures) instead
+   * of to the nodes in its transitive fanin.  In every round, the candidate
+   * pairs are proven independently by the worker threads, each with its own
+   * SAT solver.  Then, the proven equivalences are substituted and the
+   * counter-examples are added to the simulation patterns.
+   */
+  uint32_t num_threads{ 1u };
 };
 
 struct functional_reduction_stats
@@ -111,6 +143,12 @@ struct functional_reduction_stats
   /*! \brief Number of SAT solver timeout. */
   uint32_t num_timeout{ 0 };
 
+  /*! \brief Number of rounds of parallel SAT sweeping. */
+  uint32_t num_rounds{ 0 };
+
+  /*! \brief Number of pattern compactions. */
+  uint32_t num_compactions{ 0 };
+
   void report() const
   {
     // clang-format off
@@ -138,11 +176,11 @@ class functional_reduction_impl
 public:
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
-  using TT = unordered_node_map<kitty::partial_truth_table, Ntk>;
 
   explicit functional_reduction_impl( Ntk& ntk, functional_reduction_params const& ps, validator_params const& vps, functional_reduction_stats& st )
-      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ),
-        sim( ps.pattern_filename ? partial_simulator( *ps.pattern_filename ) : partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() ) ), validator( ntk, vps )
+      : ntk( ntk ), ps( ps ), vps( vps ), st( st ),
+        sim( ps.pattern_filename ? partial_simulator( *ps.pattern_filename ) : partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() ) ),
+        tts( ntk, sim, { false } ), validator( ntk, vps )
   {
     static_assert( !validator_t::use_odc_, "`circuit_validator::use_odc` flag should be turned off." );
   }
@@ -151,7 +189,18 @@ public:
   {
     if ( ps.save_patterns )
     {
-      write_patterns( sim, *ps.save_patterns );
+      if ( ps.compact_patterns )
+      {
+        compact_patterns( 0u );
+      }
+      if ( ps.binary_patterns )
+      {
+        write_binary_patterns( sim, *ps.save_patterns );
+      }
+      else
+      {
+        write_patterns( sim, *ps.save_patterns );
+      }
     }
   }
 
@@ -161,9 +210,15 @@ public:
 
     /* first simulation: the whole circuit; from 0 bits. */
     call_with_stopwatch( st.time_sim, [&]() {
-      simulate_nodes<Ntk>( ntk, tts, sim, true );
+      tts.simulate_all();
     } );
 
+    if ( ps.num_threads > 1u )
+    {
+      run_parallel();
+      return;
+    }
+
     /* remove constant nodes. */
     substitute_constants();
 
@@ -179,6 +234,193 @@ public:
   }
 
 private:
+  /* a candidate pair: `root` is equivalent to `g`, which may be a constant */
+  struct candidate
+  {
+    node root;
+    signal g;
+    bool is_constant;
+    bool value;
+  };
+
+  enum class candidate_result : uint8_t
+  {
+    timeout,
+    cex,
+    proven
+  };
+
+  void run_parallel()
+  {
+    /* all validators are created here, as they register network events */
+    validators.reserve( ps.num_threads );
+    while ( validators.size() < ps.num_threads )
+    {
+      validators.emplace_back( std::make_unique<validator_t>( ntk, vps ) );
+    }
+
+    /* nodes for which the SAT solver timed out are not tried again */
+    timed_out.assign( ntk.size(), false );
+
+    uint32_t rounds{ 0 };
+    while ( !ps.max_iterations || rounds++ <= ps.max_iterations )
+    {
+      ++st.num_rounds;
+      auto const cands = collect_candidates();
+      if ( cands.empty() )
+      {
+        break;
+      }
+
+      std::vector<candidate_result> results( cands.size() );
+      std::vector<std::vector<std::vector<bool>>> cexs( ps.num_threads );
+      call_with_stopwatch( st.time_sat, [&]() {
+        prove_candidates( cands, results, cexs );
+      } );
+
+      /* substitute proven candidates in topological order */
+      bool changed = false;
+      for ( auto i = 0u; i < cands.size(); ++i )
+      {
+        if ( results[i] == candidate_result::timeout )
+        {
+          ++st.num_timeout;
+          timed_out[ntk.node_to_index( cands[i].root )] = true;
+        }
+        else if ( results[i] == candidate_result::cex )
+        {
+          ++st.num_cex;
+        }
+        else if ( !is_dead( cands[i].root ) && !is_dead( ntk.get_node( cands[i].g ) ) )
+        {
+          ++st.num_reduction;
+          ++( cands[i].is_constant ? st.num_const_accepts : st.num_equ_accepts );
+          ntk.substitute_node( cands[i].root, cands[i].g );
+          changed = true;
+        }
+      }
+
+      /* add counter-examples to the simulation patterns */
+      uint32_t num_new_patterns{ 0 };
+      for ( auto const& patterns : cexs )
+      {
+        num_new_patterns += static_cast<uint32_t>( patterns.size() );
+      }
+      if ( sim.num_bits() + num_new_patterns > ps.max_patterns && ps.compact_patterns )
+      {
+        call_with_stopwatch( st.time_sim, [&]() {
+          compact_patterns( ps.max_patterns / 2 );
+        } );
+      }
+      if ( sim.num_bits() + num_new_patterns > ps.max_patterns )
+      {
+        sim = partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() );
+      }
+      for ( auto const& patterns : cexs )
+      {
+        for ( auto const& pattern : patterns )
+        {
+          sim.add_pattern( pattern );
+        }
+      }
+
+      if ( !changed && num_new_patterns == 0u )
+      {
+        break;
+      }
+      call_with_stopwatch( st.time_sim, [&]() {
+        tts.simulate_all();
+      } );
+    }
+  }
+
+  /* pairs each gate with a constant or with the first node of its equivalence class */
+  std::vector<candidate> collect_candidates()
+  {
+    std::vector<candidate> cands;
+    std::unordered_map<kitty::partial_truth_table, node, kitty::hash<kitty::partial_truth_table>> classes;
+
+    auto const zero = sim.compute_constant( false );
+    ntk.foreach_pi( [&]( auto const& n ) {
+      auto const& tt = tts[n];
+      classes.emplace( kitty::get_bit( tt, 0 ) ? ~tt : tt, n );
+    } );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      check_tts( n );
+      auto const& tt = tts[n];
+      bool const phase = kitty::get_bit( tt, 0 );
+      auto key = phase ? ~tt : tt;
+      if ( timed_out[ntk.node_to_index( n )] )
+      {
+        classes.emplace( std::move( key ), n );
+        return;
+      }
+      if ( key == zero )
+      {
+        cands.push_back( { n, ntk.get_constant( phase ), true, phase } );
+        return;
+      }
+
+      auto const [it, inserted] = classes.emplace( std::move( key ), n );
+      if ( !inserted )
+      {
+        auto const rep = it->second;
+        auto const g = phase != kitty::get_bit( tts[rep], 0 ) ? !ntk.make_signal( rep ) : ntk.make_signal( rep );
+        cands.push_back( { n, g, false, false } );
+      }
+    } );
+    return cands;
+  }
+
+  void prove_candidates( std::vector<candidate> const& cands, std::vector<candidate_result>& results, std::vector<std::vector<std::vector<bool>>>& cexs )
+  {
+    std::atomic<uint32_t> next{ 0 };
+    auto const worker = [&]( uint32_t id ) {
+      auto& v = *validators[id];
+      for ( auto i = next++; i < cands.size(); i = next++ )
+      {
+        auto const& c = cands[i];
+        auto const res = c.is_constant ? v.validate( c.root, c.value ) : v.validate( c.root, c.g );
+        if ( !res )
+        {
+          results[i] = candidate_result::timeout;
+        }
+        else if ( !( *res ) )
+        {
+          results[i] = candidate_result::cex;
+          cexs[id].emplace_back( v.cex );
+        }
+        else
+        {
+          results[i] = candidate_result::proven;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for ( auto id = 1u; id < ps.num_threads; ++id )
+    {
+      threads.emplace_back( worker, id );
+    }
+    worker( 0u );
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+  }
+
+  bool is_dead( node const& n ) const
+  {
+    if constexpr ( has_is_dead_v<Ntk> )
+    {
+      return ntk.is_dead( n );
+    }
+    else
+    {
+      return false;
+    }
+  }
+
   void substitute_constants()
   {
     progress_bar pbar{ ntk.size(), "FR-const |{0}| node = {1:>4}   cand = {2:>4}", ps.progress };
@@ -367,35 +609,45 @@ private:
       reseed_patterns();
       return;
     }
-
-    /* re-simulate the whole circuit (for the last block) when a block is full */
-    if ( sim.num_bits() % 64 == 0 )
-    {
-      call_with_stopwatch( st.time_sim, [&]() {
-        simulate_nodes<Ntk>( ntk, tts, sim, false );
-      } );
-    }
   }
 
   void check_tts( node const& n )
   {
-    if ( tts[n].num_bits() != sim.num_bits() )
+    /* only the words covering new patterns are computed */
+    if ( !tts.is_up_to_date( n ) )
     {
       call_with_stopwatch( st.time_sim, [&]() {
-        simulate_node<Ntk>( ntk, n, tts, sim );
+        tts.update( n );
       } );
     }
   }
 
   void reseed_patterns()
   {
-    sim = partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() );
-    tts.reset();
     call_with_stopwatch( st.time_sim, [&]() {
-      simulate_nodes<Ntk>( ntk, tts, sim, true );
+      if ( ps.compact_patterns )
+      {
+        compact_patterns( ps.max_patterns / 2 );
+      }
+      else
+      {
+        sim = partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() );
+      }
+      tts.simulate_all();
     } );
   }
 
+  /* keeps at most `max_patterns` (0 = all) patterns which split equivalence classes */
+  void compact_patterns( uint32_t max_patterns )
+  {
+    pattern_bank bank( sim );
+    pattern_bank_params bps;
+    bps.max_patterns = max_patterns;
+    bank.compact( ntk, bps );
+    sim = bank.simulator();
+    ++st.num_compactions;
+  }
+
   template<typename Fn>
   void foreach_transitive_fanin( node const& n, Fn&& fn )
   {
@@ -431,11 +683,16 @@ private:
 private:
   Ntk& ntk;
   functional_reduction_params const& ps;
+  validator_params const vps;
   functional_reduction_stats& st;
 
-  TT tts;
   partial_simulator sim;
+  /* substitutions are verified to preserve functionality, hence they are not tracked */
+  incremental_simulation<Ntk> tts;
   validator_t validator;
+  /* one validator per thread in parallel mode */
+  std::vector<std::unique_ptr<validator_t>> validators;
+  std::vector<bool> timed_out;
 
   uint32_t candidates{ 0 };
 }; /* functional_reduction_impl */
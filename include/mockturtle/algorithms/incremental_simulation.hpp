@@ -0,0 +1,406 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file incremental_simulation.hpp
+  \brief Incremental simulation of a changing network with partial truth tables
+*/
+
+#pragma once
+
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "simulation.hpp"
+
+#include <kitty/partial_truth_table.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mockturtle
+{
+
+struct incremental_simulation_params
+{
+  /*! \brief Re-simulate the transitive fanout of nodes whose fanins are modified.
+   *
+   * This can be turned off when the network is only changed by function-preserving
+   * substitutions (w.r.t. the simulation patterns), such as in functional reduction.
+   */
+  bool track_modifications{ true };
+};
+
+struct incremental_simulation_stats
+{
+  /*! \brief Number of nodes simulated from scratch. */
+  uint64_t num_simulated_nodes{ 0 };
+
+  /*! \brief Number of nodes extended with new simulation patterns. */
+  uint64_t num_extended_nodes{ 0 };
+
+  /*! \brief Number of words computed when extending nodes. */
+  uint64_t num_extended_words{ 0 };
+
+  /*! \brief Number of nodes invalidated by network modifications. */
+  uint64_t num_invalidated_nodes{ 0 };
+};
+
+/*! \brief Incremental simulation with `partial_simulator`.
+ *
+ * This class maintains the partial truth tables of all nodes in a network
+ * while the network and the simulation patterns change.
+ *
+ * - When patterns are added to the simulator, a node is extended lazily on
+ *   access.  Only the words covering the new patterns (starting from the last
+ *   incomplete block) are computed, no matter how many patterns have been
+ *   added since the last access.  Hence, there is no need to re-simulate the
+ *   whole network whenever a block becomes full.
+ * - When nodes are added to the network, they are simulated on first access.
+ * - When the fanins of a node are modified (e.g., by `substitute_node`), the
+ *   node is marked dirty.  On the next access, the transitive fanout of all
+ *   dirty nodes is re-simulated, and nothing else.  This requires
+ *   `foreach_fanout` (e.g., by wrapping the network with `fanout_view`).
+ *
+ * Note that replacing the patterns of the simulator (instead of adding new
+ * ones) is not detected; call `simulate_all` in this case.
+ *
+ * **Required network functions:**
+ * - `get_node`
+ * - `foreach_fanin`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `compute` for `kitty::partial_truth_table`
+ * - `foreach_fanout` (if `track_modifications` is on)
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      fanout_view aig_fanout{ aig };
+      partial_simulator sim( aig.num_pis(), 256 );
+      incremental_simulation<fanout_view<aig_network>> inc_sim( aig_fanout, sim );
+
+      auto const& tt = inc_sim[n];
+
+      // only the new words are computed on the next access
+      sim.add_pattern( cex );
+
+      // only the transitive fanout of n's fanouts is re-simulated
+      aig_fanout.substitute_node( n, g );
+   \endverbatim
+ */
+template<class Ntk>
+class incremental_simulation
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using TT = kitty::partial_truth_table;
+  using storage_type = incomplete_node_map<TT, Ntk>;
+
+  explicit incremental_simulation( Ntk& ntk, partial_simulator const& sim, incremental_simulation_params const& ps = {} )
+      : ntk( ntk ), sim( sim ), ps( ps ), tts( ntk )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute specialization for kitty::partial_truth_table" );
+
+    add_event = ntk.events().register_add_event( [&]( node const& n ) {
+      tts.resize();
+      tts.erase( n );
+    } );
+
+    delete_event = ntk.events().register_delete_event( [&]( node const& n ) {
+      tts.erase( n );
+    } );
+
+    if ( ps.track_modifications )
+    {
+      if constexpr ( has_foreach_fanout_v<Ntk> )
+      {
+        modified_event = ntk.events().register_modified_event( [&]( node const& n, std::vector<signal> const& previous_children ) {
+          (void)previous_children;
+          dirty.emplace_back( n );
+        } );
+      }
+      else
+      {
+        assert( false && "tracking modifications requires foreach_fanout, wrap the network with fanout_view" );
+      }
+    }
+  }
+
+  ~incremental_simulation()
+  {
+    ntk.events().release_add_event( add_event );
+    ntk.events().release_delete_event( delete_event );
+    if ( modified_event )
+    {
+      ntk.events().release_modified_event( modified_event );
+    }
+  }
+
+  incremental_simulation( incremental_simulation const& ) = delete;
+  incremental_simulation& operator=( incremental_simulation const& ) = delete;
+
+  /*! \brief Returns the up-to-date simulation value of `n`. */
+  TT const& operator[]( node const& n )
+  {
+    if ( !is_up_to_date( n ) )
+    {
+      update( n );
+    }
+    return tts[n];
+  }
+
+  /*! \brief Checks whether the simulation value of `n` can be used as is. */
+  bool is_up_to_date( node const& n ) const
+  {
+    return dirty.empty() && tts.has( n ) && tts[n].num_bits() == sim.num_bits();
+  }
+
+  /*! \brief Brings the simulation value of `n` (and its fanin cone) up to date. */
+  void update( node const& n )
+  {
+    update_dirty();
+    update_const_pi();
+    simulate_rec( n );
+  }
+
+  /*! \brief Brings the simulation values of all nodes up to date. */
+  void update()
+  {
+    update_dirty();
+    update_const_pi();
+    ntk.foreach_gate( [&]( auto const& n ) {
+      simulate_rec( n );
+    } );
+  }
+
+  /*! \brief Discards all simulation values and simulates the whole network. */
+  void simulate_all()
+  {
+    dirty.clear();
+    tts.reset();
+    num_bits_const_pi = 0u;
+    update();
+  }
+
+  /*! \brief Explicitly marks `n` to have changed its function. */
+  void set_dirty( node const& n )
+  {
+    dirty.emplace_back( n );
+  }
+
+  /*! \brief Underlying storage of simulation values.
+   *
+   * Entries may be missing or lag behind the simulator; call `update` before
+   * reading entries that have not been accessed through `operator[]`.
+   */
+  storage_type const& storage() const
+  {
+    return tts;
+  }
+
+  /*! \brief Mutable access to the underlying storage.
+   *
+   * Clients may erase entries or overwrite them with values consistent with
+   * the current network, e.g., when temporarily flipping a node to compute
+   * observability don't cares.
+   */
+  storage_type& storage()
+  {
+    return tts;
+  }
+
+  incremental_simulation_stats const& stats() const
+  {
+    return st;
+  }
+
+private:
+  void update_const_pi()
+  {
+    if ( num_bits_const_pi == sim.num_bits() )
+    {
+      return;
+    }
+    num_bits_const_pi = sim.num_bits();
+
+    tts[ntk.get_node( ntk.get_constant( false ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( false ) ) ) );
+    if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+    {
+      tts[ntk.get_node( ntk.get_constant( true ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( true ) ) ) );
+    }
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      tts[n] = sim.compute_pi( i );
+    } );
+  }
+
+  /* invalidates the transitive fanout of dirty nodes and re-simulates it */
+  void update_dirty()
+  {
+    if constexpr ( has_foreach_fanout_v<Ntk> )
+    {
+      if ( dirty.empty() )
+      {
+        return;
+      }
+
+      std::vector<node> tfo;
+      while ( !dirty.empty() )
+      {
+        auto const n = dirty.back();
+        dirty.pop_back();
+        if ( is_dead( n ) || !tts.has( n ) || ntk.is_constant( n ) || ntk.is_ci( n ) )
+        {
+          continue;
+        }
+
+        /* an erased entry marks a node already in the TFO */
+        tts.erase( n );
+        tfo.emplace_back( n );
+        ++st.num_invalidated_nodes;
+        ntk.foreach_fanout( n, [&]( auto const& p ) {
+          dirty.emplace_back( p );
+        } );
+      }
+
+      update_const_pi();
+      for ( auto const& n : tfo )
+      {
+        if ( !is_dead( n ) )
+        {
+          simulate_rec( n );
+        }
+      }
+    }
+  }
+
+  /* simulates `n` after its fanins, in topological order */
+  void simulate_rec( node const& n )
+  {
+    if ( tts.has( n ) && tts[n].num_bits() == sim.num_bits() )
+    {
+      return;
+    }
+    assert( !ntk.is_constant( n ) && !ntk.is_ci( n ) );
+
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      simulate_rec( ntk.get_node( f ) );
+    } );
+
+    if ( tts.has( n ) )
+    {
+      extend( n );
+    }
+    else
+    {
+      auto num_fanins = 0u;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fanin_value( num_fanins++ ) = tts[ntk.get_node( f )];
+      } );
+      tts[n] = ntk.compute( n, fanin_values.begin(), fanin_values.begin() + num_fanins );
+      ++st.num_simulated_nodes;
+    }
+  }
+
+  /* computes only the words of `n` covering patterns added since its last update */
+  void extend( node const& n )
+  {
+    auto const num_bits = sim.num_bits();
+    auto const first_block = tts[n].num_bits() >> 6;
+    auto const num_suffix_bits = num_bits - ( first_block << 6 );
+
+    auto num_fanins = 0u;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      auto const& ftt = tts[ntk.get_node( f )];
+      auto& suffix = fanin_value( num_fanins++ );
+      suffix.resize( num_suffix_bits );
+      std::copy( ftt._bits.begin() + first_block, ftt._bits.end(), suffix._bits.begin() );
+    } );
+    auto const suffix = ntk.compute( n, fanin_values.begin(), fanin_values.begin() + num_fanins );
+
+    auto& tt = tts[n];
+    tt.resize( num_bits );
+    std::copy( suffix._bits.begin(), suffix._bits.end(), tt._bits.begin() + first_block );
+
+    ++st.num_extended_nodes;
+    st.num_extended_words += suffix.num_blocks();
+  }
+
+  /* reuses the buffers of fanin values to avoid reallocations */
+  TT& fanin_value( uint32_t i )
+  {
+    if ( i == fanin_values.size() )
+    {
+      fanin_values.emplace_back();
+    }
+    return fanin_values[i];
+  }
+
+  bool is_dead( node const& n ) const
+  {
+    if constexpr ( has_is_dead_v<Ntk> )
+    {
+      return ntk.is_dead( n );
+    }
+    else
+    {
+      (void)n;
+      return false;
+    }
+  }
+
+private:
+  Ntk& ntk;
+  partial_simulator const& sim;
+  incremental_simulation_params const ps;
+  incremental_simulation_stats st;
+
+  storage_type tts;
+  std::vector<node> dirty;
+  std::vector<TT> fanin_values;
+  uint32_t num_bits_const_pi{ 0u };
+
+  /* events */
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
+};
+
+} // namespace mockturtle
@@ -36,6 +36,7 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <queue>
 #include <sstream>
 #include <string>
@@ -52,6 +53,7 @@
 #include "../utils/cuts.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/thread_pool.hpp"
 #include "../utils/truth_table_cache.hpp"
 #include "../views/choice_view.hpp"
 #include "../views/mapping_view.hpp"
@@ -130,6 +132,17 @@ struct lut_map_params
   /*! \brief Maximum number variables for cost function caching */
   uint32_t cost_cache_vars{ 3u };
 
+  /*! \brief Number of threads for cut computation.
+   *
+   * The delay and area flow passes process the nodes of each topological
+   * level in parallel.  In area flow, the mapping references of a level are
+   * released before and committed after the level in topological order, so
+   * the result does not depend on the number of threads but may differ
+   * slightly from the single-threaded mapping.  Exact area, cut expansion,
+   * and mapping with truth tables are processed sequentially.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -157,12 +170,31 @@ struct lut_map_stats
   /*! \brief Depth and size stats for each round. */
   std::vector<std::string> round_stats{};
 
+  /*! \brief Number of threads used for cut computation. */
+  uint32_t num_threads{ 1 };
+
+  /*! \brief Wall-clock time of the parallel passes. */
+  stopwatch<>::duration time_parallel{ 0 };
+
+  /*! \brief Total time spent by the threads in the parallel passes. */
+  stopwatch<>::duration time_parallel_work{ 0 };
+
+  /*! \brief Speedup of the parallel passes over running their work on one thread. */
+  double parallel_speedup() const
+  {
+    return time_parallel.count() > 0 ? to_seconds( time_parallel_work ) / to_seconds( time_parallel ) : 1.0;
+  }
+
   void report() const
   {
     for ( auto const& stat : round_stats )
     {
       std::cout << stat;
     }
+    if ( num_threads > 1 )
+    {
+      std::cout << fmt::format( "[i] Parallel runtime        = {:>5.2f} secs  Speedup = {:>5.2f} ({} threads)\n", to_seconds( time_parallel ), parallel_speedup(), num_threads );
+    }
     std::cout << fmt::format( "[i] Total runtime           = {:>5.2f} secs\n", to_seconds( time_total ) );
   }
 };
@@ -609,6 +641,7 @@ public:
   static constexpr uint32_t max_cut_size = 16;
   static constexpr uint32_t max_cubes = 64;
   static constexpr uint32_t max_sop_decomp_size = max_cut_size * ( max_cubes + 1 );
+  static constexpr uint32_t parallel_grain = 32;
   using cut_t = cut<max_cut_size, cut_data<StoreFunction, cut_enumeration_lut_cut>>;
   using cut_set_t = lut_cut_set<cut_t, max_cut_num>;
   using node = typename Ntk::node;
@@ -627,10 +660,18 @@ public:
         ps( ps ),
         st( st ),
         node_match( ntk.size() ),
-        cuts( ntk.size() )
+        cuts( ntk.size() ),
+        threads_data( StoreFunction ? 1u : std::max( ps.num_threads, 1u ) )
   {
     assert( ps.cut_enumeration_ps.cut_limit < max_cut_num && "cut_limit exceeds the compile-time limit for the maximum number of cuts" );
 
+    /* the truth table caches are shared, mapping with functions is sequential */
+    st.num_threads = static_cast<uint32_t>( threads_data.size() );
+    if ( threads_data.size() > 1u )
+    {
+      pool = std::make_unique<thread_pool>( static_cast<uint32_t>( threads_data.size() ) );
+    }
+
     if constexpr ( StoreFunction )
     {
       TT zero( 0u ), proj( 1u );
@@ -701,6 +742,7 @@ private:
     /* init the data structure */
     init_nodes();
     init_cuts();
+    init_levels();
 
     /* compute mapping for depth or area */
     if ( !ps.area_oriented_mapping )
@@ -774,6 +816,11 @@ private:
       }
       ++i;
     }
+
+    for ( auto const& data : threads_data )
+    {
+      st.time_parallel_work += data.time_work;
+    }
   }
 
   void init_nodes()
@@ -800,45 +847,61 @@ private:
     } );
   }
 
-  template<bool DO_AREA, bool ELA>
-  void compute_mapping( lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts )
+  void init_levels()
   {
-    cuts_total = 0;
+    if ( pool == nullptr )
+      return;
+
+    std::vector<uint32_t> levels( ntk.size(), 0u );
+    uint32_t max_level = 0u;
     for ( auto const& n : topo_order )
     {
-      if constexpr ( !ELA )
-      {
-        auto const index = ntk.node_to_index( n );
-        if ( !preprocess && iteration != 0 )
-        {
-          node_match[index].est_refs = ( 2.0 * node_match[index].est_refs + 1.0 * node_match[index].map_refs ) / 3.0;
-        }
-        else
-        {
-          node_match[index].est_refs = static_cast<float>( node_match[index].map_refs );
-        }
-      }
-
       if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
-      {
         continue;
-      }
 
-      if ( recompute_cuts )
-      {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
-        {
-          compute_best_cut2<DO_AREA, ELA>( n, sort, preprocess );
-        }
-        else
-        {
-          compute_best_cut<DO_AREA, ELA>( n, sort, preprocess );
-        }
-      }
-      else
+      uint32_t level = 0u;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        level = std::max( level, levels[ntk.node_to_index( ntk.get_node( f ) )] );
+      } );
+      levels[ntk.node_to_index( n )] = level + 1u;
+      max_level = std::max( max_level, level + 1u );
+    }
+
+    /* bucket the nodes by level, keeping the topological order inside each level */
+    level_offsets.assign( max_level + 2u, 0u );
+    for ( auto const& n : topo_order )
+    {
+      ++level_offsets[levels[ntk.node_to_index( n )] + 1u];
+    }
+    for ( auto i = 1u; i < level_offsets.size(); ++i )
+    {
+      level_offsets[i] += level_offsets[i - 1u];
+    }
+    level_nodes.resize( topo_order.size() );
+    std::vector<uint32_t> positions( level_offsets.begin(), level_offsets.end() - 1u );
+    for ( auto const& n : topo_order )
+    {
+      level_nodes[positions[levels[ntk.node_to_index( n )]]++] = n;
+    }
+  }
+
+  template<bool DO_AREA, bool ELA>
+  void compute_mapping( lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts )
+  {
+    for ( auto& data : threads_data )
+    {
+      data.cuts_total = 0;
+    }
+
+    if ( !ELA && pool != nullptr )
+    {
+      compute_mapping_parallel<DO_AREA>( sort, preprocess, recompute_cuts );
+    }
+    else
+    {
+      for ( auto const& n : topo_order )
       {
-        /* update cost the function and move the best one first */
-        update_cut_data<DO_AREA, ELA>( n, sort );
+        compute_mapping_node<DO_AREA, ELA>( n, sort, preprocess, recompute_cuts, true, 0u );
       }
     }
 
@@ -855,24 +918,131 @@ private:
 
       if ( ( sort == lut_cut_sort_type::AREA || sort == lut_cut_sort_type::AREA2 ) && ELA )
       {
-        stats << fmt::format( "[i] Area     : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+        stats << fmt::format( "[i] Area     : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, num_cuts() );
       }
       else if ( sort == lut_cut_sort_type::AREA || sort == lut_cut_sort_type::AREA2 )
       {
-        stats << fmt::format( "[i] AreaFlow : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+        stats << fmt::format( "[i] AreaFlow : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, num_cuts() );
       }
       else if ( sort == lut_cut_sort_type::DELAY2 )
       {
-        stats << fmt::format( "[i] Delay2   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+        stats << fmt::format( "[i] Delay2   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, num_cuts() );
       }
       else
       {
-        stats << fmt::format( "[i] Delay    : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+        stats << fmt::format( "[i] Delay    : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, num_cuts() );
       }
       st.round_stats.push_back( stats.str() );
     }
   }
 
+  template<bool DO_AREA, bool ELA>
+  void compute_mapping_node( node const& n, lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts, bool update_refs, uint32_t thread_id )
+  {
+    if constexpr ( !ELA )
+    {
+      auto const index = ntk.node_to_index( n );
+      if ( !preprocess && iteration != 0 )
+      {
+        node_match[index].est_refs = ( 2.0 * node_match[index].est_refs + 1.0 * node_match[index].map_refs ) / 3.0;
+      }
+      else
+      {
+        node_match[index].est_refs = static_cast<float>( node_match[index].map_refs );
+      }
+    }
+
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+    {
+      return;
+    }
+
+    if ( recompute_cuts )
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+      {
+        compute_best_cut2<DO_AREA, ELA>( n, sort, preprocess, update_refs, thread_id );
+      }
+      else
+      {
+        compute_best_cut<DO_AREA, ELA>( n, sort, preprocess, update_refs, thread_id );
+      }
+    }
+    else
+    {
+      /* update cost the function and move the best one first */
+      update_cut_data<DO_AREA, ELA>( n, sort, update_refs );
+    }
+  }
+
+  /* Processes one topological level at a time.  The cuts of a node only
+   * depend on data of lower levels, which is final when the level starts.
+   * In area flow, the best cuts of the referenced nodes of the level are
+   * dereferenced before computing the level and referenced again after it
+   * in topological order, such that the result is independent of the
+   * scheduling of the threads. */
+  template<bool DO_AREA>
+  void compute_mapping_parallel( lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts )
+  {
+    bool const update_refs = DO_AREA && iteration != 0;
+    std::vector<uint32_t> referenced;
+
+    for ( auto l = 0u; l + 1u < level_offsets.size(); ++l )
+    {
+      auto const begin = level_offsets[l];
+      auto const size = level_offsets[l + 1u] - begin;
+
+      if ( update_refs )
+      {
+        referenced.clear();
+        for ( auto i = begin; i < begin + size; ++i )
+        {
+          auto const& n = level_nodes[i];
+          auto const index = ntk.node_to_index( n );
+          if ( ntk.is_constant( n ) || ntk.is_ci( n ) || node_match[index].map_refs == 0 )
+            continue;
+          cut_deref( cuts[index][0] );
+          referenced.push_back( index );
+        }
+      }
+
+      foreach_parallel( size, [&]( uint64_t i, uint32_t thread_id ) {
+        compute_mapping_node<DO_AREA, false>( level_nodes[begin + i], sort, preprocess, recompute_cuts, false, thread_id );
+      } );
+
+      for ( auto const index : referenced )
+      {
+        cut_ref( cuts[index][0] );
+      }
+    }
+  }
+
+  template<typename Fn>
+  void foreach_parallel( uint64_t size, Fn&& fn )
+  {
+    stopwatch t( st.time_parallel );
+
+    auto const num_chunks = ( size + parallel_grain - 1u ) / parallel_grain;
+    pool->parallel_for( num_chunks, [&]( uint64_t chunk, uint32_t thread_id ) {
+      stopwatch t_work( threads_data[thread_id].time_work );
+      auto const end = std::min<uint64_t>( size, ( chunk + 1u ) * parallel_grain );
+      for ( auto i = chunk * parallel_grain; i < end; ++i )
+      {
+        fn( i, thread_id );
+      }
+    } );
+  }
+
+  uint32_t num_cuts() const
+  {
+    uint32_t total = 0u;
+    for ( auto const& data : threads_data )
+    {
+      total += data.cuts_total;
+    }
+    return total;
+  }
+
   void compute_share_mapping( lut_cut_sort_type const sort, bool first )
   {
     /* reset required times and references except for POs */
@@ -895,7 +1065,7 @@ private:
 
     /* round stats */
     {
-      st.round_stats.push_back( fmt::format( "[i] AreaSh   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total ) );
+      st.round_stats.push_back( fmt::format( "[i] AreaSh   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, num_cuts() ) );
     }
   }
 
@@ -922,7 +1092,7 @@ private:
 
     set_mapping_refs<ELA>();
 
-    std::string stats = fmt::format( "[i] Reduce   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+    std::string stats = fmt::format( "[i] Reduce   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, num_cuts() );
     st.round_stats.push_back( stats );
   }
 
@@ -1139,7 +1309,7 @@ private:
   }
 
   template<bool DO_AREA, bool ELA>
-  void compute_best_cut2( node const& n, lut_cut_sort_type const sort, bool preprocess )
+  void compute_best_cut2( node const& n, lut_cut_sort_type const sort, bool preprocess, bool update_refs, uint32_t thread_id )
   {
     auto index = ntk.node_to_index( n );
     auto& node_data = node_match[index];
@@ -1148,7 +1318,8 @@ private:
     /* compute cuts */
     const auto fanin = 2;
     uint32_t pairs{ 1 };
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
+    cut_merge_t lcuts{};
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
       pairs *= static_cast<uint32_t>( lcuts[i]->size() );
     } );
@@ -1157,7 +1328,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( update_refs && iteration != 0 && node_data.map_refs > 0 )
       {
         cut_deref( rcuts[0] );
       }
@@ -1226,7 +1397,7 @@ private:
       }
     }
 
-    cuts_total += rcuts.size();
+    threads_data[thread_id].cuts_total += rcuts.size();
 
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_enumeration_ps.cut_limit );
@@ -1243,7 +1414,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( update_refs && iteration != 0 && node_data.map_refs > 0 )
       {
         cut_ref( rcuts[0] );
       }
@@ -1251,7 +1422,7 @@ private:
   }
 
   template<bool DO_AREA, bool ELA>
-  void compute_best_cut( node const& n, lut_cut_sort_type const sort, bool preprocess )
+  void compute_best_cut( node const& n, lut_cut_sort_type const sort, bool preprocess, bool update_refs, uint32_t thread_id )
   {
     auto index = ntk.node_to_index( n );
     auto& node_data = node_match[index];
@@ -1259,8 +1430,9 @@ private:
 
     /* compute cuts */
     uint32_t pairs{ 1 };
+    cut_merge_t lcuts{};
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
@@ -1271,7 +1443,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( update_refs && iteration != 0 && node_data.map_refs > 0 )
       {
         cut_deref( rcuts[0] );
       }
@@ -1394,7 +1566,7 @@ private:
       rcuts.limit( ps.cut_enumeration_ps.cut_limit );
     }
 
-    cuts_total += rcuts.size();
+    threads_data[thread_id].cuts_total += rcuts.size();
 
     /* replace the new best cut with previous one */
     if ( preprocess && rcuts[0]->data.delay > node_data.required )
@@ -1404,7 +1576,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( update_refs && iteration != 0 && node_data.map_refs > 0 )
       {
         cut_ref( rcuts[0] );
       }
@@ -1412,7 +1584,7 @@ private:
   }
 
   template<bool DO_AREA, bool ELA>
-  void update_cut_data( node const& n, lut_cut_sort_type const sort )
+  void update_cut_data( node const& n, lut_cut_sort_type const sort, bool update_refs )
   {
     auto index = ntk.node_to_index( n );
     auto& node_data = node_match[index];
@@ -1424,7 +1596,7 @@ private:
 
     if constexpr ( DO_AREA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( update_refs && iteration != 0 && node_data.map_refs > 0 )
       {
         cut_deref( *best_cut );
       }
@@ -1468,7 +1640,7 @@ private:
 
     if constexpr ( DO_AREA || ELA )
     {
-      if ( iteration != 0 && node_data.map_refs > 0 )
+      if ( update_refs && iteration != 0 && node_data.map_refs > 0 )
       {
         cut_ref( *best_cut );
       }
@@ -2145,7 +2317,7 @@ private:
 
     {
       std::stringstream stats;
-      stats << fmt::format( "[i] Area MFFC: Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+      stats << fmt::format( "[i] Area MFFC: Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, num_cuts() );
       st.round_stats.push_back( stats.str() );
     }
   }
@@ -2835,7 +3007,6 @@ private:
   uint32_t delay{ 0 };           /* current delay of the mapping */
   uint32_t area{ 0 };            /* current area of the mapping */
   uint32_t edges{ 0 };           /* current edges of the mapping */
-  uint32_t cuts_total{ 0 };      /* current computed cuts */
   const float epsilon{ 0.005f }; /* epsilon */
   LUTCostFn lut_cost{};
 
@@ -2844,10 +3015,22 @@ private:
   std::vector<node_lut> node_match;
 
   std::vector<cut_set_t> cuts;  /* compressed representation of cuts */
-  cut_merge_t lcuts;            /* cut merger container */
   tt_cache truth_tables;        /* cut truth tables */
   cost_cache truth_tables_cost; /* truth tables cost */
   isop_cache isops;             /* cache for isops */
+
+  /* per-thread data */
+  struct alignas( 64 ) thread_data
+  {
+    uint32_t cuts_total{ 0 };             /* current computed cuts */
+    stopwatch<>::duration time_work{ 0 }; /* time spent in parallel passes */
+  };
+  std::vector<thread_data> threads_data;
+
+  /* parallel cut computation */
+  std::unique_ptr<thread_pool> pool;   /* worker threads, if `num_threads > 1` */
+  std::vector<node> level_nodes;       /* nodes bucketed by level */
+  std::vector<uint32_t> level_offsets; /* first node of each level in `level_nodes` */
 };
 #pragma endregion
 
@@ -38,17 +38,21 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/hash.hpp>
+#include <kitty/operations.hpp>
 #include <kitty/print.hpp>
 #include <kitty/traits.hpp>
 
 #include "../../networks/aig.hpp"
 #include "../../networks/klut.hpp"
 #include "../../networks/xmg.hpp"
+#include "../../utils/exact_synthesis_cache.hpp"
+#include "../parallel_exact_synthesis.hpp"
 #include "../../utils/include/percy.hpp"
 
 namespace mockturtle
@@ -65,6 +69,9 @@ struct exact_resynthesis_params
   cache_t cache;
   blacklist_cache_t blacklist_cache;
 
+  /*! \brief Persistent cache, keyed by NPN class, shared across runs and processes. */
+  std::shared_ptr<exact_synthesis_cache> persistent_cache;
+
   bool add_alonce_clauses{ true };
   bool add_colex_clauses{ true };
   bool add_lex_clauses{ false };
@@ -79,8 +86,82 @@ struct exact_resynthesis_params
   percy::EncoderType encoder_type = percy::ENC_SSV;
 
   percy::SynthMethod synthesis_method = percy::SYNTH_STD;
+
+  /*! \brief Number of threads for exact synthesis (see `parallel_exact_synthesis`). */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Wall-clock time limit per synthesized function in milliseconds (0 means no limit). */
+  uint32_t time_limit{ 0u };
+
+  /*! \brief Description of the parameters which affect the synthesized chains. */
+  std::string persistent_cache_description() const
+  {
+    return std::to_string( add_alonce_clauses ) + std::to_string( add_colex_clauses ) + std::to_string( add_lex_clauses ) +
+           std::to_string( add_lex_func_clauses ) + std::to_string( add_nontriv_clauses ) + std::to_string( add_noreapply_clauses ) +
+           std::to_string( add_symvar_clauses ) + ";" + std::to_string( conflict_limit ) + ";" + std::to_string( solver_type ) + ";" +
+           std::to_string( encoder_type ) + ";" + std::to_string( synthesis_method );
+  }
 };
 
+namespace detail
+{
+
+/* uses the parallel front-end, which ignores the solver, encoder, and synthesis method, for several threads or a time limit */
+inline percy::synth_result exact_synthesize( percy::spec& spec, percy::chain& chain, exact_resynthesis_params const& ps )
+{
+  if ( ps.num_threads <= 1u && ps.time_limit == 0u )
+  {
+    return percy::synthesize( spec, chain, ps.solver_type, ps.encoder_type, ps.synthesis_method );
+  }
+
+  parallel_exact_synthesis_params pps;
+  pps.num_threads = ps.num_threads;
+  pps.time_limit = ps.time_limit;
+  return parallel_exact_synthesis( spec, chain, pps );
+}
+
+/* Derives the chain of `f` from the chain of its NPN representative `r`, where
+   f(x) = o ^ r(y) and y_i = x_{perm[i]} ^ phase_{perm[i]} (see `kitty::exact_npn_canonization`);
+   negations are absorbed into the operators of the steps */
+inline std::optional<percy::chain> apply_npn_transformation( percy::chain const& c, uint32_t phase, std::vector<uint8_t> const& perm )
+{
+  auto const nr_in = c.get_nr_inputs();
+  auto const nr_steps = c.get_nr_steps();
+  if ( nr_steps == 0 || c.get_nr_outputs() != 1 || ( c.get_outputs()[0] >> 1 ) != nr_in + nr_steps )
+  {
+    return std::nullopt;
+  }
+
+  percy::chain t = c;
+  bool const negate_output = ( ( phase >> nr_in ) & 1 ) != ( c.get_outputs()[0] & 1 );
+  for ( auto i = 0; i < nr_steps; ++i )
+  {
+    auto step = c.get_step( i );
+    auto op = c.get_operator( i );
+    for ( auto j = 0u; j < step.size(); ++j )
+    {
+      if ( step[j] < nr_in )
+      {
+        auto const v = perm[step[j]];
+        if ( ( phase >> v ) & 1 )
+        {
+          kitty::flip_inplace( op, j );
+        }
+        step[j] = v;
+      }
+    }
+    if ( i + 1 == nr_steps && negate_output )
+    {
+      op = ~op;
+    }
+    t.set_step( i, step, op );
+  }
+  t.set_output( 0, ( nr_in + nr_steps ) << 1 );
+  return t;
+}
+
+} // namespace detail
+
 /*! \brief Resynthesis function based on exact synthesis.
  *
  * This resynthesis function can be passed to ``node_resynthesis``,
@@ -187,10 +268,51 @@ public:
         }
       }
 
+      if ( !with_dont_cares && _ps.persistent_cache )
+      {
+        /* the persistent cache stores the chain of the NPN representative */
+        auto const [repr, phase, perm] = exact_synthesis_cache::canonize( function );
+        auto const config = exact_synthesis_cache::configuration( "lut;" + std::to_string( _fanin_size ) + ";" + _ps.persistent_cache_description() );
+        std::optional<percy::chain> repr_chain;
+        if ( auto const e = _ps.persistent_cache->lookup( config, repr ) )
+        {
+          if ( e->chains.empty() )
+          {
+            return std::nullopt;
+          }
+          repr_chain = e->chains.front();
+        }
+        else
+        {
+          spec[0] = repr;
+          percy::chain rc;
+          if ( const auto result = detail::exact_synthesize( spec, rc, _ps );
+               result != percy::success )
+          {
+            if ( result == percy::failure || _ps.time_limit == 0u ) /* time limits do not give reproducible results */
+            {
+              _ps.persistent_cache->insert( config, repr, exact_synthesis_cache::entry_status::none, {} );
+            }
+            return std::nullopt;
+          }
+          rc.denormalize();
+          _ps.persistent_cache->insert( config, repr, exact_synthesis_cache::entry_status::complete, { rc } );
+          repr_chain = rc;
+        }
+
+        if ( auto const c = detail::apply_npn_transformation( *repr_chain, phase, perm ) )
+        {
+          if ( _ps.cache )
+          {
+            ( *_ps.cache )[function] = *c;
+          }
+          return c;
+        }
+        spec[0] = function; /* degenerated chain, synthesize the function itself */
+      }
+
       percy::chain c;
-      if ( const auto result = percy::synthesize( spec, c, _ps.solver_type,
-                                                  _ps.encoder_type,
-                                                  _ps.synthesis_method );
+      if ( const auto result = detail::exact_synthesize( spec, c, _ps );
            result != percy::success )
       {
         if ( !with_dont_cares && _ps.blacklist_cache )
@@ -344,6 +466,14 @@ public:
       spec.add_function( f.second );
     }
 
+    /* signals of the chain inputs */
+    std::vector<signal> signals( begin, end );
+    for ( const auto& f : existing_functions )
+    {
+      signals.emplace_back( f.first );
+    }
+    bool negate_output{ false };
+
     auto c = [&]() -> std::optional<percy::chain> {
       if ( !with_dont_cares && _ps.cache )
       {
@@ -362,10 +492,53 @@ public:
         }
       }
 
+      if ( !with_dont_cares && _ps.persistent_cache && existing_functions.empty() && !_lower_bound && !_upper_bound && signals.size() == function.num_vars() )
+      {
+        /* the persistent cache stores the chain of the NPN representative, the
+           transformation is applied to the inputs and to the output */
+        auto const [repr, phase, perm] = exact_synthesis_cache::canonize( function );
+        auto const config = exact_synthesis_cache::configuration( std::string( _allow_xor ? "xag;" : "aig;" ) + _ps.persistent_cache_description() );
+        std::optional<percy::chain> repr_chain;
+        if ( auto const e = _ps.persistent_cache->lookup( config, repr ) )
+        {
+          if ( e->chains.empty() )
+          {
+            return std::nullopt;
+          }
+          repr_chain = e->chains.front();
+        }
+        else
+        {
+          spec[0] = repr;
+          percy::chain rc;
+          if ( const auto result = detail::exact_synthesize( spec, rc, _ps );
+               result != percy::success )
+          {
+            if ( result == percy::failure || _ps.time_limit == 0u ) /* time limits do not give reproducible results */
+            {
+              _ps.persistent_cache->insert( config, repr, exact_synthesis_cache::entry_status::none, {} );
+            }
+            return std::nullopt;
+          }
+          _ps.persistent_cache->insert( config, repr, exact_synthesis_cache::entry_status::complete, { rc } );
+          repr_chain = rc;
+        }
+
+        if ( repr_chain->get_nr_steps() > 0 )
+        {
+          std::vector<signal> const leaves( signals );
+          for ( auto i = 0u; i < perm.size(); ++i )
+          {
+            signals[i] = ( ( phase >> perm[i] ) & 1 ) ? !leaves[perm[i]] : leaves[perm[i]];
+          }
+          negate_output = ( phase >> function.num_vars() ) & 1;
+          return repr_chain;
+        }
+        spec[0] = function; /* degenerated chain, synthesize the function itself */
+      }
+
       percy::chain c;
-      if ( const auto result = percy::synthesize( spec, c, _ps.solver_type,
-                                                  _ps.encoder_type,
-                                                  _ps.synthesis_method );
+      if ( const auto result = detail::exact_synthesize( spec, c, _ps );
            result != percy::success )
       {
         if ( !with_dont_cares && _ps.blacklist_cache )
@@ -389,12 +562,6 @@ public:
       return;
     }
 
-    std::vector<signal> signals( begin, end );
-    for ( const auto& f : existing_functions )
-    {
-      signals.emplace_back( f.first );
-    }
-
     for ( auto i = 0; i < c->get_nr_steps(); ++i )
     {
       auto const c1 = signals[c->get_step( i )[0]];
@@ -424,7 +591,7 @@ public:
       }
     }
 
-    fn( c->is_output_inverted( 0 ) ? !signals.back() : signals.back() );
+    fn( c->is_output_inverted( 0 ) != negate_output ? !signals.back() : signals.back() );
   }
 
   void set_bounds( std::optional<uint32_t> const& lower_bound, std::optional<uint32_t> const& upper_bound )
@@ -449,6 +616,9 @@ struct exact_xmg_resynthesis_params
   bool use_only_self_dual_gates{ false };
   bool use_xor3{ true };
   int conflict_limit{ 0 };
+
+  /*! \brief Persistent cache, keyed by NPN class, shared across runs and processes. */
+  std::shared_ptr<exact_synthesis_cache> persistent_cache;
 };
 
 /*! \brief Resynthesis function based on exact synthesis for XMGs.
@@ -495,7 +665,6 @@ public:
     auto const tt = function.num_vars() < 3u ? kitty::extend_to( function, 3u ) : function;
     bool const normal = kitty::is_normal( tt );
 
-    percy::chain chain;
     percy::spec spec;
     spec.verbosity = 0;
     spec.fanin = 3;
@@ -545,11 +714,75 @@ public:
       spec.add_primitive( kitty::ternary_majority( a, ~b, const0 ) ); // 22
     }
 
+    std::vector<signal> leaves( tt.num_vars(), ntk.get_constant( false ) );
+    std::copy( begin, end, leaves.begin() );
+
+    if ( !ps.persistent_cache )
+    {
+      spec[0] = normal ? tt : ~tt;
+      enumerate( spec, 0u, [&]( percy::chain const& chain ) {
+        return fn( build( ntk, chain, leaves, normal ) );
+      } );
+      return;
+    }
+
+    /* the persistent cache stores the chains of the NPN representative, the
+       transformation is applied to the inputs and to the output */
+    auto const [repr, phase, perm] = exact_synthesis_cache::canonize( tt );
+    bool const repr_normal = kitty::is_normal( repr );
+    bool const negate_output = ( phase >> tt.num_vars() ) & 1;
+    auto const config = exact_synthesis_cache::configuration( "xmg;" + std::to_string( ps.num_candidates ) + ";" + std::to_string( ps.use_only_self_dual_gates ) + std::to_string( ps.use_xor3 ) + ";" + std::to_string( ps.conflict_limit ) );
+
+    std::vector<signal> inputs( leaves.size() );
+    for ( auto i = 0u; i < perm.size(); ++i )
+    {
+      inputs[i] = ( ( phase >> perm[i] ) & 1 ) ? !leaves[perm[i]] : leaves[perm[i]];
+    }
+    auto const on_chain = [&]( percy::chain const& chain ) {
+      auto const s = build( ntk, chain, inputs, repr_normal );
+      return fn( negate_output ? !s : s );
+    };
+
+    std::vector<percy::chain> chains;
+    auto status = exact_synthesis_cache::entry_status::partial;
+    if ( auto e = ps.persistent_cache->lookup( config, repr ) )
+    {
+      for ( auto const& chain : e->chains )
+      {
+        if ( !on_chain( chain ) )
+        {
+          return; /* quit */
+        }
+      }
+      if ( e->status != exact_synthesis_cache::entry_status::partial )
+      {
+        return;
+      }
+      chains = std::move( e->chains );
+    }
+
+    /* enumerate the remaining solutions and store them */
+    spec[0] = repr_normal ? repr : ~repr;
+    bool const quit = enumerate( spec, static_cast<uint32_t>( chains.size() ), [&]( percy::chain const& chain ) {
+      chains.emplace_back( chain );
+      return on_chain( chain );
+    } );
+    if ( !quit || chains.size() >= ps.num_candidates )
+    {
+      status = chains.empty() ? exact_synthesis_cache::entry_status::none : exact_synthesis_cache::entry_status::complete;
+    }
+    ps.persistent_cache->insert( config, repr, status, chains );
+  }
+
+private:
+  /* enumerates up to `num_candidates` solutions, skipping the first `skip` ones; returns true if `on_chain` quits */
+  template<typename Fn>
+  bool enumerate( percy::spec& spec, uint32_t skip, Fn&& on_chain ) const
+  {
+    percy::chain chain;
     percy::bsat_wrapper solver;
     percy::ssv_encoder encoder( solver );
 
-    spec[0] = normal ? tt : ~tt;
-
     for ( auto i = 0u; i < ps.num_candidates; ++i )
     {
       auto const result = percy::next_struct_solution( spec, chain, solver, encoder );
@@ -557,99 +790,105 @@ public:
         break;
 
       assert( result == percy::success );
-
-      auto const sim = chain.simulate();
       assert( chain.simulate()[0] == spec[0] );
 
-      std::vector<signal> signals( tt.num_vars(), ntk.get_constant( false ) );
-      std::copy( begin, end, signals.begin() );
-
-      for ( auto i = 0; i < chain.get_nr_steps(); ++i )
+      if ( i < skip )
       {
-        auto const c1 = signals[chain.get_step( i )[0]];
-        auto const c2 = signals[chain.get_step( i )[1]];
-        auto const c3 = signals[chain.get_step( i )[2]];
-
-        switch ( chain.get_operator( i )._bits[0] )
-        {
-        case 0x00:
-          signals.emplace_back( ntk.get_constant( false ) );
-          break;
-        case 0xe8:
-          signals.emplace_back( ntk.create_maj( c1, c2, c3 ) );
-          break;
-        case 0xd4:
-          signals.emplace_back( ntk.create_maj( !c1, c2, c3 ) );
-          break;
-        case 0xb2:
-          signals.emplace_back( ntk.create_maj( c1, !c2, c3 ) );
-          break;
-        case 0x8e:
-          signals.emplace_back( ntk.create_maj( c1, c2, !c3 ) );
-          break;
-        case 0x96:
-          signals.emplace_back( ntk.create_xor3( c1, c2, c3 ) );
-          break;
-        case 0xc0:
-          signals.emplace_back( ntk.create_maj( ntk.get_constant( false ), c2, c3 ) ); // c0
-          break;
-        case 0xfc:
-          signals.emplace_back( ntk.create_maj( !ntk.get_constant( false ), c2, c3 ) ); // fc
-          break;
-        case 0x30:
-          signals.emplace_back( ntk.create_maj( ntk.get_constant( false ), !c2, c3 ) ); // 30
-          break;
-        case 0x0c:
-          signals.emplace_back( ntk.create_maj( ntk.get_constant( false ), c2, !c3 ) ); // 0c
-          break;
-        case 0xa0:
-          signals.emplace_back( ntk.create_maj( c1, ntk.get_constant( false ), c3 ) ); // 0a
-          break;
-        case 0x50:
-          signals.emplace_back( ntk.create_maj( !c1, ntk.get_constant( false ), c3 ) ); // 50
-          break;
-        case 0xfa:
-          signals.emplace_back( ntk.create_maj( c1, !ntk.get_constant( false ), c3 ) ); // fa
-          break;
-        case 0x0a:
-          signals.emplace_back( ntk.create_maj( c1, ntk.get_constant( false ), !c3 ) ); // 0a
-          break;
-        case 0x88:
-          signals.emplace_back( ntk.create_maj( c1, c2, ntk.get_constant( false ) ) ); // 88
-          break;
-        case 0xee:
-          signals.emplace_back( ntk.create_maj( c1, c2, !ntk.get_constant( false ) ) ); // ee
-          break;
-        case 0x44:
-          signals.emplace_back( ntk.create_maj( !c1, c2, ntk.get_constant( false ) ) ); // 44
-          break;
-        case 0x22:
-          signals.emplace_back( ntk.create_maj( c1, !c2, ntk.get_constant( false ) ) ); // 22
-          break;
-        case 0x66:
-          signals.emplace_back( ntk.create_xor( c1, c2 ) );
-          break;
-        case 0x3c:
-          signals.emplace_back( ntk.create_xor( c2, c3 ) );
-          break;
-        case 0x5a:
-          signals.emplace_back( ntk.create_xor( c1, c3 ) );
-          break;
-        default:
-          std::cerr << "[e] unsupported operation " << kitty::to_hex( chain.get_operator( i ) ) << "\n";
-          assert( false );
-          break;
-        }
+        continue;
+      }
+      if ( !on_chain( chain ) )
+      {
+        return true; /* quit */
       }
+    }
+    return false;
+  }
+
+  /* builds the chain on top of the input signals and returns the output signal */
+  signal<Ntk> build( Ntk& ntk, percy::chain const& chain, std::vector<signal<Ntk>> signals, bool normal ) const
+  {
+    for ( auto i = 0; i < chain.get_nr_steps(); ++i )
+    {
+      auto const c1 = signals[chain.get_step( i )[0]];
+      auto const c2 = signals[chain.get_step( i )[1]];
+      auto const c3 = signals[chain.get_step( i )[2]];
 
-      assert( chain.get_outputs().size() > 0u );
-      uint32_t const output_index = ( chain.get_outputs()[0u] >> 1u );
-      auto const output_signal = output_index == 0u ? ntk.get_constant( false ) : signals[output_index - 1];
-      if ( !fn( chain.is_output_inverted( 0 ) ^ normal ? output_signal : !output_signal ) )
+      switch ( chain.get_operator( i )._bits[0] )
       {
-        return; /* quit */
+      case 0x00:
+        signals.emplace_back( ntk.get_constant( false ) );
+        break;
+      case 0xe8:
+        signals.emplace_back( ntk.create_maj( c1, c2, c3 ) );
+        break;
+      case 0xd4:
+        signals.emplace_back( ntk.create_maj( !c1, c2, c3 ) );
+        break;
+      case 0xb2:
+        signals.emplace_back( ntk.create_maj( c1, !c2, c3 ) );
+        break;
+      case 0x8e:
+        signals.emplace_back( ntk.create_maj( c1, c2, !c3 ) );
+        break;
+      case 0x96:
+        signals.emplace_back( ntk.create_xor3( c1, c2, c3 ) );
+        break;
+      case 0xc0:
+        signals.emplace_back( ntk.create_maj( ntk.get_constant( false ), c2, c3 ) ); // c0
+        break;
+      case 0xfc:
+        signals.emplace_back( ntk.create_maj( !ntk.get_constant( false ), c2, c3 ) ); // fc
+        break;
+      case 0x30:
+        signals.emplace_back( ntk.create_maj( ntk.get_constant( false ), !c2, c3 ) ); // 30
+        break;
+      case 0x0c:
+        signals.emplace_back( ntk.create_maj( ntk.get_constant( false ), c2, !c3 ) ); // 0c
+        break;
+      case 0xa0:
+        signals.emplace_back( ntk.create_maj( c1, ntk.get_constant( false ), c3 ) ); // 0a
+        break;
+      case 0x50:
+        signals.emplace_back( ntk.create_maj( !c1, ntk.get_constant( false ), c3 ) ); // 50
+        break;
+      case 0xfa:
+        signals.emplace_back( ntk.create_maj( c1, !ntk.get_constant( false ), c3 ) ); // fa
+        break;
+      case 0x0a:
+        signals.emplace_back( ntk.create_maj( c1, ntk.get_constant( false ), !c3 ) ); // 0a
+        break;
+      case 0x88:
+        signals.emplace_back( ntk.create_maj( c1, c2, ntk.get_constant( false ) ) ); // 88
+        break;
+      case 0xee:
+        signals.emplace_back( ntk.create_maj( c1, c2, !ntk.get_constant( false ) ) ); // ee
+        break;
+      case 0x44:
+        signals.emplace_back( ntk.create_maj( !c1, c2, ntk.get_constant( false ) ) ); // 44
+        break;
+      case 0x22:
+        signals.emplace_back( ntk.create_maj( c1, !c2, ntk.get_constant( false ) ) ); // 22
+        break;
+      case 0x66:
+        signals.emplace_back( ntk.create_xor( c1, c2 ) );
+        break;
+      case 0x3c:
+        signals.emplace_back( ntk.create_xor( c2, c3 ) );
+        break;
+      case 0x5a:
+        signals.emplace_back( ntk.create_xor( c1, c3 ) );
+        break;
+      default:
+        std::cerr << "[e] unsupported operation " << kitty::to_hex( chain.get_operator( i ) ) << "\n";
+        assert( false );
+        break;
       }
     }
+
+    assert( chain.get_outputs().size() > 0u );
+    uint32_t const output_index = ( chain.get_outputs()[0u] >> 1u );
+    auto const output_signal = output_index == 0u ? ntk.get_constant( false ) : signals[output_index - 1];
+    return ( chain.get_outputs()[0u] & 1 ) ^ normal ? output_signal : !output_signal;
   }
 
 protected:
@@ -45,6 +45,7 @@
 #include "../../algorithms/cleanup.hpp"
 #include "../../networks/mig.hpp"
 #include "../../traits.hpp"
+#include "../../utils/npn_canonization_cache.hpp"
 #include "../../views/topo_view.hpp"
 
 namespace mockturtle
@@ -94,9 +95,9 @@ public:
   {
     assert( function.num_vars() <= 4 );
     const auto fe = kitty::extend_to( function, 4 );
-    const auto config = kitty::exact_npn_canonization( fe );
+    const auto config = npn4_canonization_table::get()( static_cast<uint16_t>( *fe.cbegin() ) );
 
-    const auto it = class2signal.find( static_cast<uint16_t>( std::get<0>( config )._bits[0] ) );
+    const auto it = class2signal.find( static_cast<uint16_t>( *std::get<0>( config ).cbegin() ) );
 
     std::vector<mig_network::signal> pis( 4, mig.get_constant( false ) );
     std::copy( begin, end, pis.begin() );
@@ -49,6 +49,7 @@
 #include "../../networks/xag.hpp"
 #include "../../utils/index_list/index_list.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/npn_canonization_cache.hpp"
 #include "../../utils/stopwatch.hpp"
 
 namespace mockturtle
@@ -112,7 +113,7 @@ public:
   xag_npn_resynthesis( xag_npn_resynthesis_params const& ps = {}, xag_npn_resynthesis_stats* pst = nullptr )
       : ps( ps ),
         pst( pst ),
-        _repr( 1u << 16u )
+        _classes( npn4_canonization_table::get() )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
@@ -155,7 +156,7 @@ public:
     kitty::static_truth_table<4u> tt = kitty::extend_to<4u>( function );
 
     /* get representative of function */
-    const auto [repr, phase, perm] = _repr[*tt.cbegin()];
+    const auto [repr, phase, perm] = _classes( static_cast<uint16_t>( *tt.cbegin() ) );
 
     /* check if representative has circuits */
     const auto it = _repr_to_signal.find( repr );
@@ -208,12 +209,8 @@ private:
   {
     stopwatch t( st.time_classes );
 
-    kitty::static_truth_table<4u> tt;
-    do
-    {
-      _repr[*tt.cbegin()] = kitty::exact_npn_canonization( tt );
-      kitty::next_inplace( tt );
-    } while ( !kitty::is_const0( tt ) );
+    /* the shared table is built on first use */
+    (void)_classes.num_classes();
   }
 
   void build_db()
@@ -235,7 +232,7 @@ private:
     const auto sim_res = simulate_nodes<kitty::static_truth_table<4u>>( _db );
 
     _db.foreach_node( [&]( auto n ) {
-      if ( std::get<0>( _repr[*sim_res[n].cbegin()] ) == sim_res[n] )
+      if ( _classes.representative( static_cast<uint16_t>( *sim_res[n].cbegin() ) ) == *sim_res[n].cbegin() )
       {
         if ( _repr_to_signal.count( sim_res[n] ) == 0 )
         {
@@ -249,7 +246,7 @@ private:
       else
       {
         const auto f = ~sim_res[n];
-        if ( std::get<0>( _repr[*f.cbegin()] ) == f )
+        if ( _classes.representative( static_cast<uint16_t>( *f.cbegin() ) ) == *f.cbegin() )
         {
           if ( _repr_to_signal.count( f ) == 0 )
           {
@@ -271,7 +268,7 @@ private:
   xag_npn_resynthesis_stats st;
   xag_npn_resynthesis_stats* pst{ nullptr };
 
-  std::vector<std::tuple<kitty::static_truth_table<4u>, uint32_t, std::vector<uint8_t>>> _repr;
+  npn4_canonization_table const& _classes;
   std::unordered_map<kitty::static_truth_table<4u>, std::vector<signal<DatabaseNtk>>, kitty::hash<kitty::static_truth_table<4u>>> _repr_to_signal;
 
   DatabaseNtk _db;
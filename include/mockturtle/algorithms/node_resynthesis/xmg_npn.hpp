@@ -49,6 +49,7 @@
 #include "../../io/write_bench.hpp"
 #include "../../networks/xmg.hpp"
 #include "../../traits.hpp"
+#include "../../utils/npn_canonization_cache.hpp"
 #include "../../views/topo_view.hpp"
 
 namespace mockturtle
@@ -89,7 +90,7 @@ public:
   {
     assert( function.num_vars() <= 4 );
     const auto fe = kitty::extend_to( function, 4 );
-    const auto config = kitty::exact_npn_canonization( fe );
+    const auto config = npn4_canonization_table::get()( static_cast<uint16_t>( *fe.cbegin() ) );
 
     auto func_str = "0x" + kitty::to_hex( std::get<0>( config ) );
     const auto it = class2signal.find( func_str );
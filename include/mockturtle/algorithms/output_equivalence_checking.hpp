@@ -0,0 +1,776 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file output_equivalence_checking.hpp
+  \brief Output-partitioned combinational equivalence checking
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../networks/xag.hpp"
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../views/fanout_view.hpp"
+#include "../views/topo_view.hpp"
+#include "circuit_validator.hpp"
+#include "cleanup.hpp"
+#include "cnf.hpp"
+#include "incremental_simulation.hpp"
+#include "simulation.hpp"
+
+#include <bill/sat/interface/abc_bsat2.hpp>
+#include <bill/sat/interface/common.hpp>
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/isop.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for output_equivalence_checking.
+ *
+ * The data structure `output_equivalence_checking_params` holds configurable
+ * parameters with default arguments for `output_equivalence_checking`.
+ */
+struct output_equivalence_checking_params
+{
+  /*! \brief Conflict limit for the SAT solver of every output pair.
+   *
+   * The default limit is 0, which means the number of conflicts is not used
+   * as a resource limit.
+   */
+  uint32_t conflict_limit{ 0u };
+
+  /*! \brief Number of random patterns to distinguish outputs before proving (0 disables simulation). */
+  uint32_t num_random_patterns{ 1024u };
+
+  /*! \brief Seed for the random patterns. */
+  uint32_t random_seed{ 1u };
+
+  /*! \brief Whether to merge equivalent internal nodes (SAT sweeping) before proving output pairs. */
+  bool functional_reduction{ true };
+
+  /*! \brief Conflict limit for proving a pair of internal nodes during SAT sweeping. */
+  uint32_t sweep_conflict_limit{ 1000u };
+
+  /*! \brief Number of threads for proving output pairs. */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Stop as soon as one output pair is proven not equivalent. */
+  bool stop_at_first_cex{ false };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for output_equivalence_checking.
+ *
+ * The data structure `output_equivalence_checking_stats` provides data
+ * collected by running `output_equivalence_checking`.
+ */
+struct output_equivalence_checking_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{};
+
+  /*! \brief Time for random simulation. */
+  stopwatch<>::duration time_simulation{};
+
+  /*! \brief Time for SAT sweeping. */
+  stopwatch<>::duration time_reduction{};
+
+  /*! \brief Time for SAT solving of output pairs (summed over all threads). */
+  stopwatch<>::duration time_sat{};
+
+  /*! \brief Verdict for every output pair (`nullopt` if undecided). */
+  std::vector<std::optional<bool>> output_results;
+
+  /*! \brief Counter-example for every non-equivalent output pair (empty otherwise). */
+  std::vector<std::vector<bool>> counter_examples;
+
+  /*! \brief Number of output pairs proven equivalent by structural hashing (after functional reduction). */
+  uint32_t num_structural{ 0u };
+
+  /*! \brief Number of internal nodes merged by SAT sweeping. */
+  uint32_t num_merged{ 0u };
+
+  /*! \brief Number of output pairs distinguished by random simulation. */
+  uint32_t num_simulated{ 0u };
+
+  /*! \brief Number of output pairs checked with SAT. */
+  uint32_t num_sat_calls{ 0u };
+
+  void report() const
+  {
+    auto const num_equivalent = std::count( output_results.begin(), output_results.end(), std::optional<bool>( true ) );
+    auto const num_different = std::count( output_results.begin(), output_results.end(), std::optional<bool>( false ) );
+    auto const num_undecided = std::count( output_results.begin(), output_results.end(), std::nullopt );
+
+    // clang-format off
+    std::cout << fmt::format( "[i] outputs     = {:8d}\n", output_results.size() );
+    std::cout << fmt::format( "[i] equivalent  = {:8d} ({} structurally)\n", num_equivalent, num_structural );
+    std::cout << fmt::format( "[i] different   = {:8d} ({} by simulation)\n", num_different, num_simulated );
+    std::cout << fmt::format( "[i] undecided   = {:8d}\n", num_undecided );
+    std::cout << fmt::format( "[i] SAT calls   = {:8d}\n", num_sat_calls );
+    std::cout << fmt::format( "[i] simulation  = {:>5.2f} secs\n", to_seconds( time_simulation ) );
+    std::cout << fmt::format( "[i] sweeping    = {:>5.2f} secs ({} nodes merged)\n", to_seconds( time_reduction ), num_merged );
+    std::cout << fmt::format( "[i] SAT time    = {:>5.2f} secs\n", to_seconds( time_sat ) );
+    std::cout << fmt::format( "[i] total time  = {:>5.2f} secs\n", to_seconds( time_total ) );
+    // clang-format on
+  }
+};
+
+namespace detail
+{
+
+/* creates a sum of products (or its complement) for `function` over `children` */
+inline xag_network::signal create_function_in_xag( xag_network& dest, kitty::dynamic_truth_table const& function, std::vector<xag_network::signal> const& children )
+{
+  if ( kitty::is_const0( function ) )
+  {
+    return dest.get_constant( false );
+  }
+  if ( kitty::is_const0( ~function ) )
+  {
+    return dest.get_constant( true );
+  }
+
+  auto cubes = kitty::isop( function );
+  auto const n_cubes = kitty::isop( ~function );
+  bool const complement = n_cubes.size() < cubes.size();
+  if ( complement )
+  {
+    cubes = n_cubes;
+  }
+
+  std::vector<xag_network::signal> products;
+  std::vector<xag_network::signal> literals;
+  for ( auto const& cube : cubes )
+  {
+    literals.clear();
+    for ( auto i = 0u; i < children.size(); ++i )
+    {
+      if ( cube.get_mask( i ) )
+      {
+        literals.emplace_back( children[i] ^ !cube.get_bit( i ) );
+      }
+    }
+    products.emplace_back( dest.create_nary_and( literals ) );
+  }
+  return dest.create_nary_or( products ) ^ complement;
+}
+
+/* copies a network of arbitrary node functions (possibly with several output pins) into `dest` */
+template<class Ntk>
+std::vector<xag_network::signal> copy_functions_to_xag( Ntk const& ntk, xag_network& dest, std::vector<xag_network::signal> const& pis )
+{
+  node_map<std::vector<xag_network::signal>, Ntk> old_to_new( ntk );
+  old_to_new[ntk.get_constant( false )] = { dest.get_constant( false ) };
+  if ( ntk.get_node( ntk.get_constant( true ) ) != ntk.get_node( ntk.get_constant( false ) ) )
+  {
+    old_to_new[ntk.get_constant( true )] = { dest.get_constant( true ) };
+  }
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    old_to_new[n] = { pis[i] };
+  } );
+
+  auto const get = [&]( auto const& f ) {
+    uint32_t pin = 0u;
+    if constexpr ( has_is_multioutput_v<Ntk> )
+    {
+      pin = ntk.get_output_pin( f );
+    }
+    return old_to_new[ntk.get_node( f )][pin] ^ ntk.is_complemented( f );
+  };
+
+  topo_view topo{ ntk };
+  std::vector<xag_network::signal> children;
+  topo.foreach_node( [&]( auto const& n ) {
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+    {
+      return;
+    }
+
+    children.clear();
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      children.emplace_back( get( f ) );
+    } );
+
+    if constexpr ( has_is_multioutput_v<Ntk> )
+    {
+      std::vector<xag_network::signal> outputs;
+      for ( auto pin = 0u; pin < ntk.num_outputs( n ); ++pin )
+      {
+        outputs.emplace_back( create_function_in_xag( dest, ntk.node_function_pin( n, pin ), children ) );
+      }
+      old_to_new[n] = outputs;
+    }
+    else
+    {
+      old_to_new[n] = { create_function_in_xag( dest, ntk.node_function( n ), children ) };
+    }
+  } );
+
+  std::vector<xag_network::signal> pos;
+  ntk.foreach_po( [&]( auto const& f ) {
+    pos.emplace_back( get( f ) );
+  } );
+  return pos;
+}
+
+/* copies `ntk` into `dest` and returns the signals of its primary outputs */
+template<class Ntk>
+std::vector<xag_network::signal> copy_to_xag( Ntk const& ntk, xag_network& dest, std::vector<xag_network::signal> const& pis )
+{
+  if constexpr ( has_is_function_v<Ntk> )
+  {
+    return copy_functions_to_xag( ntk, dest, pis );
+  }
+  else
+  {
+    return cleanup_dangling( ntk, dest, pis.begin(), pis.end() );
+  }
+}
+
+/* SAT sweeping in topological order: every node is compared to the first node
+   of its simulation class and merged as soon as the pair is proven, such that
+   all later proofs are done on the already reduced network */
+class sat_sweeper
+{
+public:
+  using ntk_t = fanout_view<xag_network>;
+  using node = xag_network::node;
+  using signal = xag_network::signal;
+
+  sat_sweeper( xag_network& xag, output_equivalence_checking_params const& ps, output_equivalence_checking_stats& st )
+      : ntk( xag ), st( st ),
+        sim( xag.num_pis(), std::max( ps.num_random_patterns, 64u ), ps.random_seed ),
+        tts( ntk, sim, { false } ),
+        validator( ntk, make_validator_params( ps ) )
+  {
+  }
+
+  void run()
+  {
+    tts.simulate_all();
+    timed_out.assign( ntk.size(), false );
+
+    while ( true )
+    {
+      auto const cands = collect_candidates();
+      bool changed = false;
+      uint32_t num_cex{ 0 };
+
+      for ( auto const& [n, rep] : cands )
+      {
+        if ( ntk.is_dead( n ) || ntk.is_dead( ntk.get_node( rep ) ) )
+        {
+          continue;
+        }
+        /* counter-examples found in this round may already refute the pair */
+        auto const tt = tts[n];
+        auto const& tt_rep = tts[ntk.get_node( rep )];
+        if ( ntk.is_complemented( rep ) ? tt != ~tt_rep : tt != tt_rep )
+        {
+          continue;
+        }
+
+        auto const res = validator.validate( n, rep );
+        if ( !res )
+        {
+          timed_out[n] = true;
+        }
+        else if ( *res )
+        {
+          ntk.substitute_node( n, rep );
+          ++st.num_merged;
+          changed = true;
+        }
+        else
+        {
+          sim.add_pattern( validator.cex );
+          ++num_cex;
+        }
+      }
+
+      if ( !changed && num_cex == 0u )
+      {
+        break;
+      }
+      tts.update();
+    }
+  }
+
+private:
+  static validator_params make_validator_params( output_equivalence_checking_params const& ps )
+  {
+    validator_params vps;
+    vps.conflict_limit = ps.sweep_conflict_limit;
+    return vps;
+  }
+
+  /* pairs every gate with the first node of its class, constants and PIs come first */
+  std::vector<std::pair<node, signal>> collect_candidates()
+  {
+    std::vector<std::pair<node, signal>> cands;
+    std::unordered_map<kitty::partial_truth_table, signal, kitty::hash<kitty::partial_truth_table>> classes;
+    timed_out.resize( ntk.size(), false );
+
+    auto const add = [&]( node const& n ) {
+      auto const& tt = tts[n];
+      bool const phase = kitty::get_bit( tt, 0 );
+      auto const [it, inserted] = classes.emplace( phase ? ~tt : tt, ntk.make_signal( n ) ^ phase );
+      if ( !inserted && !timed_out[n] )
+      {
+        cands.emplace_back( n, it->second ^ phase );
+      }
+    };
+
+    add( ntk.get_node( ntk.get_constant( false ) ) );
+    ntk.foreach_pi( add );
+    ntk.foreach_gate( add );
+    return cands;
+  }
+
+private:
+  ntk_t ntk;
+  output_equivalence_checking_stats& st;
+
+  partial_simulator sim;
+  incremental_simulation<ntk_t> tts;
+  circuit_validator<ntk_t, bill::solvers::bsat2> validator;
+  std::vector<bool> timed_out;
+};
+
+class output_equivalence_checking_impl
+{
+public:
+  using node = xag_network::node;
+  using signal = xag_network::signal;
+
+  output_equivalence_checking_impl( xag_network const& ntk, std::vector<signal> const& pos1, std::vector<signal> const& pos2,
+                                    output_equivalence_checking_params const& ps, output_equivalence_checking_stats& st )
+      : ntk( ntk ), pos1( pos1 ), pos2( pos2 ), ps( ps ), st( st )
+  {
+  }
+
+  /* output pairs which are already decided in `st` are skipped */
+  std::optional<bool> run()
+  {
+    /* trivial pairs are decided by structural hashing */
+    std::vector<uint32_t> jobs;
+    for ( auto i = 0u; i < pos1.size(); ++i )
+    {
+      if ( st.output_results[i] )
+      {
+        continue;
+      }
+      if ( pos1[i] == pos2[i] )
+      {
+        ++st.num_structural;
+        st.output_results[i] = true;
+      }
+      else if ( pos1[i] == !pos2[i] )
+      {
+        /* the outputs differ under every assignment */
+        st.output_results[i] = false;
+        st.counter_examples[i].assign( ntk.num_pis(), false );
+      }
+      else
+      {
+        jobs.emplace_back( i );
+      }
+    }
+
+    /* largest cones first to balance the load of the threads */
+    std::vector<uint32_t> cone_sizes( pos1.size(), 0u );
+    {
+      cone_collector cc( ntk );
+      for ( auto i : jobs )
+      {
+        cone_sizes[i] = static_cast<uint32_t>( cc.collect( pos1[i], pos2[i] ).size() );
+      }
+    }
+    std::stable_sort( jobs.begin(), jobs.end(), [&]( auto i, auto j ) { return cone_sizes[i] > cone_sizes[j]; } );
+    st.num_sat_calls = static_cast<uint32_t>( jobs.size() );
+
+    std::atomic<uint32_t> next{ 0u };
+    std::atomic<bool> stop{ false };
+    std::vector<stopwatch<>::duration> sat_times( std::max( ps.num_threads, 1u ), stopwatch<>::duration{} );
+    auto const worker = [&]( uint32_t id ) {
+      stopwatch<> t( sat_times[id] );
+      cone_collector cc( ntk );
+      std::vector<bill::lit_type> literals( ntk.size() );
+      for ( auto j = next++; j < jobs.size() && !stop; j = next++ )
+      {
+        auto const i = jobs[j];
+        prove( cc, literals, i );
+        if ( ps.stop_at_first_cex && st.output_results[i] == false )
+        {
+          stop = true;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for ( auto id = 1u; id < ps.num_threads; ++id )
+    {
+      threads.emplace_back( worker, id );
+    }
+    worker( 0u );
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+    for ( auto const& t : sat_times )
+    {
+      st.time_sat += t;
+    }
+
+    if ( std::find( st.output_results.begin(), st.output_results.end(), std::optional<bool>( false ) ) != st.output_results.end() )
+    {
+      return false;
+    }
+    if ( std::find( st.output_results.begin(), st.output_results.end(), std::nullopt ) != st.output_results.end() )
+    {
+      return std::nullopt;
+    }
+    return true;
+  }
+
+private:
+  /* collects the union of the transitive fanin cones of two signals in topological order */
+  class cone_collector
+  {
+  public:
+    explicit cone_collector( xag_network const& ntk )
+        : ntk( ntk ), visited( ntk.size(), 0u )
+    {
+    }
+
+    std::vector<node> const& collect( signal const& a, signal const& b )
+    {
+      ++trav_id;
+      cone.clear();
+      stack.clear();
+      for ( auto const& f : { a, b } )
+      {
+        push( ntk.get_node( f ) );
+      }
+      while ( !stack.empty() )
+      {
+        auto const n = stack.back();
+        stack.pop_back();
+        cone.emplace_back( n );
+        if ( ntk.is_pi( n ) )
+        {
+          continue;
+        }
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          push( ntk.get_node( f ) );
+        } );
+      }
+      /* nodes are created in topological order */
+      std::sort( cone.begin(), cone.end() );
+      return cone;
+    }
+
+  private:
+    void push( node const& n )
+    {
+      if ( visited[n] == trav_id || ntk.is_constant( n ) )
+      {
+        return;
+      }
+      visited[n] = trav_id;
+      stack.emplace_back( n );
+    }
+
+  private:
+    xag_network const& ntk;
+    std::vector<uint32_t> visited;
+    uint32_t trav_id{ 0u };
+    std::vector<node> cone;
+    std::vector<node> stack;
+  };
+
+  /* `literals` is only valid for the nodes in the cone of output `i` */
+  void prove( cone_collector& cc, std::vector<bill::lit_type>& literals, uint32_t i )
+  {
+    auto const& cone = cc.collect( pos1[i], pos2[i] );
+
+    bill::solver<bill::solvers::bsat2> solver;
+    auto const add_clause = [&]( std::vector<bill::lit_type> const& clause ) {
+      solver.add_clause( clause );
+    };
+    auto const lit = [&]( signal const& f ) {
+      return ntk.is_constant( ntk.get_node( f ) ) ? lit_not_cond( literals[0], ntk.is_complemented( f ) )
+                                                    : lit_not_cond( literals[ntk.get_node( f )], ntk.is_complemented( f ) );
+    };
+
+    literals[0] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    solver.add_clause( { ~literals[0] } );
+
+    for ( auto const& n : cone )
+    {
+      literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+      if ( ntk.is_pi( n ) )
+      {
+        continue;
+      }
+
+      std::array<bill::lit_type, 2> fanins;
+      ntk.foreach_fanin( n, [&]( auto const& f, auto j ) {
+        fanins[j] = lit( f );
+      } );
+      if ( ntk.is_and( n ) )
+      {
+        detail::on_and( literals[n], fanins[0], fanins[1], add_clause );
+      }
+      else
+      {
+        detail::on_xor( literals[n], fanins[0], fanins[1], add_clause );
+      }
+    }
+
+    auto const miter = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    detail::on_xor( miter, lit( pos1[i] ), lit( pos2[i] ), add_clause );
+
+    auto const res = solver.solve( { miter }, ps.conflict_limit );
+    if ( res == bill::result::states::unsatisfiable )
+    {
+      st.output_results[i] = true;
+    }
+    else if ( res == bill::result::states::satisfiable )
+    {
+      auto const model = solver.get_model().model();
+      std::vector<bool> cex( ntk.num_pis(), false );
+      for ( auto const& n : cone )
+      {
+        if ( ntk.is_pi( n ) )
+        {
+          cex[ntk.pi_index( n )] = model.at( literals[n].variable() ) == bill::lbool_type::true_;
+        }
+      }
+      st.counter_examples[i] = cex;
+      st.output_results[i] = false;
+    }
+  }
+
+private:
+  xag_network const& ntk;
+  std::vector<signal> const& pos1;
+  std::vector<signal> const& pos2;
+  output_equivalence_checking_params const& ps;
+  output_equivalence_checking_stats& st;
+};
+
+} // namespace detail
+
+/*! \brief Output-partitioned combinational equivalence checking.
+ *
+ * Checks whether two networks with the same number of primary inputs and
+ * primary outputs compute the same functions, output by output.  Both
+ * networks are copied into one structurally hashed XAG, such that logic
+ * shared by the two networks is merged.  Networks with arbitrary node
+ * functions, such as mapped networks (`binding_view<klut_network>`,
+ * `cell_view<block_network>`) including multiple-output gates, are
+ * translated from the sum-of-products of their node functions.  Random
+ * simulation distinguishes most non-equivalent output pairs, and functional
+ * reduction merges equivalent internal nodes.  Then, identical outputs are
+ * proven without SAT.  Every remaining output pair is then checked with a SAT
+ * solver on the CNF of its own cone of influence only.  Output pairs are
+ * scheduled on `num_threads` threads with the largest cones first.
+ *
+ * The function returns `true` if all output pairs are equivalent, `false`
+ * if some output pair is not equivalent, and `nullopt` if neither can be
+ * decided within the resource limits or if the numbers of primary inputs or
+ * outputs do not match.  The verdict for every output pair and
+ * counter-examples (in the order of the primary inputs) for non-equivalent
+ * output pairs are written to the statistics.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      xag_network xag = ...;
+
+      output_equivalence_checking_params ps;
+      ps.num_threads = 8;
+      output_equivalence_checking_stats st;
+      auto const result = output_equivalence_checking( aig, xag, ps, &st );
+      for ( auto i = 0u; i < st.output_results.size(); ++i )
+      {
+        if ( st.output_results[i] == false )
+        {
+          // st.counter_examples[i] distinguishes output i
+        }
+      }
+   \endverbatim
+ *
+ * \param ntk1 First network
+ * \param ntk2 Second network
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk1, class Ntk2>
+std::optional<bool> output_equivalence_checking( Ntk1 const& ntk1, Ntk2 const& ntk2, output_equivalence_checking_params const& ps = {}, output_equivalence_checking_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk1>, "Ntk1 is not a network type" );
+  static_assert( is_network_type_v<Ntk2>, "Ntk2 is not a network type" );
+  static_assert( has_num_pis_v<Ntk1>, "Ntk1 does not implement the num_pis method" );
+  static_assert( has_num_pos_v<Ntk1>, "Ntk1 does not implement the num_pos method" );
+  static_assert( has_num_pis_v<Ntk2>, "Ntk2 does not implement the num_pis method" );
+  static_assert( has_num_pos_v<Ntk2>, "Ntk2 does not implement the num_pos method" );
+
+  if ( ntk1.num_pis() != ntk2.num_pis() || ntk1.num_pos() != ntk2.num_pos() )
+  {
+    std::cout << "[e] networks must have the same number of primary inputs and outputs\n";
+    return std::nullopt;
+  }
+
+  output_equivalence_checking_stats st;
+  std::optional<bool> result;
+  {
+    stopwatch<> t( st.time_total );
+
+    /* shared structurally hashed network */
+    xag_network ntk;
+    std::vector<xag_network::signal> pis;
+    for ( auto i = 0u; i < ntk1.num_pis(); ++i )
+    {
+      pis.emplace_back( ntk.create_pi() );
+    }
+    /* graph networks are copied first, such that their nodes represent the
+       equivalence classes, which keeps sum-of-products logic out of SAT calls */
+    std::vector<xag_network::signal> pos1, pos2;
+    if constexpr ( has_is_function_v<Ntk1> && !has_is_function_v<Ntk2> )
+    {
+      pos2 = detail::copy_to_xag( ntk2, ntk, pis );
+      pos1 = detail::copy_to_xag( ntk1, ntk, pis );
+    }
+    else
+    {
+      pos1 = detail::copy_to_xag( ntk1, ntk, pis );
+      pos2 = detail::copy_to_xag( ntk2, ntk, pis );
+    }
+
+    st.output_results.assign( pos1.size(), std::nullopt );
+    st.counter_examples.assign( pos1.size(), {} );
+
+    /* cheap random simulation finds most non-equivalent output pairs */
+    if ( ps.num_random_patterns > 0u )
+    {
+      stopwatch<> t_sim( st.time_simulation );
+      partial_simulator sim( ntk.num_pis(), ps.num_random_patterns, ps.random_seed );
+      auto const values = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+      auto const patterns = sim.get_patterns();
+      auto const value = [&]( auto const& f ) {
+        return ntk.is_complemented( f ) ? ~values[f] : values[f];
+      };
+      for ( auto i = 0u; i < pos1.size(); ++i )
+      {
+        auto const bit = kitty::find_first_one_bit( value( pos1[i] ) ^ value( pos2[i] ) );
+        if ( bit < 0 )
+        {
+          continue;
+        }
+        std::vector<bool> cex( ntk.num_pis() );
+        for ( auto j = 0u; j < ntk.num_pis(); ++j )
+        {
+          cex[j] = kitty::get_bit( patterns[j], bit );
+        }
+        st.counter_examples[i] = cex;
+        st.output_results[i] = false;
+        ++st.num_simulated;
+      }
+    }
+
+    if ( ps.stop_at_first_cex && st.num_simulated > 0u )
+    {
+      result = false;
+    }
+    else
+    {
+      /* merge internal equivalences shared by many outputs */
+      if ( ps.functional_reduction )
+      {
+        stopwatch<> t_red( st.time_reduction );
+        for ( auto const& f : pos1 )
+        {
+          ntk.create_po( f );
+        }
+        for ( auto const& f : pos2 )
+        {
+          ntk.create_po( f );
+        }
+
+        detail::sat_sweeper sweeper( ntk, ps, st );
+        sweeper.run();
+        ntk = cleanup_dangling( ntk );
+
+        ntk.foreach_po( [&]( auto const& f, auto i ) {
+          ( i < pos1.size() ? pos1[i] : pos2[i - pos1.size()] ) = f;
+        } );
+      }
+
+      detail::output_equivalence_checking_impl impl( ntk, pos1, pos2, ps, st );
+      result = impl.run();
+    }
+  }
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return result;
+}
+
+} /* namespace mockturtle */
@@ -0,0 +1,521 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file parallel_exact_synthesis.hpp
+  \brief Parallel portfolio front-end for exact synthesis with percy
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../utils/include/percy.hpp"
+#include "../utils/stopwatch.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for parallel_exact_synthesis.
+ *
+ * The data structure `parallel_exact_synthesis_params` holds configurable
+ * parameters with default arguments for `parallel_exact_synthesis`.
+ */
+struct parallel_exact_synthesis_params
+{
+  /*! \brief Number of threads (including the calling thread). */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Wall-clock time limit in milliseconds (0 means no limit). */
+  uint32_t time_limit{ 0u };
+
+  /*! \brief Number of chain sizes above the smallest undecided one which are tried concurrently. */
+  uint32_t max_speculation{ 2u };
+
+  /*! \brief Try each size with the single-selection-variable encoding. */
+  bool use_ssv{ true };
+
+  /*! \brief Try each size fence by fence (not used with primitives or existing functions). */
+  bool use_fences{ true };
+
+  /*! \brief Try each size partial DAG by partial DAG (fanin 2 only, not used with primitives, existing functions, or don't cares). */
+  bool use_dags{ true };
+
+  /*! \brief Largest size tried with partial DAGs, whose number grows quickly. */
+  uint32_t max_dag_steps{ 7u };
+
+  /*! \brief Number of conflicts after which a running job first checks for cancellation and the time limit.
+   *
+   * The number is doubled after every check, up to 64 times the initial value.
+   */
+  uint32_t conflicts_per_slice{ 1000u };
+};
+
+/*! \brief Statistics for parallel_exact_synthesis.
+ *
+ * The data structure `parallel_exact_synthesis_stats` provides data
+ * collected by running `parallel_exact_synthesis`.
+ */
+struct parallel_exact_synthesis_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{};
+
+  /*! \brief Number of started jobs. */
+  uint32_t num_jobs{ 0u };
+
+  /*! \brief Number of jobs cancelled after a smaller chain was found or the time limit was reached. */
+  uint32_t num_cancelled{ 0u };
+
+  /*! \brief Number of jobs which reached the conflict limit. */
+  uint32_t num_conflict_limits{ 0u };
+
+  void report() const
+  {
+    // clang-format off
+    std::cout << fmt::format( "[i] jobs        = {:8d}\n", num_jobs );
+    std::cout << fmt::format( "[i] cancelled   = {:8d}\n", num_cancelled );
+    std::cout << fmt::format( "[i] conf. limit = {:8d}\n", num_conflict_limits );
+    std::cout << fmt::format( "[i] total time  = {:>5.2f} secs\n", to_seconds( time_total ) );
+    // clang-format on
+  }
+};
+
+namespace detail
+{
+
+class parallel_exact_synthesis_impl
+{
+  enum strategy : uint8_t
+  {
+    ssv = 0,
+    fences = 1,
+    dags = 2
+  };
+
+  enum class job_result : uint8_t
+  {
+    success,
+    failure,
+    conflict_limit,
+    cancelled
+  };
+
+  struct job
+  {
+    int32_t size;
+    strategy kind;
+    uint32_t index;
+  };
+
+  /* jobs for one chain size; the size is infeasible as soon as all jobs of one strategy failed */
+  struct size_state
+  {
+    bool initialized{ false };
+    bool infeasible{ false };
+    std::vector<job> jobs;
+    uint32_t next{ 0u };
+    std::array<uint32_t, 3u> remaining{};
+    std::array<bool, 3u> incomplete{};
+    std::vector<percy::fence> fences;
+    std::vector<percy::partial_dag> dags;
+  };
+
+  using clock = std::chrono::steady_clock;
+
+public:
+  parallel_exact_synthesis_impl( percy::spec& spec, percy::chain& chain, parallel_exact_synthesis_params const& ps, parallel_exact_synthesis_stats& st )
+      : _spec( spec ),
+        _chain( chain ),
+        _ps( ps ),
+        _st( st ),
+        _lowest_open( spec.initial_steps ),
+        _sizes( std::max( spec.max_nr_steps - spec.initial_steps + 1, 0 ) )
+  {
+  }
+
+  percy::synth_result run()
+  {
+    assert( _spec.get_nr_in() >= _spec.fanin );
+    _spec.preprocess();
+
+    /* the chain consists entirely of trivial functions */
+    if ( _spec.nr_triv == _spec.get_nr_out() )
+    {
+      _chain.reset( _spec.get_nr_in(), _spec.get_nr_out(), 0, _spec.fanin );
+      for ( auto h = 0; h < _spec.get_nr_out(); ++h )
+      {
+        _chain.set_output( h, ( _spec.triv_func( h ) << 1 ) + ( ( _spec.out_inv >> h ) & 1 ) );
+      }
+      return percy::success;
+    }
+
+    bool const unrestricted = !_spec.is_primitive_set() && _spec.get_nr_compiled_functions() == 0u;
+    _enabled[ssv] = _ps.use_ssv;
+    _enabled[fences] = _ps.use_fences && unrestricted;
+    _enabled[dags] = _ps.use_dags && unrestricted && _spec.fanin == 2 && !_spec.has_dc_mask( 0 );
+    if ( !_enabled[ssv] && !_enabled[fences] && !_enabled[dags] )
+    {
+      _enabled[ssv] = true;
+    }
+
+    if ( _ps.time_limit )
+    {
+      _deadline = clock::now() + std::chrono::milliseconds( _ps.time_limit );
+    }
+
+    if ( _lowest_open > _spec.max_nr_steps )
+    {
+      return percy::failure;
+    }
+
+    std::vector<std::thread> threads;
+    for ( auto id = 1u; id < _ps.num_threads; ++id )
+    {
+      threads.emplace_back( [this]() { worker(); } );
+    }
+    worker();
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+
+    return _result;
+  }
+
+private:
+  void worker()
+  {
+    percy::bsat_wrapper solver;
+    percy::ssv_encoder ssv_enc( solver );
+    percy::ssv_fence_encoder fence_enc( solver );
+    percy::partial_dag_encoder dag_enc( solver );
+
+    percy::spec spec = _spec;
+    percy::chain chain;
+
+    while ( auto const j = next_job() )
+    {
+      spec.nr_steps = j->size;
+      solver.restart();
+
+      auto const& state = _sizes[j->size - _spec.initial_steps];
+      bool encoded{ false };
+      switch ( j->kind )
+      {
+      case ssv:
+        encoded = ssv_enc.encode( spec );
+        break;
+      case fences:
+        encoded = fence_enc.encode( spec, state.fences[j->index] );
+        break;
+      case dags:
+        encoded = dag_enc.encode( spec, state.dags[j->index] );
+        break;
+      }
+
+      auto result = encoded ? solve( solver, spec, j->size ) : job_result::failure;
+      if ( result == job_result::success )
+      {
+        switch ( j->kind )
+        {
+        case ssv:
+          ssv_enc.extract_chain( spec, chain );
+          break;
+        case fences:
+          fence_enc.extract_chain( spec, chain );
+          break;
+        case dags:
+          dag_enc.extract_chain( spec, state.dags[j->index], chain );
+          break;
+        }
+      }
+      finish_job( *j, result, chain );
+    }
+  }
+
+  /* solves in slices of conflicts to react to cancellation and to the deadline */
+  job_result solve( percy::solver_wrapper& solver, percy::spec const& spec, int32_t size )
+  {
+    int64_t slice = std::max( _ps.conflicts_per_slice, 1u );
+    int64_t const max_slice = slice << 6u;
+    int64_t num_conflicts{ 0 };
+    while ( true )
+    {
+      auto limit = slice;
+      slice = std::min( 2 * slice, max_slice ); /* every call restarts the search */
+      if ( spec.conflict_limit )
+      {
+        limit = std::min<int64_t>( limit, spec.conflict_limit - num_conflicts );
+      }
+      switch ( solver.solve( static_cast<int>( limit ) ) )
+      {
+      case percy::success:
+        return job_result::success;
+      case percy::failure:
+        return job_result::failure;
+      default:
+        break;
+      }
+      num_conflicts += limit;
+
+      if ( _stop || size >= _best || ( _deadline && clock::now() >= *_deadline ) )
+      {
+        return job_result::cancelled;
+      }
+      if ( spec.conflict_limit && num_conflicts >= spec.conflict_limit )
+      {
+        return job_result::conflict_limit;
+      }
+    }
+  }
+
+  std::optional<job> next_job()
+  {
+    std::unique_lock<std::mutex> lock( _mutex );
+    while ( !_stop )
+    {
+      if ( _deadline && clock::now() >= *_deadline )
+      {
+        decide( percy::timeout );
+        break;
+      }
+
+      /* jobs of smaller sizes first; larger sizes are tried speculatively */
+      auto const last = std::min<int64_t>( { static_cast<int64_t>( _spec.max_nr_steps ), static_cast<int64_t>( _best ) - 1, static_cast<int64_t>( _lowest_open ) + _ps.max_speculation } );
+      for ( int32_t size = _lowest_open; size <= last; ++size )
+      {
+        auto& state = size_at( size );
+        if ( state.next < state.jobs.size() )
+        {
+          ++_num_running;
+          ++_st.num_jobs;
+          return state.jobs[state.next++];
+        }
+      }
+
+      if ( _num_running == 0u )
+      {
+        /* defensive, the result is decided when the last job of a size finishes */
+        decide( percy::timeout );
+        break;
+      }
+      if ( _deadline )
+      {
+        _cv.wait_until( lock, *_deadline );
+      }
+      else
+      {
+        _cv.wait( lock );
+      }
+    }
+    return std::nullopt;
+  }
+
+  void finish_job( job const& j, job_result result, percy::chain const& chain )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    --_num_running;
+
+    auto& state = size_at( j.size );
+    --state.remaining[j.kind];
+    switch ( result )
+    {
+    case job_result::success:
+      if ( j.size < _best )
+      {
+        _best = j.size;
+        _chain = chain;
+      }
+      break;
+    case job_result::failure:
+      if ( state.remaining[j.kind] == 0u && !state.incomplete[j.kind] )
+      {
+        state.infeasible = true;
+      }
+      break;
+    case job_result::conflict_limit:
+      ++_st.num_conflict_limits;
+      state.incomplete[j.kind] = true;
+      break;
+    case job_result::cancelled:
+      ++_st.num_cancelled;
+      state.incomplete[j.kind] = true;
+      break;
+    }
+
+    while ( _lowest_open <= _spec.max_nr_steps && size_at( _lowest_open ).infeasible )
+    {
+      ++_lowest_open;
+    }
+
+    if ( _best <= _lowest_open )
+    {
+      decide( percy::success );
+    }
+    else if ( _lowest_open > _spec.max_nr_steps )
+    {
+      decide( percy::failure );
+    }
+    else if ( auto const& open = size_at( _lowest_open ); open.next == open.jobs.size() && open.remaining == std::array<uint32_t, 3u>{} )
+    {
+      /* all jobs of the smallest undecided size are done without a proof */
+      decide( percy::timeout );
+    }
+    _cv.notify_all();
+  }
+
+  void decide( percy::synth_result result )
+  {
+    if ( !_stop )
+    {
+      _result = result;
+      _stop = true;
+      _cv.notify_all();
+    }
+  }
+
+  size_state& size_at( int32_t size )
+  {
+    auto& state = _sizes[size - _spec.initial_steps];
+    if ( !state.initialized )
+    {
+      state.initialized = true;
+      if ( _enabled[ssv] )
+      {
+        state.jobs.push_back( { size, ssv, 0u } );
+        ++state.remaining[ssv];
+      }
+      if ( _enabled[fences] )
+      {
+        percy::po_filter<percy::family_generator> gen( percy::family_generator( size ), _spec.get_nr_out(), _spec.fanin );
+        percy::fence f;
+        while ( gen.next_fence( f ) )
+        {
+          state.jobs.push_back( { size, fences, static_cast<uint32_t>( state.fences.size() ) } );
+          state.fences.push_back( f );
+          ++state.remaining[fences];
+        }
+      }
+      if ( _enabled[dags] && static_cast<uint32_t>( size ) <= _ps.max_dag_steps )
+      {
+        state.dags = percy::pd_generate( size );
+        for ( auto i = 0u; i < state.dags.size(); ++i )
+        {
+          state.jobs.push_back( { size, dags, i } );
+        }
+        state.remaining[dags] = static_cast<uint32_t>( state.dags.size() );
+      }
+    }
+    return state;
+  }
+
+private:
+  percy::spec& _spec;
+  percy::chain& _chain;
+  parallel_exact_synthesis_params const& _ps;
+  parallel_exact_synthesis_stats& _st;
+
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::atomic<bool> _stop{ false };
+  std::atomic<int32_t> _best{ std::numeric_limits<int32_t>::max() };
+  percy::synth_result _result{ percy::timeout };
+  std::optional<clock::time_point> _deadline;
+  std::array<bool, 3u> _enabled{};
+  int32_t _lowest_open;
+  uint32_t _num_running{ 0u };
+  std::vector<size_state> _sizes;
+};
+
+} // namespace detail
+
+/*! \brief Parallel exact synthesis.
+ *
+ * Drop-in replacement for `percy::synthesize`, which synthesizes a chain
+ * with the minimum number of steps for `spec`.  Chain sizes are tried as
+ * independent jobs with different encodings: the single-selection-variable
+ * encoding (one job per size), fences (one job per fence), and partial DAGs
+ * (one job per DAG, fanin-2 chains only).  The jobs run on `num_threads`
+ * threads, where sizes above the smallest undecided one are tried
+ * speculatively.  A size is infeasible when all jobs of one encoding fail.
+ * Jobs of larger sizes are cancelled as soon as a chain is found, and the
+ * search stops when all smaller sizes are infeasible.
+ *
+ * The function returns `percy::timeout` if the time limit is reached, or if
+ * the conflict limit of `spec` prevents proving that no smaller chain
+ * exists.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      percy::spec spec;
+      spec.fanin = 2;
+      spec[0] = function;
+
+      parallel_exact_synthesis_params ps;
+      ps.num_threads = 4;
+      ps.time_limit = 1000; // 1 second
+
+      percy::chain chain;
+      if ( parallel_exact_synthesis( spec, chain, ps ) == percy::success )
+      {
+        chain.denormalize();
+      }
+   \endverbatim
+ */
+inline percy::synth_result parallel_exact_synthesis( percy::spec& spec, percy::chain& chain, parallel_exact_synthesis_params const& ps = {}, parallel_exact_synthesis_stats* pst = nullptr )
+{
+  parallel_exact_synthesis_stats st;
+  percy::synth_result result;
+  {
+    stopwatch<> t( st.time_total );
+    result = detail::parallel_exact_synthesis_impl( spec, chain, ps, st ).run();
+  }
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return result;
+}
+
+} /* namespace mockturtle */
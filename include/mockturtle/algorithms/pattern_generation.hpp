@@ -34,6 +34,7 @@
 #pragma once
 
 #include "../networks/aig.hpp"
+#include "../utils/pattern_bank.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "circuit_validator.hpp"
@@ -74,6 +75,13 @@ struct pattern_generation_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{ 1000 };
+
+  /*! \brief Whether to compact the patterns with a `pattern_bank` at the end.
+   *
+   * Compatible patterns are merged, and patterns which split no equivalence
+   * class of the nodes are dropped.  Afterwards, all bits are care bits.
+   */
+  bool compact_patterns{ false };
 };
 
 struct pattern_generation_stats
@@ -104,6 +112,9 @@ struct pattern_generation_stats
 
   /*! \brief Number of unobservable nodes (node for which an observable pattern can not be found). */
   uint32_t unobservable_node{ 0 };
+
+  /*! \brief Number of patterns removed by compaction. */
+  uint32_t num_compacted_patterns{ 0 };
 };
 
 namespace detail
@@ -594,6 +605,17 @@ void pattern_generation( Ntk& ntk, Simulator& sim, pattern_generation_params con
     p.run();
   }
 
+  if ( ps.compact_patterns )
+  {
+    stopwatch t( st.time_total );
+    pattern_bank bank( sim );
+    pattern_bank_params bps;
+    bps.random_seed = ps.random_seed;
+    bank.compact( ntk, bps );
+    st.num_compacted_patterns = sim.num_bits() - bank.num_patterns();
+    sim = Simulator( bank.get_patterns() );
+  }
+
   if ( pst )
   {
     *pst = st;
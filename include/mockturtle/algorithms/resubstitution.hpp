@@ -37,15 +37,21 @@
 #pragma once
 
 #include "../traits.hpp"
+#include "../utils/node_map.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/depth_view.hpp"
 #include "../views/fanout_view.hpp"
+#include "../views/topo_view.hpp"
+#include "cleanup.hpp"
 
 #include "detail/resub_utils.hpp"
 #include "dont_cares.hpp"
 #include "reconv_cut.hpp"
 
+#include <atomic>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace mockturtle
@@ -100,6 +106,9 @@ struct resubstitution_params
   /*! \brief Whether to save the appended patterns (with CEXs) into file. Only used by simulation-based resub engine. */
   std::optional<std::string> save_patterns{};
 
+  /*! \brief Whether to save the patterns in the binary pattern format instead of text. Only used by simulation-based resub engine. */
+  bool binary_patterns{ false };
+
   /*! \brief Maximum number of clauses of the SAT solver. Only used by simulation-based resub engine. */
   uint32_t max_clauses{ 1000 };
 
@@ -118,6 +127,25 @@ struct resubstitution_params
   /* k-resub engine specific */
   /*! \brief Maximum number of divisors to consider in k-resub engine. Only used by `abc_resub_functor` with simulation-based resub engine. */
   uint32_t max_divisors_k{ 50 };
+
+  /****** parallel resubstitution ******/
+
+  /*! \brief Number of threads.
+   *
+   * With more than one thread, the network is split into partitions of
+   * consecutive gates in topological order.  Every partition is copied into
+   * a separate network, in which its inputs and the nodes referenced outside
+   * of the partition are frozen as PIs and POs, and optimized independently
+   * by one of the worker threads.  The optimized partitions are then stitched
+   * together in topological order, so that the result does not depend on the
+   * scheduling of the threads.  Only used by `aig_resubstitution` and
+   * `sim_resubstitution` when called on a network (not a view), which is
+   * rebuilt in place.
+   */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Maximum number of gates in a partition. Only used by parallel resubstitution. */
+  uint32_t partition_size{ 50000u };
 };
 
 /*! \brief Statistics for resubstitution.
@@ -148,6 +176,9 @@ struct resubstitution_stats
   /*! \brief Initial network size (before resubstitution). */
   uint64_t initial_size{ 0 };
 
+  /*! \brief Number of partitions (parallel resubstitution only). */
+  uint32_t num_partitions{ 0 };
+
   void report() const
   {
     // clang-format off
@@ -778,6 +809,251 @@ private:
   std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
 };
 
+/*! \brief Parallel resubstitution on disjoint partitions.
+ *
+ * The gates of `ntk` are split into partitions of at most
+ * `ps.partition_size` consecutive gates in topological order.  For each
+ * partition, a scratch network is extracted, whose PIs are the fanins from
+ * outside of the partition and whose POs are the nodes referenced outside
+ * of the partition (by other partitions or by POs).  These boundaries are
+ * kept frozen, so the scratch networks can be optimized concurrently by
+ * `resub_fn` without synchronization.  Finally, the optimized partitions
+ * are stitched together into a new network in topological order.
+ *
+ * `Ntk` must be a network type (not a view); `resub_fn` is called as
+ * `resub_fn( scratch, ps, &st )` with `ps.num_threads` set to 1.
+ */
+template<class Ntk, class ResubFn>
+class parallel_resubstitution_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit parallel_resubstitution_impl( Ntk& ntk, resubstitution_params const& ps, resubstitution_stats& st, ResubFn const& resub_fn )
+      : ntk( ntk ), ps( ps ), st( st ), resub_fn( resub_fn )
+  {
+  }
+
+  void run()
+  {
+    stopwatch t( st.time_total );
+    st.initial_size = ntk.num_gates();
+
+    compute_partitions();
+    st.num_partitions = static_cast<uint32_t>( partitions.size() );
+
+    std::vector<Ntk> scratches( partitions.size() );
+    std::vector<resubstitution_stats> part_st( partitions.size() );
+
+    resubstitution_params part_ps = ps;
+    part_ps.num_threads = 1u;
+    part_ps.progress = false;
+    part_ps.verbose = false;
+    /* patterns are stored with respect to the PIs of the whole network */
+    part_ps.pattern_filename = std::nullopt;
+    part_ps.save_patterns = std::nullopt;
+
+    std::atomic<uint32_t> next{ 0u };
+    auto const worker = [&]() {
+      for ( auto i = next++; i < partitions.size(); i = next++ )
+      {
+        scratches[i] = extract( partitions[i] );
+        resub_fn( scratches[i], part_ps, &part_st[i] );
+        scratches[i] = cleanup_dangling( scratches[i] );
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for ( auto id = 1u; id < std::min<uint32_t>( ps.num_threads, static_cast<uint32_t>( partitions.size() ) ); ++id )
+    {
+      threads.emplace_back( worker );
+    }
+    worker();
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+
+    for ( auto const& pst : part_st )
+    {
+      st.time_divs += pst.time_divs;
+      st.time_resub += pst.time_resub;
+      st.time_callback += pst.time_callback;
+      st.num_total_divisors += pst.num_total_divisors;
+      st.estimated_gain += pst.estimated_gain;
+    }
+
+    stitch( scratches );
+  }
+
+private:
+  struct partition
+  {
+    uint32_t begin;
+    uint32_t end;
+    std::vector<node> inputs;
+    std::vector<node> outputs;
+  };
+
+  void compute_partitions()
+  {
+    topo_view<Ntk> topo{ ntk };
+    topo.foreach_gate( [&]( auto const& n ) {
+      gates.emplace_back( n );
+    } );
+
+    auto const size = std::max( ps.partition_size, 1u );
+    node_map<uint32_t, Ntk> part( ntk, UINT32_MAX );
+    node_map<uint32_t, Ntk> last_input( ntk, UINT32_MAX );
+    node_map<bool, Ntk> is_output( ntk, false );
+
+    for ( auto i = 0u; i < gates.size(); ++i )
+    {
+      auto const id = i / size;
+      if ( id == partitions.size() )
+      {
+        partitions.push_back( { i, std::min( i + size, static_cast<uint32_t>( gates.size() ) ), {}, {} } );
+      }
+      part[gates[i]] = id;
+      ntk.foreach_fanin( gates[i], [&]( auto const& f ) {
+        auto const c = ntk.get_node( f );
+        if ( ntk.is_constant( c ) || part[c] == id || last_input[c] == id )
+        {
+          return;
+        }
+        last_input[c] = id;
+        partitions[id].inputs.emplace_back( c );
+        is_output[c] = true;
+      } );
+    }
+    ntk.foreach_po( [&]( auto const& f ) {
+      is_output[f] = true;
+    } );
+
+    for ( auto& p : partitions )
+    {
+      for ( auto i = p.begin; i < p.end; ++i )
+      {
+        if ( is_output[gates[i]] )
+        {
+          p.outputs.emplace_back( gates[i] );
+        }
+      }
+    }
+  }
+
+  Ntk extract( partition const& p ) const
+  {
+    Ntk scratch;
+    std::unordered_map<node, signal> old_to_new;
+    old_to_new.reserve( p.inputs.size() + p.end - p.begin );
+    old_to_new[ntk.get_node( ntk.get_constant( false ) )] = scratch.get_constant( false );
+    for ( auto const& n : p.inputs )
+    {
+      old_to_new[n] = scratch.create_pi();
+    }
+
+    std::vector<signal> children;
+    for ( auto i = p.begin; i < p.end; ++i )
+    {
+      children.clear();
+      ntk.foreach_fanin( gates[i], [&]( auto const& f ) {
+        children.emplace_back( old_to_new.at( ntk.get_node( f ) ) ^ ntk.is_complemented( f ) );
+      } );
+      old_to_new[gates[i]] = scratch.clone_node( ntk, gates[i], children );
+    }
+
+    for ( auto const& n : p.outputs )
+    {
+      scratch.create_po( old_to_new.at( n ) );
+    }
+    return scratch;
+  }
+
+  void stitch( std::vector<Ntk>& scratches )
+  {
+    Ntk dest;
+    node_map<signal, Ntk> old_to_new( ntk );
+    old_to_new[ntk.get_constant( false )] = dest.get_constant( false );
+    if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+    {
+      old_to_new[ntk.get_constant( true )] = dest.get_constant( true );
+    }
+    ntk.foreach_pi( [&]( auto const& n ) {
+      old_to_new[n] = dest.create_pi();
+      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> && has_set_name_v<Ntk> )
+      {
+        auto const s = ntk.make_signal( n );
+        if ( ntk.has_name( s ) )
+        {
+          dest.set_name( old_to_new[n], ntk.get_name( s ) );
+        }
+      }
+    } );
+
+    std::vector<signal> leaves;
+    for ( auto i = 0u; i < partitions.size(); ++i )
+    {
+      auto const& p = partitions[i];
+      leaves.clear();
+      for ( auto const& n : p.inputs )
+      {
+        leaves.emplace_back( old_to_new[n] );
+      }
+      auto const outputs = cleanup_dangling( scratches[i], dest, leaves.begin(), leaves.end() );
+      for ( auto j = 0u; j < p.outputs.size(); ++j )
+      {
+        old_to_new[p.outputs[j]] = outputs[j];
+      }
+      scratches[i] = Ntk{};
+    }
+
+    ntk.foreach_po( [&]( auto const& f, auto i ) {
+      dest.create_po( old_to_new[f] ^ ntk.is_complemented( f ) );
+      if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> && has_set_output_name_v<Ntk> )
+      {
+        if ( ntk.has_output_name( i ) )
+        {
+          dest.set_output_name( i, ntk.get_output_name( i ) );
+        }
+      }
+    } );
+
+    ntk = dest;
+  }
+
+private:
+  Ntk& ntk;
+  resubstitution_params const& ps;
+  resubstitution_stats& st;
+  ResubFn const& resub_fn;
+
+  std::vector<node> gates;
+  std::vector<partition> partitions;
+};
+
+template<class Ntk, class ResubFn>
+void parallel_resubstitution( Ntk& ntk, resubstitution_params const& ps, resubstitution_stats* pst, ResubFn const& resub_fn )
+{
+  static_assert( std::is_same_v<Ntk, typename Ntk::base_type>, "Parallel resubstitution works on networks, not on views" );
+  static_assert( has_clone_node_v<Ntk>, "Ntk does not implement the clone_node method" );
+
+  resubstitution_stats st;
+  parallel_resubstitution_impl<Ntk, ResubFn> p( ntk, ps, st, resub_fn );
+  p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+}
+
 } /* namespace detail */
 
 /*! \brief Window-based Boolean resubstitution with default resub functor (only div0). */
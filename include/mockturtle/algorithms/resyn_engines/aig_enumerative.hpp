@@ -38,6 +38,7 @@
 
 #include "../../utils/index_list/index_list.hpp"
 #include "../../utils/null_utils.hpp"
+#include "../../utils/simd_kernels.hpp"
 #include <kitty/kitty.hpp>
 #include <optional>
 #include <vector>
@@ -204,15 +205,15 @@ public:
     std::vector<uint32_t> pos_unate, neg_unate, binate;
     for ( it = begin, i = 0u; it != end; ++it, ++i )
     {
-      if ( kitty::implies( tts[*it], target ) )
+      if ( simd::implies( tts[*it], target ) )
       {
         pos_unate.emplace_back( make_lit( i ) );
       }
-      else if ( kitty::implies( target, tts[*it] ) )
+      else if ( simd::implies( target, tts[*it] ) )
       {
         neg_unate.emplace_back( make_lit( i ) );
       }
-      else if ( kitty::implies( target, ~tts[*it] ) )
+      else if ( simd::intersection_is_empty( target, tts[*it] ) )
       {
         neg_unate.emplace_back( make_lit( i, true ) );
       }
@@ -220,7 +221,7 @@ public:
       {
         if constexpr ( !normalized )
         {
-          if ( kitty::implies( ~tts[*it], target ) )
+          if ( simd::intersection_is_empty<TT, false, false>( tts[*it], target ) )
           {
             pos_unate.emplace_back( make_lit( i, true ) );
           }
@@ -241,7 +242,8 @@ public:
     {
       for ( j = i + 1; j < pos_unate.size(); ++j )
       {
-        if ( target == ( get_tt_from_lit( pos_unate[i], tts, begin ) | get_tt_from_lit( pos_unate[j], tts, begin ) ) )
+        /* target = lit_i | lit_j, i.e., ~target = ~lit_i & ~lit_j */
+        if ( simd::and_equals( get_tt_ref_from_lit( pos_unate[i], tts, begin ), get_tt_ref_from_lit( pos_unate[j], tts, begin ), target, !( pos_unate[i] & 0x1 ), !( pos_unate[j] & 0x1 ), true ) )
         {
           il.add_output( il.add_and( pos_unate[i] ^ 0x1, pos_unate[j] ^ 0x1 ) ^ 0x1 ); // OR
           return il;
@@ -252,7 +254,7 @@ public:
     {
       for ( j = i + 1; j < neg_unate.size(); ++j )
       {
-        if ( target == ( get_tt_from_lit( neg_unate[i], tts, begin ) & get_tt_from_lit( neg_unate[j], tts, begin ) ) )
+        if ( simd::and_equals( get_tt_ref_from_lit( neg_unate[i], tts, begin ), get_tt_ref_from_lit( neg_unate[j], tts, begin ), target, neg_unate[i] & 0x1, neg_unate[j] & 0x1 ) )
         {
           il.add_output( il.add_and( neg_unate[i], neg_unate[j] ) ); // AND
           return il;
@@ -307,46 +309,49 @@ public:
       }
       for ( j = i + 1; j < binate.size(); ++j )
       {
-        auto const& tt_s0 = get_tt_from_lit( binate[i], tts, begin );
-        auto const& tt_s1 = get_tt_from_lit( binate[j], tts, begin );
+        /* binate literals are never complemented */
+        auto const& tt_s0 = get_tt_ref_from_lit( binate[i], tts, begin );
+        auto const& tt_s1 = get_tt_ref_from_lit( binate[j], tts, begin );
         if ( pos_binates.size() < 500 )
         {
-          if ( kitty::implies( tt_s0 & tt_s1, target ) )
+          /* ( s0 & s1 ) implies target */
+          if ( simd::and_is_empty( tt_s0, tt_s1, target, false, false, true ) )
           {
             pos_binates.emplace_back( std::make_pair( binate[i], binate[j] ) );
           }
-          if ( kitty::implies( ~tt_s0 & tt_s1, target ) )
+          if ( simd::and_is_empty( tt_s0, tt_s1, target, true, false, true ) )
           {
             pos_binates.emplace_back( std::make_pair( binate[i] ^ 0x1, binate[j] ) );
           }
 
-          if ( kitty::implies( tt_s0 & ~tt_s1, target ) )
+          if ( simd::and_is_empty( tt_s0, tt_s1, target, false, true, true ) )
           {
             pos_binates.emplace_back( std::make_pair( binate[i], binate[j] ^ 0x1 ) );
           }
 
-          if ( kitty::implies( ~tt_s0 & ~tt_s1, target ) )
+          if ( simd::and_is_empty( tt_s0, tt_s1, target, true, true, true ) )
           {
             pos_binates.emplace_back( std::make_pair( binate[i] ^ 0x1, binate[j] ^ 0x1 ) );
           }
         }
         if ( neg_binates.size() < 500 )
         {
-          if ( kitty::implies( target, tt_s0 | tt_s1 ) )
+          /* target implies ( s0 | s1 ) */
+          if ( simd::and_is_empty( tt_s0, tt_s1, target, true, true, false ) )
           {
             neg_binates.emplace_back( std::make_pair( binate[i], binate[j] ) );
           }
-          if ( kitty::implies( target, ~tt_s0 | tt_s1 ) )
+          if ( simd::and_is_empty( tt_s0, tt_s1, target, false, true, false ) )
           {
             neg_binates.emplace_back( std::make_pair( binate[i] ^ 0x1, binate[j] ) );
           }
 
-          if ( kitty::implies( target, tt_s0 | ~tt_s1 ) )
+          if ( simd::and_is_empty( tt_s0, tt_s1, target, true, false, false ) )
           {
             neg_binates.emplace_back( std::make_pair( binate[i], binate[j] ^ 0x1 ) );
           }
 
-          if ( kitty::implies( target, ~tt_s0 | ~tt_s1 ) )
+          if ( simd::and_is_empty( tt_s0, tt_s1, target, false, false, false ) )
           {
             neg_binates.emplace_back( std::make_pair( binate[i] ^ 0x1, binate[j] ^ 0x1 ) );
           }
@@ -465,6 +470,13 @@ private:
     return ( lit % 2 ) ? ~tts[*( begin + ( lit / 2 ) - 1 )] : tts[*( begin + ( lit / 2 ) - 1 )];
   }
 
+  /* returns the truth table of the divisor of `lit`, ignoring its complementation */
+  template<class truth_table_storage_type, class iterator_type>
+  TT const& get_tt_ref_from_lit( uint32_t const& lit, truth_table_storage_type const& tts, iterator_type const& begin )
+  {
+    return tts[*( begin + ( lit / 2 ) - 1 )];
+  }
+
 private:
   stats& st;
 }; /* aig_enumerative_resyn */
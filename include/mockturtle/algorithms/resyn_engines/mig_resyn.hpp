@@ -33,6 +33,7 @@
 #pragma once
 
 #include "../../utils/index_list/index_list.hpp"
+#include "../../utils/simd_kernels.hpp"
 
 #include <fmt/format.h>
 #include <kitty/kitty.hpp>
@@ -127,7 +128,7 @@ private:
     max_i = 0u;
     for ( auto i = 0u; i < divisors.size(); ++i )
     {
-      uint32_t score = kitty::count_ones( divisors.at( i ) );
+      uint32_t score = simd::count_ones( divisors.at( i ) );
       if ( score > max_score )
       {
         max_score = score;
@@ -169,11 +170,9 @@ private:
     /* the second fanin: 2 * #newly-covered-bits + 1 * #cover-again-bits */
     uint64_t max_score = 0u;
     max_j = 0u;
-    auto const not_covered_by_i = ~function_i;
     for ( auto j = 0u; j < divisors.size(); ++j )
     {
-      auto const covered_by_j = divisors.at( j );
-      uint32_t score = kitty::count_ones( covered_by_j ) + kitty::count_ones( not_covered_by_i & covered_by_j );
+      uint32_t score = simd::count_ones( divisors.at( j ) ) + simd::count_ones_intersection<TT, false, true>( function_i, divisors.at( j ) );
       if ( score > max_score && ( j >> 1 ) != ( max_i >> 1 ) )
       {
         max_score = score;
@@ -188,7 +187,7 @@ private:
     auto const disagree_in_ij = function_i ^ divisors.at( max_j );
     for ( auto k = 0u; k < divisors.size(); ++k )
     {
-      uint32_t score = kitty::count_ones( divisors.at( k ) & disagree_in_ij );
+      uint32_t score = simd::count_ones_intersection( divisors.at( k ), disagree_in_ij );
       if ( score > max_score && ( k >> 1 ) != ( max_i >> 1 ) && ( k >> 1 ) != ( max_j >> 1 ) )
       {
         max_score = score;
@@ -587,7 +586,7 @@ private:
     uint32_t max_i = 0u;
     for ( auto i = 0u; i < divisors.size(); ++i )
     {
-      scores.at( i ) = kitty::count_ones( divisors.at( i ) & care );
+      scores.at( i ) = simd::count_ones_intersection( divisors.at( i ), care );
       if ( scores.at( i ) > max_score )
       {
         max_score = scores.at( i );
@@ -602,7 +601,7 @@ private:
     for ( auto j = 0u; j < divisors.size(); ++j )
     {
       auto const covered_by_j = divisors.at( j ) & care;
-      scores.at( j ) = kitty::count_ones( covered_by_j ) + kitty::count_ones( not_covered_by_i & covered_by_j );
+      scores.at( j ) = simd::count_ones( covered_by_j ) + simd::count_ones_intersection( not_covered_by_i, covered_by_j );
       if ( scores.at( j ) > max_score && !same_divisor( j, max_i ) )
       {
         max_score = scores.at( j );
@@ -617,7 +616,7 @@ private:
     for ( auto k = 0u; k < divisors.size(); ++k )
     {
       auto const covered_by_k = divisors.at( k ) & care;
-      scores.at( k ) = kitty::count_ones( covered_by_k & not_covered_by_i ) + kitty::count_ones( covered_by_k & not_covered_by_j );
+      scores.at( k ) = simd::count_ones_intersection( covered_by_k, not_covered_by_i ) + simd::count_ones_intersection( covered_by_k, not_covered_by_j );
       if ( scores.at( k ) > max_score && !same_divisor( k, max_i ) && !same_divisor( k, max_j ) )
       {
         max_score = scores.at( k );
@@ -637,7 +636,7 @@ private:
     uint64_t max_score = 0u;
     for ( auto i = 0u; i < divisors.size(); ++i )
     {
-      scores.at( i ) = kitty::count_ones( divisors.at( i ) & care );
+      scores.at( i ) = simd::count_ones_intersection( divisors.at( i ), care );
       if ( scores.at( i ) > max_score )
       {
         max_score = scores.at( i );
@@ -664,7 +663,7 @@ private:
     for ( auto j = 0u; j < divisors.size(); ++j )
     {
       auto const covered_by_j = divisors.at( j ) & care;
-      scores.at( j ) = kitty::count_ones( covered_by_j ) + kitty::count_ones( not_covered_by_i & covered_by_j );
+      scores.at( j ) = simd::count_ones( covered_by_j ) + simd::count_ones_intersection( not_covered_by_i, covered_by_j );
       if ( scores.at( j ) > max_score && !same_divisor( j, max_i ) )
       {
         max_score = scores.at( j );
@@ -692,7 +691,7 @@ private:
     for ( auto k = 0u; k < divisors.size(); ++k )
     {
       auto const covered_by_k = divisors.at( k ) & care;
-      scores.at( k ) = kitty::count_ones( covered_by_k & not_covered_by_i ) + kitty::count_ones( covered_by_k & not_covered_by_j );
+      scores.at( k ) = simd::count_ones_intersection( covered_by_k, not_covered_by_i ) + simd::count_ones_intersection( covered_by_k, not_covered_by_j );
       if ( scores.at( k ) > max_score && !same_divisor( k, max_i ) && !same_divisor( k, max_j ) )
       {
         max_score = scores.at( k );
@@ -704,7 +703,7 @@ private:
       if ( scores.at( k ) == max_score && !same_divisor( k, max_i ) && !same_divisor( k, max_j ) )
       {
         TT const func = kitty::ternary_majority( divisors.at( max_i ), divisors.at( max_j ), divisors.at( k ) );
-        if ( kitty::is_const0( ~func & care ) )
+        if ( simd::intersection_is_empty<TT, false, true>( func, care ) )
         {
           res.clear();
           res.emplace_back( simple_maj( { { max_i, max_j, k }, func } ) );
@@ -784,7 +783,7 @@ private:
 
   bool fulfilled( TT const& func, TT const& care )
   {
-    return kitty::is_const0( ~func & care );
+    return simd::intersection_is_empty<TT, false, true>( func, care );
   }
 
   bool node_fulfilled( maj_node const& node )
@@ -794,7 +793,7 @@ private:
 
   uint64_t score( TT const& func, TT const& care )
   {
-    return kitty::count_ones( func & care );
+    return simd::count_ones_intersection( func, care );
   }
 
   void update_fanin( maj_node& parent_node, uint32_t const fi, uint32_t const new_id, TT const& new_function )
@@ -35,6 +35,7 @@
 
 #include "../../utils/index_list/index_list.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/simd_kernels.hpp"
 #include "../../utils/stopwatch.hpp"
 
 #include <fmt/format.h>
@@ -285,6 +286,45 @@ public:
     return compute_function( max_size );
   }
 
+  /*! \brief Perform XAG resynthesis for several targets sharing the same divisors.
+   *
+   * Equivalent to calling the single-target interface for each target, but
+   * the divisors are collected once and are classified against all the
+   * targets in a single scan over their truth tables.
+   *
+   * \param targets Truth tables of the target functions.
+   * \param care Truth table of the care set (shared by all targets).
+   * \param begin Begin iterator to divisor nodes.
+   * \param end End iterator to divisor nodes.
+   * \param tts A data structure (e.g. std::vector<TT>) that stores the truth tables of the divisor functions.
+   * \param max_sizes Maximum number of nodes allowed in the dependency circuit of each target (no limit if empty).
+   * \return One result per target, in the same order.
+   */
+  template<class iterator_type,
+           bool enabled = static_params::uniform_div_cost && !static_params::preserve_depth, typename = std::enable_if_t<enabled>>
+  std::vector<std::optional<index_list_t>> operator()( std::vector<TT> const& targets, TT const& care, iterator_type begin, iterator_type end, typename static_params::truth_table_storage_type const& tts, std::vector<uint32_t> const& max_sizes = {} )
+  {
+    static_assert( static_params::copy_tts || std::is_same_v<typename std::iterator_traits<iterator_type>::value_type, typename static_params::node_type>, "iterator_type does not dereference to static_params::node_type" );
+    assert( max_sizes.empty() || max_sizes.size() == targets.size() );
+
+    ptts = &tts;
+    divisors.resize( 1 ); /* clear previous data and reserve 1 dummy node for constant */
+    while ( begin != end )
+    {
+      if constexpr ( static_params::copy_tts )
+      {
+        divisors.emplace_back( ( *ptts )[*begin] );
+      }
+      else
+      {
+        divisors.emplace_back( *begin );
+      }
+      ++begin;
+    }
+
+    return compute_functions( targets, care, max_sizes );
+  }
+
   template<class iterator_type, class Fn,
            bool enabled = !static_params::uniform_div_cost && !static_params::preserve_depth, typename = std::enable_if_t<enabled>>
   std::optional<index_list_t> operator()( TT const& target, TT const& care, iterator_type begin, iterator_type end, typename static_params::truth_table_storage_type const& tts, Fn&& size_cost, uint32_t max_size = std::numeric_limits<uint32_t>::max() )
@@ -310,6 +350,67 @@ private:
     return std::nullopt;
   }
 
+  std::vector<std::optional<index_list_t>> compute_functions( std::vector<TT> const& targets, TT const& care, std::vector<uint32_t> const& max_sizes )
+  {
+    /* try 0-resub and collect the unate literals of all targets in one scan over the divisors */
+    std::vector<batch_state> states( targets.size() );
+    call_with_stopwatch( st.time_unate, [&]() {
+      for ( auto i = 0u; i < targets.size(); ++i )
+      {
+        auto& s = states[i];
+        s.on_off_sets[0] = ~targets[i] & care;
+        s.on_off_sets[1] = targets[i] & care;
+        s.num_bits[0] = simd::count_ones( s.on_off_sets[0] ); /* off-set */
+        s.num_bits[1] = simd::count_ones( s.on_off_sets[1] ); /* on-set */
+        if ( s.num_bits[0] == 0 )
+        {
+          s.res0 = 1;
+        }
+        else if ( s.num_bits[1] == 0 )
+        {
+          s.res0 = 0;
+        }
+      }
+
+      for ( auto v = 1u; v < divisors.size(); ++v )
+      {
+        for ( auto& s : states )
+        {
+          if ( !s.res0 )
+          {
+            s.res0 = classify_divisor( v, s.on_off_sets, s.pos_unate_lits, s.neg_unate_lits, s.binate_divs );
+          }
+        }
+      }
+    } );
+
+    std::vector<std::optional<index_list_t>> results( targets.size() );
+    for ( auto i = 0u; i < targets.size(); ++i )
+    {
+      auto& s = states[i];
+      auto const num_inserts = max_sizes.empty() ? std::numeric_limits<uint32_t>::max() : max_sizes[i];
+
+      on_off_sets = s.on_off_sets;
+      num_bits = s.num_bits;
+      pos_unate_lits.swap( s.pos_unate_lits );
+      neg_unate_lits.swap( s.neg_unate_lits );
+      binate_divs.swap( s.binate_divs );
+      pos_unate_pairs.clear();
+      neg_unate_pairs.clear();
+
+      index_list.clear();
+      index_list.add_inputs( divisors.size() - 1 );
+      auto const lit = s.res0 ? s.res0 : compute_function_from_unates( num_inserts );
+      if ( lit )
+      {
+        assert( index_list.num_gates() <= num_inserts );
+        index_list.add_output( *lit );
+        results[i] = index_list;
+      }
+    }
+    return results;
+  }
+
   std::optional<uint32_t> compute_function_rec( uint32_t num_inserts )
   {
     pos_unate_lits.clear();
@@ -326,6 +427,12 @@ private:
     {
       return *res0;
     }
+    return compute_function_from_unates( num_inserts );
+  }
+
+  /* continue the decomposition once the unate literals and the binate divisors are collected */
+  std::optional<uint32_t> compute_function_from_unates( uint32_t num_inserts )
+  {
     if ( num_inserts == 0u )
     {
       return std::nullopt;
@@ -519,8 +626,8 @@ private:
    */
   std::optional<uint32_t> find_one_unate()
   {
-    num_bits[0] = kitty::count_ones( on_off_sets[0] ); /* off-set */
-    num_bits[1] = kitty::count_ones( on_off_sets[1] ); /* on-set */
+    num_bits[0] = simd::count_ones( on_off_sets[0] ); /* off-set */
+    num_bits[1] = simd::count_ones( on_off_sets[1] ); /* on-set */
     if ( num_bits[0] == 0 )
     {
       return 1;
@@ -532,51 +639,62 @@ private:
 
     for ( auto v = 1u; v < divisors.size(); ++v )
     {
-      bool unateness[4] = { false, false, false, false };
-      /* check intersection with off-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[0] ) )
-      {
-        pos_unate_lits.emplace_back( v << 1 );
-        unateness[0] = true;
-      }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[0] ) )
+      if ( auto const res = classify_divisor( v, on_off_sets, pos_unate_lits, neg_unate_lits, binate_divs ) )
       {
-        pos_unate_lits.emplace_back( v << 1 | 0x1 );
-        unateness[1] = true;
+        return res;
       }
+    }
+    return std::nullopt;
+  }
 
-      /* check intersection with on-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[1] ) )
-      {
-        neg_unate_lits.emplace_back( v << 1 );
-        unateness[2] = true;
-      }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[1] ) )
-      {
-        neg_unate_lits.emplace_back( v << 1 | 0x1 );
-        unateness[3] = true;
-      }
+  /* Classify divisor `v` against the given on-set and off-set: return the literal if it is a
+     0-resub, otherwise append it to the unate literals or to the binate divisors. */
+  std::optional<uint32_t> classify_divisor( uint32_t v, std::array<TT, 2> const& sets, std::vector<unate_lit>& pos_lits, std::vector<unate_lit>& neg_lits, std::vector<uint32_t>& binates ) const
+  {
+    bool unateness[4] = { false, false, false, false };
+    /* check intersection with off-set */
+    if ( simd::intersection_is_empty<TT, 1, 1>( get_div( v ), sets[0] ) )
+    {
+      pos_lits.emplace_back( v << 1 );
+      unateness[0] = true;
+    }
+    else if ( simd::intersection_is_empty<TT, 0, 1>( get_div( v ), sets[0] ) )
+    {
+      pos_lits.emplace_back( v << 1 | 0x1 );
+      unateness[1] = true;
+    }
 
-      /* 0-resub */
-      if ( unateness[0] && unateness[3] )
-      {
-        return ( v << 1 );
-      }
-      if ( unateness[1] && unateness[2] )
-      {
-        return ( v << 1 ) + 1;
-      }
-      /* useless unate literal */
-      if ( ( unateness[0] && unateness[2] ) || ( unateness[1] && unateness[3] ) )
-      {
-        pos_unate_lits.pop_back();
-        neg_unate_lits.pop_back();
-      }
-      /* binate divisor */
-      else if ( !unateness[0] && !unateness[1] && !unateness[2] && !unateness[3] )
-      {
-        binate_divs.emplace_back( v );
-      }
+    /* check intersection with on-set */
+    if ( simd::intersection_is_empty<TT, 1, 1>( get_div( v ), sets[1] ) )
+    {
+      neg_lits.emplace_back( v << 1 );
+      unateness[2] = true;
+    }
+    else if ( simd::intersection_is_empty<TT, 0, 1>( get_div( v ), sets[1] ) )
+    {
+      neg_lits.emplace_back( v << 1 | 0x1 );
+      unateness[3] = true;
+    }
+
+    /* 0-resub */
+    if ( unateness[0] && unateness[3] )
+    {
+      return ( v << 1 );
+    }
+    if ( unateness[1] && unateness[2] )
+    {
+      return ( v << 1 ) + 1;
+    }
+    /* useless unate literal */
+    if ( ( unateness[0] && unateness[2] ) || ( unateness[1] && unateness[3] ) )
+    {
+      pos_lits.pop_back();
+      neg_lits.pop_back();
+    }
+    /* binate divisor */
+    else if ( !unateness[0] && !unateness[1] && !unateness[2] && !unateness[3] )
+    {
+      binates.emplace_back( v );
     }
     return std::nullopt;
   }
@@ -589,7 +707,7 @@ private:
   {
     for ( auto& l : unate_lits )
     {
-      l.score = kitty::count_ones( ( l.lit & 0x1 ? ~get_div( l.lit >> 1 ) : get_div( l.lit >> 1 ) ) & on_off_sets[on_off] );
+      l.score = simd::count_ones_and( get_div( l.lit >> 1 ), on_off_sets[on_off], l.lit & 0x1, false );
     }
     std::stable_sort( unate_lits.begin(), unate_lits.end(), [&]( unate_lit const& l1, unate_lit const& l2 ) {
       return l1.score > l2.score; // descending order
@@ -635,9 +753,7 @@ private:
         {
           break;
         }
-        auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
-        auto const ntt2 = lit2 & 0x1 ? get_div( lit2 >> 1 ) : ~get_div( lit2 >> 1 );
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( simd::and_is_empty( get_div( lit1 >> 1 ), get_div( lit2 >> 1 ), on_off_sets[on_off], !( lit1 & 0x1 ), !( lit2 & 0x1 ), false ) )
         {
           auto const new_lit = index_list.add_and( ( lit1 ^ 0x1 ), ( lit2 ^ 0x1 ) );
           return new_lit + on_off;
@@ -677,7 +793,7 @@ private:
           ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
         }
 
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( simd::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
         {
           uint32_t new_lit1;
           if constexpr ( static_params::use_xor )
@@ -745,7 +861,7 @@ private:
           ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
         }
 
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( simd::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
         {
           uint32_t fanin_lit1, fanin_lit2;
           if constexpr ( static_params::use_xor )
@@ -783,31 +899,32 @@ private:
   std::optional<uint32_t> find_xor()
   {
     /* collect XOR-type pairs (d1 ^ d2) & off = 0 or ~(d1 ^ d2) & on = 0, selecting d1, d2 from binate_divs */
+    TT tt_xor = on_off_sets[0].construct();
     for ( auto i = 0u; i < binate_divs.size(); ++i )
     {
       for ( auto j = i + 1; j < binate_divs.size(); ++j )
       {
-        auto const tt_xor = get_div( binate_divs[i] ) ^ get_div( binate_divs[j] );
+        simd::binary_xor( tt_xor, get_div( binate_divs[i] ), get_div( binate_divs[j] ) );
         bool unateness[4] = { false, false, false, false };
         /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) )
+        if ( simd::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) && !simd::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) )
         {
           pos_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[0] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) )
+        if ( simd::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) && !simd::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) )
         {
           pos_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[1] = true;
         }
 
         /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) )
+        if ( simd::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) && !simd::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) )
         {
           neg_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[2] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) )
+        if ( simd::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) && !simd::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) )
         {
           neg_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[3] = true;
@@ -846,12 +963,12 @@ private:
   void collect_unate_pairs_detail( uint32_t div1, uint32_t div2 )
   {
     /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-    if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) )
+    if ( simd::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) && !simd::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) )
     {
       pos_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
     }
     /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-    else if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) )
+    else if ( simd::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) && !simd::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) )
     {
       neg_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
     }
@@ -870,6 +987,16 @@ private:
   }
 
 private:
+  /* per-target data of the batched interface */
+  struct batch_state
+  {
+    std::array<TT, 2> on_off_sets;
+    std::array<uint32_t, 2> num_bits;
+    std::vector<unate_lit> pos_unate_lits, neg_unate_lits;
+    std::vector<uint32_t> binate_divs;
+    std::optional<uint32_t> res0;
+  };
+
   std::array<TT, 2> on_off_sets;
   std::array<uint32_t, 2> num_bits; /* number of bits in on-set and off-set */
 
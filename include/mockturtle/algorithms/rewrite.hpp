@@ -35,6 +35,7 @@
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/npn_canonization_cache.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/color_view.hpp"
 #include "../views/depth_view.hpp"
@@ -218,7 +219,7 @@ private:
         }
 
         /* Boolean matching */
-        auto config = kitty::exact_npn_canonization( cuts.truth_table( *cut ) );
+        auto config = npn_cache( cuts.truth_table( *cut ) );
         auto tt_npn = std::get<0>( config );
         auto neg = std::get<1>( config );
         auto perm = std::get<2>( config );
@@ -410,7 +411,7 @@ private:
         }
 
         /* Boolean matching */
-        auto config = kitty::exact_npn_canonization( cuts.truth_table( *cut ) );
+        auto config = npn_cache( cuts.truth_table( *cut ) );
         auto tt_npn = std::get<0>( config );
         auto neg = std::get<1>( config );
         auto perm = std::get<2>( config );
@@ -865,6 +866,7 @@ private:
   NodeCostFn cost_fn;
 
   node_map<uint32_t, Ntk> required;
+  npn_canonization_cache<kitty::static_truth_table<num_vars>> npn_cache;
 
   uint32_t _candidates{ 0 };
   uint32_t _estimated_gain{ 0 };
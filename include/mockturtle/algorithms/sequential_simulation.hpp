@@ -0,0 +1,351 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file sequential_simulation.hpp
+  \brief Bit-parallel multi-cycle simulation of sequential networks
+*/
+
+#pragma once
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/simd_kernels.hpp"
+
+#include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace mockturtle
+{
+
+struct sequential_simulation_params
+{
+  /*! \brief Number of independent traces simulated in parallel. */
+  uint32_t num_traces{ 256u };
+
+  /*! \brief Seed for random input stimuli and unknown initial values. */
+  uint64_t random_seed{ 1u };
+
+  /*! \brief Record the values of the primary outputs in every cycle. */
+  bool record_outputs{ true };
+
+  /*! \brief Count the toggles of every node between consecutive cycles. */
+  bool count_toggles{ false };
+};
+
+/*! \brief Bit-parallel multi-cycle simulator for sequential networks.
+ *
+ * Simulates `num_traces` independent traces of a sequential network in
+ * parallel, where the value of a node in one cycle is a partial truth table
+ * with one bit per trace.  In each cycle, register outputs hold the current
+ * state, primary inputs are assigned (random or given) stimuli, and the
+ * values at the register inputs become the state of the next cycle.
+ *
+ * The initial state of register `i` is taken from `register_at( i ).init`:
+ * 0 and 1 are reset values, all other values denote an unknown initial
+ * value, which is chosen randomly for every trace.  Alternatively, an
+ * initial state can be given for every trace with `set_initial_state`.
+ *
+ * Simulation can be continued at any time (incremental unrolling), e.g.,
+ * until the output signatures of two networks differ.  The signatures of
+ * the primary outputs of every cycle are recorded, and toggles of every
+ * node can be counted to estimate switching activity.
+ *
+ * Random input stimuli only depend on the seed and the number of primary
+ * inputs.  Hence, two networks with the same primary inputs (e.g., before
+ * and after retiming) are simulated with the same input sequences when
+ * using the same parameters, and their output signatures can be compared.
+ *
+ * **Required network functions:**
+ * - `foreach_pi`
+ * - `foreach_ro`
+ * - `foreach_ri`
+ * - `foreach_po`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `register_at`
+ * - `compute` for `kitty::partial_truth_table`
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      sequential<aig_network> aig = ...;
+
+      sequential_simulation_params ps;
+      ps.num_traces = 1024;
+      ps.count_toggles = true;
+      sequential_simulation<sequential<aig_network>> sim( aig, ps );
+
+      sim.run( 100 );
+      auto const& sigs = sim.output_signatures( 99 );
+      auto const activity = sim.switching_activity( n );
+   \endverbatim
+ */
+template<class Ntk>
+class sequential_simulation
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using TT = kitty::partial_truth_table;
+
+  explicit sequential_simulation( Ntk const& ntk, sequential_simulation_params const& ps = {} )
+      : ntk( ntk ), ps( ps ), values( ntk ), toggles( ntk, 0u ), scratch( ps.num_traces )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_ro_v<Ntk>, "Ntk does not implement the foreach_ro method" );
+    static_assert( has_foreach_ri_v<Ntk>, "Ntk does not implement the foreach_ri method" );
+    static_assert( has_num_registers_v<Ntk>, "Ntk does not implement the num_registers method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute specialization for kitty::partial_truth_table" );
+    assert( ps.num_traces > 0u );
+
+    reset();
+  }
+
+  /*! \brief Restarts simulation from the initial state. */
+  void reset()
+  {
+    cycle = 0u;
+    outputs.clear();
+    toggles.reset( 0u );
+    input_rng.seed( ps.random_seed );
+    state_rng.seed( ps.random_seed + 1u );
+
+    if ( !initial_state.empty() )
+    {
+      state = initial_state;
+      return;
+    }
+
+    state.resize( ntk.num_registers() );
+    for ( auto i = 0u; i < ntk.num_registers(); ++i )
+    {
+      auto const init = ntk.register_at( i ).init;
+      state[i] = init <= 1u ? constant( init == 1u ) : random_value( state_rng );
+    }
+  }
+
+  /*! \brief Sets the initial state of every register and every trace.
+   *
+   * Bit `t` of `state[i]` is the initial value of register `i` in trace `t`.
+   * The simulation restarts from this state.
+   */
+  void set_initial_state( std::vector<TT> const& state_ )
+  {
+    assert( state_.size() == ntk.num_registers() );
+    assert( std::all_of( state_.begin(), state_.end(), [&]( auto const& tt ) { return tt.num_bits() == ps.num_traces; } ) );
+    initial_state = state_;
+    reset();
+  }
+
+  /*! \brief Simulates one cycle with random input stimuli. */
+  void step()
+  {
+    ntk.foreach_pi( [&]( auto const& n ) {
+      update( n, random_value( input_rng ) );
+    } );
+    simulate_cycle();
+  }
+
+  /*! \brief Simulates one cycle with given input stimuli.
+   *
+   * Bit `t` of `pi_values[i]` is the value of primary input `i` in trace `t`.
+   */
+  void step( std::vector<TT> const& pi_values )
+  {
+    assert( pi_values.size() == ntk.num_pis() );
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      assert( pi_values[i].num_bits() == ps.num_traces );
+      update( n, pi_values[i] );
+    } );
+    simulate_cycle();
+  }
+
+  /*! \brief Simulates `num_cycles` further cycles with random input stimuli. */
+  void run( uint32_t num_cycles )
+  {
+    for ( auto i = 0u; i < num_cycles; ++i )
+    {
+      step();
+    }
+  }
+
+  /*! \brief Number of simulated cycles since the last reset. */
+  uint32_t num_cycles() const
+  {
+    return cycle;
+  }
+
+  /*! \brief Returns the value of `n` in the last simulated cycle. */
+  TT const& operator[]( node const& n ) const
+  {
+    assert( cycle > 0u );
+    return values[n];
+  }
+
+  /*! \brief Returns the value of `f` in the last simulated cycle. */
+  TT value( signal const& f ) const
+  {
+    return ntk.is_complemented( f ) ? ~values[f] : values[f];
+  }
+
+  /*! \brief Returns the register values at the beginning of the next cycle. */
+  std::vector<TT> const& current_state() const
+  {
+    return state;
+  }
+
+  /*! \brief Returns the values of the primary outputs in cycle `c` (starting from 0). */
+  std::vector<TT> const& output_signatures( uint32_t c ) const
+  {
+    assert( ps.record_outputs && c < outputs.size() );
+    return outputs[c];
+  }
+
+  /*! \brief Returns the number of toggles of `n` summed over all traces. */
+  uint64_t num_toggles( node const& n ) const
+  {
+    assert( ps.count_toggles );
+    return toggles[n];
+  }
+
+  /*! \brief Returns the fraction of cycle transitions in which `n` toggles. */
+  double switching_activity( node const& n ) const
+  {
+    assert( ps.count_toggles );
+    if ( cycle < 2u )
+    {
+      return 0.0;
+    }
+    return static_cast<double>( toggles[n] ) / ( static_cast<double>( ps.num_traces ) * ( cycle - 1u ) );
+  }
+
+private:
+  void simulate_cycle()
+  {
+    /* constants and register outputs */
+    values[ntk.get_constant( false )] = constant( ntk.constant_value( ntk.get_node( ntk.get_constant( false ) ) ) );
+    if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+    {
+      values[ntk.get_constant( true )] = constant( ntk.constant_value( ntk.get_node( ntk.get_constant( true ) ) ) );
+    }
+    ntk.foreach_ro( [&]( auto const& n, auto i ) {
+      update( n, state[i] );
+    } );
+
+    /* gates */
+    ntk.foreach_gate( [&]( auto const& n ) {
+      auto num_fanins = 0u;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fanin_value( num_fanins++ ) = values[f];
+      } );
+      update( n, ntk.compute( n, fanin_values.begin(), fanin_values.begin() + num_fanins ) );
+    } );
+
+    /* primary outputs and next state */
+    if ( ps.record_outputs )
+    {
+      auto& pos = outputs.emplace_back();
+      pos.reserve( ntk.num_pos() );
+      ntk.foreach_po( [&]( auto const& f ) {
+        pos.emplace_back( value( f ) );
+      } );
+    }
+    ntk.foreach_ri( [&]( auto const& f, auto i ) {
+      state[i] = value( f );
+    } );
+
+    ++cycle;
+  }
+
+  void update( node const& n, TT const& tt )
+  {
+    if ( ps.count_toggles && cycle > 0u )
+    {
+      simd::binary_xor( scratch, values[n], tt, false, false );
+      toggles[n] += simd::count_ones( scratch );
+    }
+    values[n] = tt;
+  }
+
+  TT constant( bool value ) const
+  {
+    TT tt( ps.num_traces );
+    return value ? ~tt : tt;
+  }
+
+  TT random_value( std::mt19937_64& rng ) const
+  {
+    TT tt( ps.num_traces );
+    std::generate( tt._bits.begin(), tt._bits.end(), [&]() { return rng(); } );
+    tt.mask_bits();
+    return tt;
+  }
+
+  /* reuses the buffers of fanin values to avoid reallocations */
+  TT& fanin_value( uint32_t i )
+  {
+    if ( i == fanin_values.size() )
+    {
+      fanin_values.emplace_back();
+    }
+    return fanin_values[i];
+  }
+
+private:
+  Ntk const& ntk;
+  sequential_simulation_params const ps;
+
+  node_map<TT, Ntk> values;
+  node_map<uint64_t, Ntk> toggles;
+  std::vector<TT> state;
+  std::vector<TT> initial_state;
+  std::vector<std::vector<TT>> outputs;
+  uint32_t cycle{ 0u };
+
+  std::mt19937_64 input_rng;
+  std::mt19937_64 state_rng;
+  std::vector<TT> fanin_values;
+  TT scratch;
+};
+
+} // namespace mockturtle
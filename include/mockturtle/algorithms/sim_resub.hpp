@@ -40,6 +40,7 @@
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "circuit_validator.hpp"
+#include "incremental_simulation.hpp"
 #include "pattern_generation.hpp"
 #include "resubstitution.hpp"
 #include "resyn_engines/xag_resyn.hpp"
@@ -162,19 +163,12 @@ public:
   using TT = kitty::partial_truth_table;
 
   explicit simulation_based_resub_engine( Ntk& ntk, resubstitution_params const& ps, stats& st )
-      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ), validator( ntk, { ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed } ), engine( st.resyn_st )
+      : ntk( ntk ), ps( ps ), st( st ), inc_sim( ntk, sim, { validator_t::use_odc_ || has_EXODC_interface_v<Ntk> } ), validator( ntk, { ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed } ), engine( st.resyn_st )
   {
     if constexpr ( !validator_t::use_odc_ )
     {
       assert( ps.odc_levels == 0 && "to consider ODCs, circuit_validator::use_odc (the last template parameter) has to be turned on" );
     }
-
-    add_event = ntk.events().register_add_event( [&]( const auto& n ) {
-      tts.resize();
-      call_with_stopwatch( st.time_sim, [&]() {
-        simulate_node<Ntk>( ntk, n, tts, sim );
-      } );
-    } );
   }
 
   ~simulation_based_resub_engine()
@@ -182,14 +176,16 @@ public:
     if ( ps.save_patterns )
     {
       call_with_stopwatch( st.time_patsave, [&]() {
-        write_patterns( sim, *ps.save_patterns );
+        if ( ps.binary_patterns )
+        {
+          write_binary_patterns( sim, *ps.save_patterns );
+        }
+        else
+        {
+          write_patterns( sim, *ps.save_patterns );
+        }
       } );
     }
-
-    if ( add_event )
-    {
-      ntk.events().release_add_event( add_event );
-    }
   }
 
   void init()
@@ -216,7 +212,7 @@ public:
 
     /* first simulation: the whole circuit; from 0 bits. */
     call_with_stopwatch( st.time_sim, [&]() {
-      simulate_nodes<Ntk>( ntk, tts, sim, true );
+      inc_sim.simulate_all();
     } );
   }
 
@@ -224,13 +220,11 @@ public:
   {
     if constexpr ( validator_t::use_odc_ || has_EXODC_interface_v<Ntk> )
     {
+      /* the simulation values of the transitive fanout of modified nodes
+         are re-computed by `inc_sim` on the next access */
       call_with_stopwatch( st.time_sat_restart, [&]() {
         validator.update();
       } );
-      tts.reset();
-      call_with_stopwatch( st.time_sim, [&]() {
-        simulate_nodes<Ntk>( ntk, tts, sim, true );
-      } );
     }
   }
 
@@ -245,12 +239,12 @@ public:
       }
 
       TT const care = call_with_stopwatch( st.time_odc, [&]() {
-        return ( ps.odc_levels == 0 ) ? sim.compute_constant( true ) : ~observability_dont_cares( ntk, n, sim, tts, ps.odc_levels );
+        return ( ps.odc_levels == 0 ) ? sim.compute_constant( true ) : ~observability_dont_cares( ntk, n, sim, inc_sim.storage(), ps.odc_levels );
       } );
 
       const auto res = call_with_stopwatch( st.time_resyn, [&]() {
         ++st.num_resyn;
-        return engine( tts[n], care, std::begin( divs ), std::end( divs ), tts, std::min( potential_gain - 1, ps.max_inserts ) );
+        return engine( inc_sim.storage()[n], care, std::begin( divs ), std::end( divs ), inc_sim.storage(), std::min( potential_gain - 1, ps.max_inserts ) );
       } );
 
       if ( res )
@@ -304,21 +298,22 @@ public:
       sim.add_pattern( validator.cex );
     } );
 
-    /* re-simulate the whole circuit (for the last block) when a block is full */
-    if ( sim.num_bits() % 64 == 0 )
+    /* nodes are extended with the new patterns lazily when accessed; only the
+       ODC computation relies on all nodes lagging behind by at most one block */
+    if ( ps.odc_levels != 0 && sim.num_bits() % 64 == 0 )
     {
       call_with_stopwatch( st.time_sim, [&]() {
-        simulate_nodes<Ntk>( ntk, tts, sim, false );
+        inc_sim.update();
       } );
     }
   }
 
   void check_tts( node const& n )
   {
-    if ( tts[n].num_bits() != sim.num_bits() )
+    if ( !inc_sim.is_up_to_date( n ) )
     {
       call_with_stopwatch( st.time_sim, [&]() {
-        simulate_node<Ntk>( ntk, n, tts, sim );
+        inc_sim.update( n );
       } );
     }
   }
@@ -328,14 +323,11 @@ private:
   resubstitution_params const& ps;
   stats& st;
 
-  incomplete_node_map<TT, Ntk> tts;
   partial_simulator sim;
+  incremental_simulation<Ntk> inc_sim;
 
   validator_t validator;
   ResynEngine engine;
-
-  /* events */
-  std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
 }; /* simulation_based_resub_engine */
 
 template<class Ntk, typename resub_impl_t>
@@ -372,6 +364,17 @@ void sim_resubstitution( Ntk& ntk, resubstitution_params const& ps = {}, resubst
                  || std::is_same_v<typename Ntk::base_type, xag_network>
                  || std::is_same_v<typename Ntk::base_type, mig_network>, "Currently only supports AIG, XAG, and MIG" );
 
+  if constexpr ( std::is_same_v<Ntk, typename Ntk::base_type> )
+  {
+    if ( ps.num_threads > 1u )
+    {
+      detail::parallel_resubstitution( ntk, ps, pst, []( Ntk& part, resubstitution_params const& part_ps, resubstitution_stats* part_st ) {
+        sim_resubstitution( part, part_ps, part_st );
+      } );
+      return;
+    }
+  }
+
   using resub_view_t = fanout_view<depth_view<Ntk>>;
   depth_view<Ntk> depth_view{ ntk };
   resub_view_t resub_view{ depth_view };
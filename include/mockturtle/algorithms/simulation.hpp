@@ -40,6 +40,7 @@
 #include <random>
 #include <vector>
 
+#include "../io/binary_patterns.hpp"
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
 
@@ -210,6 +211,9 @@ public:
    *
    * The simulation pattern file should contain `num_pis` lines of the same length.
    * Each line is the simulation signature of a primary input, represented in hexadecimal.
+   * Alternatively, the file can be in the binary pattern format (see `write_binary_patterns`),
+   * which is detected automatically.  In this case, only the blocks needed to obtain
+   * `length` patterns are read.
    *
    * \param filename Name of the simulation pattern file.
    * \param length Number of simulation patterns to keep. Should not be greater than 4 times
@@ -217,6 +221,14 @@ public:
    */
   partial_simulator( const std::string& filename, uint32_t length = 0u )
   {
+    if ( is_binary_pattern_file( filename ) )
+    {
+      patterns = read_binary_patterns( filename, length );
+      assert( patterns.size() > 0 );
+      num_patterns = patterns[0].num_bits();
+      return;
+    }
+
     std::ifstream in( filename, std::ifstream::in );
     std::string line;
 
@@ -458,6 +470,15 @@ public:
     return false;
   }
 
+  /*! \brief Get the care bits of the simulation patterns.
+   *
+   * \return A vector of `num_pis()` care bit masks stored in `kitty::partial_truth_table`s.
+   */
+  std::vector<kitty::partial_truth_table> get_care() const
+  {
+    return care;
+  }
+
   void randomize_dont_care_bits( std::default_random_engine::result_type seed = 1 )
   {
     for ( auto i = 0u; i < patterns.size(); ++i )
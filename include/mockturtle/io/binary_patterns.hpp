@@ -0,0 +1,420 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file binary_patterns.hpp
+  \brief Binary chunked format for simulation patterns
+
+  A binary pattern file starts with a header of 32 bytes:
+
+  - 8 bytes magic string `MTPATBIN`
+  - 4 bytes format version (currently 1)
+  - 4 bytes number of primary inputs
+  - 8 bytes total number of patterns
+  - 4 bytes number of patterns per block (a multiple of 64)
+  - 4 bytes reserved (0)
+
+  followed by the blocks of patterns.  Every block contains the patterns
+  of all primary inputs, one after the other, each stored as 64-bit words
+  in the layout of `kitty::partial_truth_table`.  All blocks but the last
+  one contain the same number of patterns.  Integers are stored in the
+  byte order of the host.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+static constexpr std::array<char, 8> binary_patterns_magic = { 'M', 'T', 'P', 'A', 'T', 'B', 'I', 'N' };
+static constexpr uint32_t binary_patterns_version = 1u;
+
+struct binary_patterns_header
+{
+  uint32_t num_pis{ 0u };
+  uint64_t num_patterns{ 0u };
+  uint32_t block_size{ 0u };
+};
+
+inline void write_binary_patterns_header( std::ostream& os, binary_patterns_header const& h )
+{
+  uint32_t const reserved = 0u;
+  os.write( binary_patterns_magic.data(), binary_patterns_magic.size() );
+  os.write( reinterpret_cast<char const*>( &binary_patterns_version ), sizeof( uint32_t ) );
+  os.write( reinterpret_cast<char const*>( &h.num_pis ), sizeof( uint32_t ) );
+  os.write( reinterpret_cast<char const*>( &h.num_patterns ), sizeof( uint64_t ) );
+  os.write( reinterpret_cast<char const*>( &h.block_size ), sizeof( uint32_t ) );
+  os.write( reinterpret_cast<char const*>( &reserved ), sizeof( uint32_t ) );
+}
+
+inline bool read_binary_patterns_header( std::istream& is, binary_patterns_header& h )
+{
+  std::array<char, 8> magic;
+  uint32_t version, reserved;
+  is.read( magic.data(), magic.size() );
+  if ( !is || magic != binary_patterns_magic )
+  {
+    return false;
+  }
+  is.read( reinterpret_cast<char*>( &version ), sizeof( uint32_t ) );
+  is.read( reinterpret_cast<char*>( &h.num_pis ), sizeof( uint32_t ) );
+  is.read( reinterpret_cast<char*>( &h.num_patterns ), sizeof( uint64_t ) );
+  is.read( reinterpret_cast<char*>( &h.block_size ), sizeof( uint32_t ) );
+  is.read( reinterpret_cast<char*>( &reserved ), sizeof( uint32_t ) );
+  return is && version == binary_patterns_version && h.block_size > 0u && h.block_size % 64u == 0u;
+}
+
+} // namespace detail
+
+/*! \brief Checks whether a file is a binary pattern file. */
+inline bool is_binary_pattern_file( std::string const& filename )
+{
+  std::ifstream in( filename, std::ifstream::in | std::ifstream::binary );
+  std::array<char, 8> magic;
+  in.read( magic.data(), magic.size() );
+  return in && magic == detail::binary_patterns_magic;
+}
+
+/*! \brief Streaming reader for binary pattern files.
+ *
+ * Reads a binary pattern file block by block, such that pattern sets
+ * larger than the available memory can be simulated.  Only the current
+ * block is kept in memory.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      std::ifstream in( "patterns.bin", std::ifstream::binary );
+      binary_pattern_reader reader( in );
+
+      std::vector<kitty::partial_truth_table> block;
+      while ( reader.read_block( block ) )
+      {
+        partial_simulator sim( block );
+        auto const tts = simulate<kitty::partial_truth_table>( ntk, sim );
+        ...
+      }
+   \endverbatim
+ */
+class binary_pattern_reader
+{
+public:
+  explicit binary_pattern_reader( std::istream& is )
+      : is( is )
+  {
+    valid = detail::read_binary_patterns_header( is, header );
+  }
+
+  /*! \brief Returns false if the stream does not contain a valid header. */
+  bool is_valid() const
+  {
+    return valid;
+  }
+
+  /*! \brief Number of primary inputs. */
+  uint32_t num_pis() const
+  {
+    return header.num_pis;
+  }
+
+  /*! \brief Total number of patterns in the stream. */
+  uint64_t num_patterns() const
+  {
+    return header.num_patterns;
+  }
+
+  /*! \brief Number of patterns per block. */
+  uint32_t block_size() const
+  {
+    return header.block_size;
+  }
+
+  /*! \brief Number of patterns read so far. */
+  uint64_t num_read_patterns() const
+  {
+    return num_read;
+  }
+
+  /*! \brief Reads the next block of patterns.
+   *
+   * Stores one partial truth table per primary input into `block`, whose
+   * buffers are reused.  Returns false if all blocks have been read or the
+   * stream is corrupted.
+   */
+  bool read_block( std::vector<kitty::partial_truth_table>& block )
+  {
+    if ( !valid || num_read >= header.num_patterns )
+    {
+      return false;
+    }
+
+    auto const num_bits = static_cast<uint32_t>( std::min<uint64_t>( header.block_size, header.num_patterns - num_read ) );
+    block.resize( header.num_pis );
+    for ( auto& tt : block )
+    {
+      tt.resize( num_bits );
+      is.read( reinterpret_cast<char*>( tt._bits.data() ), tt.num_blocks() * sizeof( uint64_t ) );
+      tt.mask_bits();
+    }
+
+    if ( !is )
+    {
+      valid = false;
+      return false;
+    }
+    num_read += num_bits;
+    return true;
+  }
+
+  /*! \brief Reads the next block of patterns into a contiguous destination.
+   *
+   * Appends the patterns of the next block to `patterns`, which contains
+   * one partial truth table per primary input.  The number of bits in each
+   * of them must equal the number of patterns read so far.
+   */
+  bool append_block( std::vector<kitty::partial_truth_table>& patterns )
+  {
+    if ( !valid || num_read >= header.num_patterns )
+    {
+      return false;
+    }
+    assert( patterns.size() == header.num_pis );
+
+    auto const num_bits = static_cast<uint32_t>( std::min<uint64_t>( header.block_size, header.num_patterns - num_read ) );
+    for ( auto& tt : patterns )
+    {
+      assert( tt.num_bits() == num_read );
+      tt.resize( num_read + num_bits );
+      /* blocks are 64-bit aligned, hence the words can be read in place */
+      is.read( reinterpret_cast<char*>( tt._bits.data() + ( num_read >> 6 ) ), ( ( num_bits + 63u ) >> 6 ) * sizeof( uint64_t ) );
+      tt.mask_bits();
+    }
+
+    if ( !is )
+    {
+      valid = false;
+      return false;
+    }
+    num_read += num_bits;
+    return true;
+  }
+
+private:
+  std::istream& is;
+  detail::binary_patterns_header header;
+  uint64_t num_read{ 0u };
+  bool valid{ false };
+};
+
+/*! \brief Streaming writer for binary pattern files.
+ *
+ * Patterns are buffered until a block is complete, which is then written
+ * to the stream.  The total number of patterns is written into the header
+ * in `close`, which requires a seekable output stream (e.g., a file).  The
+ * destructor calls `close`.
+ */
+class binary_pattern_writer
+{
+public:
+  binary_pattern_writer( std::ostream& os, uint32_t num_pis, uint32_t block_size = 1u << 16 )
+      : os( os ), buffer( num_pis, kitty::partial_truth_table( 0u ) )
+  {
+    assert( block_size > 0u && block_size % 64u == 0u );
+    header.num_pis = num_pis;
+    header.block_size = block_size;
+    header_pos = os.tellp();
+    detail::write_binary_patterns_header( os, header );
+  }
+
+  ~binary_pattern_writer()
+  {
+    close();
+  }
+
+  /*! \brief Adds a single pattern (one value per primary input). */
+  void add_pattern( std::vector<bool> const& pattern )
+  {
+    assert( !closed && pattern.size() == header.num_pis );
+    for ( auto i = 0u; i < header.num_pis; ++i )
+    {
+      buffer[i].add_bit( pattern[i] );
+    }
+    if ( buffer_size() == header.block_size )
+    {
+      flush_block();
+    }
+  }
+
+  /*! \brief Adds patterns given as one partial truth table per primary input. */
+  void add_patterns( std::vector<kitty::partial_truth_table> const& patterns )
+  {
+    assert( !closed && patterns.size() == header.num_pis );
+    uint32_t const num_bits = patterns.empty() ? 0u : patterns[0].num_bits();
+
+    uint32_t pos = 0u;
+    while ( pos < num_bits )
+    {
+      auto const filled = buffer_size();
+      auto const count = std::min( header.block_size - filled, num_bits - pos );
+      for ( auto i = 0u; i < header.num_pis; ++i )
+      {
+        append_bits( buffer[i], patterns[i], pos, count );
+      }
+      pos += count;
+      if ( buffer_size() == header.block_size )
+      {
+        flush_block();
+      }
+    }
+  }
+
+  /*! \brief Number of patterns written (or buffered) so far. */
+  uint64_t num_patterns() const
+  {
+    return header.num_patterns + buffer_size();
+  }
+
+  /*! \brief Writes the last block and updates the header. */
+  void close()
+  {
+    if ( closed )
+    {
+      return;
+    }
+    if ( buffer_size() > 0u )
+    {
+      flush_block();
+    }
+    closed = true;
+
+    auto const end_pos = os.tellp();
+    if ( header_pos != std::streampos( -1 ) && end_pos != std::streampos( -1 ) )
+    {
+      os.seekp( header_pos );
+      detail::write_binary_patterns_header( os, header );
+      os.seekp( end_pos );
+    }
+    os.flush();
+  }
+
+private:
+  uint32_t buffer_size() const
+  {
+    return buffer.empty() ? 0u : buffer[0].num_bits();
+  }
+
+  void flush_block()
+  {
+    for ( auto& tt : buffer )
+    {
+      os.write( reinterpret_cast<char const*>( tt._bits.data() ), tt.num_blocks() * sizeof( uint64_t ) );
+    }
+    header.num_patterns += buffer_size();
+    for ( auto& tt : buffer )
+    {
+      tt.resize( 0u );
+    }
+  }
+
+  static void append_bits( kitty::partial_truth_table& tt, kitty::partial_truth_table const& from, uint32_t pos, uint32_t count )
+  {
+    auto const offset = tt.num_bits();
+    tt.resize( offset + count );
+    if ( offset % 64u == 0u && pos % 64u == 0u )
+    {
+      std::copy_n( from._bits.begin() + ( pos >> 6 ), ( count + 63u ) >> 6, tt._bits.begin() + ( offset >> 6 ) );
+      tt.mask_bits();
+      return;
+    }
+    for ( auto j = 0u; j < count; ++j )
+    {
+      if ( kitty::get_bit( from, pos + j ) )
+      {
+        kitty::set_bit( tt, offset + j );
+      }
+    }
+  }
+
+private:
+  std::ostream& os;
+  detail::binary_patterns_header header;
+  std::streampos header_pos;
+  std::vector<kitty::partial_truth_table> buffer;
+  bool closed{ false };
+};
+
+/*! \brief Reads patterns from a binary pattern file.
+ *
+ * Returns one partial truth table per primary input.  If `max_patterns` is
+ * not 0, reading stops after the first block that completes `max_patterns`
+ * patterns, and the result is truncated to `max_patterns` patterns.
+ * Returns an empty vector if the file is not a valid binary pattern file.
+ *
+ * \param filename Name of the binary pattern file
+ * \param max_patterns Maximum number of patterns to read (0 = all)
+ */
+inline std::vector<kitty::partial_truth_table> read_binary_patterns( std::string const& filename, uint64_t max_patterns = 0u )
+{
+  std::ifstream in( filename, std::ifstream::in | std::ifstream::binary );
+  binary_pattern_reader reader( in );
+  if ( !reader.is_valid() )
+  {
+    return {};
+  }
+
+  std::vector<kitty::partial_truth_table> patterns( reader.num_pis(), kitty::partial_truth_table( 0u ) );
+  while ( ( max_patterns == 0u || reader.num_read_patterns() < max_patterns ) && reader.append_block( patterns ) )
+    ;
+
+  if ( max_patterns != 0u && reader.num_read_patterns() > max_patterns )
+  {
+    for ( auto& tt : patterns )
+    {
+      tt.resize( static_cast<uint32_t>( max_patterns ) );
+    }
+  }
+  return patterns;
+}
+
+} // namespace mockturtle
@@ -42,6 +42,7 @@
 #include <kitty/print.hpp>
 
 #include "../algorithms/simulation.hpp"
+#include "binary_patterns.hpp"
 
 namespace mockturtle
 {
@@ -84,4 +85,40 @@ void write_patterns( Simulator const& sim, std::string const& filename )
   os.close();
 }
 
+/*! \brief Writes simulation patterns in the binary pattern format
+ *
+ * The patterns are written in blocks of `block_size` patterns (see
+ * `binary_pattern_writer`), which can be read back block by block with
+ * `binary_pattern_reader` or all at once by the file constructor of
+ * `partial_simulator`.
+ *
+ * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param out Output stream (should be seekable and opened in binary mode)
+ * \param block_size Number of patterns per block, must be a multiple of 64
+ */
+template<class Simulator>
+void write_binary_patterns( Simulator const& sim, std::ostream& out, uint32_t block_size = 1u << 16 )
+{
+  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+
+  auto const patterns = sim.get_patterns();
+  binary_pattern_writer writer( out, static_cast<uint32_t>( patterns.size() ), block_size );
+  writer.add_patterns( patterns );
+  writer.close();
+}
+
+/*! \brief Writes simulation patterns in the binary pattern format
+ *
+ * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param filename Filename
+ * \param block_size Number of patterns per block, must be a multiple of 64
+ */
+template<class Simulator>
+void write_binary_patterns( Simulator const& sim, std::string const& filename, uint32_t block_size = 1u << 16 )
+{
+  std::ofstream os( filename.c_str(), std::ofstream::out | std::ofstream::binary );
+  write_binary_patterns( sim, os, block_size );
+  os.close();
+}
+
 } /* namespace mockturtle */
\ No newline at end of file
@@ -143,6 +143,7 @@
 #include "mockturtle/generators/sorting.hpp"
 #include "mockturtle/io/aiger_reader.hpp"
 #include "mockturtle/io/bench_reader.hpp"
+#include "mockturtle/io/binary_patterns.hpp"
 #include "mockturtle/io/blif_reader.hpp"
 #include "mockturtle/io/bristol_reader.hpp"
 #include "mockturtle/io/dimacs_reader.hpp"
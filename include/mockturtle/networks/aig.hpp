@@ -42,6 +42,7 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "../utils/simd_kernels.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -1144,10 +1145,19 @@ public:
     auto const& c1 = _storage->nodes[n].children[0];
     auto const& c2 = _storage->nodes[n].children[1];
 
-    auto tt1 = *begin++;
-    auto tt2 = *begin++;
+    auto const& tt1 = *begin++;
+    auto const& tt2 = *begin++;
 
-    return ( c1.weight ? ~tt1 : tt1 ) & ( c2.weight ? ~tt2 : tt2 );
+    if constexpr ( kitty::is_completely_specified_truth_table<std::decay_t<decltype( tt1 )>>::value )
+    {
+      auto result = tt1.construct();
+      simd::binary_and( result, tt1, tt2, c1.weight, c2.weight );
+      return result;
+    }
+    else
+    {
+      return ( c1.weight ? ~tt1 : tt1 ) & ( c2.weight ? ~tt2 : tt2 );
+    }
   }
 
   /*! \brief Re-compute the last block. */
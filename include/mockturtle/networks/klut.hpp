@@ -40,6 +40,7 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "../utils/simd_kernels.hpp"
 #include "../utils/truth_table_cache.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
@@ -612,6 +613,18 @@ public:
   {
     const auto nfanin = _storage->nodes[n].children.size();
 
+    /* evaluate small LUTs on 64 bits at a time */
+    if constexpr ( kitty::is_completely_specified_truth_table<typename std::iterator_traits<Iterator>::value_type>::value )
+    {
+      if ( nfanin <= 6u )
+      {
+        assert( nfanin != 0 );
+        auto result = ( *begin ).construct();
+        simd::lut( result, _storage->data.cache[_storage->nodes[n].data[1].h1], begin, end );
+        return result;
+      }
+    }
+
     std::vector<typename std::iterator_traits<Iterator>::value_type> tts( begin, end );
 
     assert( nfanin != 0 );
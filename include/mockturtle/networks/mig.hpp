@@ -51,6 +51,7 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "../utils/simd_kernels.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -1121,11 +1122,20 @@ public:
     auto const& c2 = _storage->nodes[n].children[1];
     auto const& c3 = _storage->nodes[n].children[2];
 
-    auto tt1 = *begin++;
-    auto tt2 = *begin++;
-    auto tt3 = *begin++;
+    auto const& tt1 = *begin++;
+    auto const& tt2 = *begin++;
+    auto const& tt3 = *begin++;
 
-    return kitty::ternary_majority( c1.weight ? ~tt1 : tt1, c2.weight ? ~tt2 : tt2, c3.weight ? ~tt3 : tt3 );
+    if constexpr ( kitty::is_completely_specified_truth_table<std::decay_t<decltype( tt1 )>>::value )
+    {
+      auto result = tt1.construct();
+      simd::ternary_majority( result, tt1, tt2, tt3, c1.weight, c2.weight, c3.weight );
+      return result;
+    }
+    else
+    {
+      return kitty::ternary_majority( c1.weight ? ~tt1 : tt1, c2.weight ? ~tt2 : tt2, c3.weight ? ~tt3 : tt3 );
+    }
   }
 
   /*! \brief Re-compute the last block. */
@@ -51,6 +51,7 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "../utils/simd_kernels.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -1153,16 +1154,32 @@ public:
     auto const& c1 = _storage->nodes[n].children[0];
     auto const& c2 = _storage->nodes[n].children[1];
 
-    auto tt1 = *begin++;
-    auto tt2 = *begin++;
+    auto const& tt1 = *begin++;
+    auto const& tt2 = *begin++;
 
-    if ( c1.index <= c2.index )
+    if constexpr ( kitty::is_completely_specified_truth_table<std::decay_t<decltype( tt1 )>>::value )
     {
-      return ( c1.weight ? ~tt1 : tt1 ) & ( c2.weight ? ~tt2 : tt2 );
+      auto result = tt1.construct();
+      if ( c1.index <= c2.index )
+      {
+        simd::binary_and( result, tt1, tt2, c1.weight, c2.weight );
+      }
+      else
+      {
+        simd::binary_xor( result, tt1, tt2, c1.weight, c2.weight );
+      }
+      return result;
     }
     else
     {
-      return ( c1.weight ? ~tt1 : tt1 ) ^ ( c2.weight ? ~tt2 : tt2 );
+      if ( c1.index <= c2.index )
+      {
+        return ( c1.weight ? ~tt1 : tt1 ) & ( c2.weight ? ~tt2 : tt2 );
+      }
+      else
+      {
+        return ( c1.weight ? ~tt1 : tt1 ) ^ ( c2.weight ? ~tt2 : tt2 );
+      }
     }
   }
 
@@ -0,0 +1,344 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file simd_kernels_impl.hpp
+  \brief Word-level kernel bodies shared by all instruction sets
+
+  This file is intentionally not guarded by `#pragma once`.  It is included
+  by `simd_kernels.hpp` once per instruction set, inside a namespace that
+  provides a type `ops` with the vector primitives (`lanes`, `load`, `store`,
+  `set1`, `and_`, `or_`, `xor_`, `is_zero`, `popcount`).  Every kernel
+  processes `n` 64-bit words; kernels returning a predicate or a count mask
+  the last word with `last_mask` before evaluating it.
+*/
+
+inline void and2( uint64_t* r, uint64_t const* a, uint64_t const* b, std::size_t n, uint64_t ca, uint64_t cb )
+{
+  auto const va = ops::set1( ca ), vb = ops::set1( cb );
+  std::size_t i = 0u;
+  for ( ; i + ops::lanes <= n; i += ops::lanes )
+  {
+    ops::store( r + i, ops::and_( ops::xor_( ops::load( a + i ), va ), ops::xor_( ops::load( b + i ), vb ) ) );
+  }
+  for ( ; i < n; ++i )
+  {
+    r[i] = ( a[i] ^ ca ) & ( b[i] ^ cb );
+  }
+}
+
+inline void xor2( uint64_t* r, uint64_t const* a, uint64_t const* b, std::size_t n, uint64_t ca, uint64_t cb )
+{
+  auto const vc = ops::set1( ca ^ cb );
+  std::size_t i = 0u;
+  for ( ; i + ops::lanes <= n; i += ops::lanes )
+  {
+    ops::store( r + i, ops::xor_( ops::xor_( ops::load( a + i ), ops::load( b + i ) ), vc ) );
+  }
+  for ( ; i < n; ++i )
+  {
+    r[i] = a[i] ^ b[i] ^ ca ^ cb;
+  }
+}
+
+inline void maj3( uint64_t* r, uint64_t const* a, uint64_t const* b, uint64_t const* c, std::size_t n, uint64_t ca, uint64_t cb, uint64_t cc )
+{
+  auto const va = ops::set1( ca ), vb = ops::set1( cb ), vc = ops::set1( cc );
+  std::size_t i = 0u;
+  for ( ; i + ops::lanes <= n; i += ops::lanes )
+  {
+    auto const x = ops::xor_( ops::load( a + i ), va );
+    auto const y = ops::xor_( ops::load( b + i ), vb );
+    auto const z = ops::xor_( ops::load( c + i ), vc );
+    ops::store( r + i, ops::or_( ops::and_( x, y ), ops::and_( z, ops::or_( x, y ) ) ) );
+  }
+  for ( ; i < n; ++i )
+  {
+    auto const x = a[i] ^ ca, y = b[i] ^ cb, z = c[i] ^ cc;
+    r[i] = ( x & y ) | ( z & ( x | y ) );
+  }
+}
+
+/* r = s ? t : e, computed as e ^ ( s & ( t ^ e ) ) */
+inline void mux3( uint64_t* r, uint64_t const* s, uint64_t const* t, uint64_t const* e, std::size_t n, uint64_t cs, uint64_t ct, uint64_t ce )
+{
+  auto const vs = ops::set1( cs ), vt = ops::set1( ct ), ve = ops::set1( ce );
+  std::size_t i = 0u;
+  for ( ; i + ops::lanes <= n; i += ops::lanes )
+  {
+    auto const x = ops::xor_( ops::load( s + i ), vs );
+    auto const y = ops::xor_( ops::load( t + i ), vt );
+    auto const z = ops::xor_( ops::load( e + i ), ve );
+    ops::store( r + i, ops::xor_( z, ops::and_( x, ops::xor_( y, z ) ) ) );
+  }
+  for ( ; i < n; ++i )
+  {
+    auto const x = s[i] ^ cs, y = t[i] ^ ct, z = e[i] ^ ce;
+    r[i] = z ^ ( x & ( y ^ z ) );
+  }
+}
+
+/* r = f( x[0], ..., x[k-1] ) for a function f of k <= 6 variables, given by
+   the word `func`, evaluated as a tree of multiplexers over the Shannon
+   cofactors: the leaves select between two bits of `func` with x[0], every
+   further level selects between two subtrees with the next variable */
+inline void lut6( uint64_t* r, uint64_t const* const* x, uint32_t k, uint64_t func, std::size_t n )
+{
+  if ( k == 0u )
+  {
+    std::fill_n( r, n, ( func & 1u ) ? ~uint64_t( 0 ) : uint64_t( 0 ) );
+    return;
+  }
+
+  uint32_t const num_leaves = 1u << ( k - 1u );
+  uint64_t base[32], diff[32];
+  typename ops::vec vbase[32], vdiff[32], v[32];
+  for ( auto j = 0u; j < num_leaves; ++j )
+  {
+    auto const b0 = ( func >> ( 2u * j ) ) & 1u, b1 = ( func >> ( 2u * j + 1u ) ) & 1u;
+    base[j] = b0 ? ~uint64_t( 0 ) : uint64_t( 0 );
+    diff[j] = ( b0 ^ b1 ) ? ~uint64_t( 0 ) : uint64_t( 0 );
+    vbase[j] = ops::set1( base[j] );
+    vdiff[j] = ops::set1( diff[j] );
+  }
+
+  std::size_t i = 0u;
+  for ( ; i + ops::lanes <= n; i += ops::lanes )
+  {
+    auto const x0 = ops::load( x[0] + i );
+    for ( auto j = 0u; j < num_leaves; ++j )
+    {
+      v[j] = ops::xor_( vbase[j], ops::and_( x0, vdiff[j] ) );
+    }
+    for ( auto l = 1u; l < k; ++l )
+    {
+      auto const xl = ops::load( x[l] + i );
+      for ( auto j = 0u; j < ( num_leaves >> l ); ++j )
+      {
+        v[j] = ops::xor_( v[2u * j], ops::and_( xl, ops::xor_( v[2u * j + 1u], v[2u * j] ) ) );
+      }
+    }
+    ops::store( r + i, v[0] );
+  }
+  for ( ; i < n; ++i )
+  {
+    uint64_t w[32];
+    for ( auto j = 0u; j < num_leaves; ++j )
+    {
+      w[j] = base[j] ^ ( x[0][i] & diff[j] );
+    }
+    for ( auto l = 1u; l < k; ++l )
+    {
+      for ( auto j = 0u; j < ( num_leaves >> l ); ++j )
+      {
+        w[j] = w[2u * j] ^ ( x[l][i] & ( w[2u * j + 1u] ^ w[2u * j] ) );
+      }
+    }
+    r[i] = w[0];
+  }
+}
+
+inline bool and2_is_zero( uint64_t const* a, uint64_t const* b, std::size_t n, uint64_t ca, uint64_t cb, uint64_t last_mask )
+{
+  if ( n == 0u )
+  {
+    return true;
+  }
+  auto const va = ops::set1( ca ), vb = ops::set1( cb );
+  std::size_t i = 0u;
+  for ( ; i + ops::lanes < n; i += ops::lanes )
+  {
+    if ( !ops::is_zero( ops::and_( ops::xor_( ops::load( a + i ), va ), ops::xor_( ops::load( b + i ), vb ) ) ) )
+    {
+      return false;
+    }
+  }
+  for ( ; i + 1 < n; ++i )
+  {
+    if ( ( ( a[i] ^ ca ) & ( b[i] ^ cb ) ) != 0u )
+    {
+      return false;
+    }
+  }
+  return ( ( a[n - 1] ^ ca ) & ( b[n - 1] ^ cb ) & last_mask ) == 0u;
+}
+
+inline bool and3_is_zero( uint64_t const* a, uint64_t const* b, uint64_t const* c, std::size_t n, uint64_t ca, uint64_t cb, uint64_t cc, uint64_t last_mask )
+{
+  if ( n == 0u )
+  {
+    return true;
+  }
+  auto const va = ops::set1( ca ), vb = ops::set1( cb ), vc = ops::set1( cc );
+  std::size_t i = 0u;
+  for ( ; i + ops::lanes < n; i += ops::lanes )
+  {
+    auto const x = ops::and_( ops::xor_( ops::load( a + i ), va ), ops::xor_( ops::load( b + i ), vb ) );
+    if ( !ops::is_zero( ops::and_( x, ops::xor_( ops::load( c + i ), vc ) ) ) )
+    {
+      return false;
+    }
+  }
+  for ( ; i + 1 < n; ++i )
+  {
+    if ( ( ( a[i] ^ ca ) & ( b[i] ^ cb ) & ( c[i] ^ cc ) ) != 0u )
+    {
+      return false;
+    }
+  }
+  return ( ( a[n - 1] ^ ca ) & ( b[n - 1] ^ cb ) & ( c[n - 1] ^ cc ) & last_mask ) == 0u;
+}
+
+/* ( ( ( a ^ ca ) & ( b ^ cb ) ) ^ ( t ^ ct ) ) & care == 0, care may be `nullptr` */
+inline bool and2_equal( uint64_t const* a, uint64_t const* b, uint64_t const* t, uint64_t const* care, std::size_t n, uint64_t ca, uint64_t cb, uint64_t ct, uint64_t last_mask )
+{
+  if ( n == 0u )
+  {
+    return true;
+  }
+  auto const va = ops::set1( ca ), vb = ops::set1( cb ), vt = ops::set1( ct );
+  std::size_t i = 0u;
+  if ( care )
+  {
+    for ( ; i + ops::lanes < n; i += ops::lanes )
+    {
+      auto const x = ops::and_( ops::xor_( ops::load( a + i ), va ), ops::xor_( ops::load( b + i ), vb ) );
+      if ( !ops::is_zero( ops::and_( ops::xor_( x, ops::xor_( ops::load( t + i ), vt ) ), ops::load( care + i ) ) ) )
+      {
+        return false;
+      }
+    }
+    for ( ; i + 1 < n; ++i )
+    {
+      if ( ( ( ( ( a[i] ^ ca ) & ( b[i] ^ cb ) ) ^ t[i] ^ ct ) & care[i] ) != 0u )
+      {
+        return false;
+      }
+    }
+    return ( ( ( ( a[n - 1] ^ ca ) & ( b[n - 1] ^ cb ) ) ^ t[n - 1] ^ ct ) & care[n - 1] & last_mask ) == 0u;
+  }
+
+  for ( ; i + ops::lanes < n; i += ops::lanes )
+  {
+    auto const x = ops::and_( ops::xor_( ops::load( a + i ), va ), ops::xor_( ops::load( b + i ), vb ) );
+    if ( !ops::is_zero( ops::xor_( x, ops::xor_( ops::load( t + i ), vt ) ) ) )
+    {
+      return false;
+    }
+  }
+  for ( ; i + 1 < n; ++i )
+  {
+    if ( ( ( ( a[i] ^ ca ) & ( b[i] ^ cb ) ) ^ t[i] ^ ct ) != 0u )
+    {
+      return false;
+    }
+  }
+  return ( ( ( ( a[n - 1] ^ ca ) & ( b[n - 1] ^ cb ) ) ^ t[n - 1] ^ ct ) & last_mask ) == 0u;
+}
+
+/* ( ( a ^ b ^ ca ) ^ t ) & care == 0, care may be `nullptr` */
+inline bool xor2_equal( uint64_t const* a, uint64_t const* b, uint64_t const* t, uint64_t const* care, std::size_t n, uint64_t ca, uint64_t last_mask )
+{
+  if ( n == 0u )
+  {
+    return true;
+  }
+  auto const va = ops::set1( ca );
+  std::size_t i = 0u;
+  if ( care )
+  {
+    for ( ; i + ops::lanes < n; i += ops::lanes )
+    {
+      auto const x = ops::xor_( ops::xor_( ops::load( a + i ), ops::load( b + i ) ), ops::xor_( ops::load( t + i ), va ) );
+      if ( !ops::is_zero( ops::and_( x, ops::load( care + i ) ) ) )
+      {
+        return false;
+      }
+    }
+    for ( ; i + 1 < n; ++i )
+    {
+      if ( ( ( a[i] ^ b[i] ^ t[i] ^ ca ) & care[i] ) != 0u )
+      {
+        return false;
+      }
+    }
+    return ( ( a[n - 1] ^ b[n - 1] ^ t[n - 1] ^ ca ) & care[n - 1] & last_mask ) == 0u;
+  }
+
+  for ( ; i + ops::lanes < n; i += ops::lanes )
+  {
+    if ( !ops::is_zero( ops::xor_( ops::xor_( ops::load( a + i ), ops::load( b + i ) ), ops::xor_( ops::load( t + i ), va ) ) ) )
+    {
+      return false;
+    }
+  }
+  for ( ; i + 1 < n; ++i )
+  {
+    if ( ( a[i] ^ b[i] ^ t[i] ^ ca ) != 0u )
+    {
+      return false;
+    }
+  }
+  return ( ( a[n - 1] ^ b[n - 1] ^ t[n - 1] ^ ca ) & last_mask ) == 0u;
+}
+
+inline uint64_t popcount( uint64_t const* a, std::size_t n, uint64_t last_mask )
+{
+  if ( n == 0u )
+  {
+    return 0u;
+  }
+  uint64_t count = 0u;
+  std::size_t i = 0u;
+  for ( ; i + ops::lanes < n; i += ops::lanes )
+  {
+    count += ops::popcount( ops::load( a + i ) );
+  }
+  for ( ; i + 1 < n; ++i )
+  {
+    count += __builtin_popcountll( a[i] );
+  }
+  return count + __builtin_popcountll( a[n - 1] & last_mask );
+}
+
+inline uint64_t popcount_and2( uint64_t const* a, uint64_t const* b, std::size_t n, uint64_t ca, uint64_t cb, uint64_t last_mask )
+{
+  if ( n == 0u )
+  {
+    return 0u;
+  }
+  auto const va = ops::set1( ca ), vb = ops::set1( cb );
+  uint64_t count = 0u;
+  std::size_t i = 0u;
+  for ( ; i + ops::lanes < n; i += ops::lanes )
+  {
+    count += ops::popcount( ops::and_( ops::xor_( ops::load( a + i ), va ), ops::xor_( ops::load( b + i ), vb ) ) );
+  }
+  for ( ; i + 1 < n; ++i )
+  {
+    count += __builtin_popcountll( ( a[i] ^ ca ) & ( b[i] ^ cb ) );
+  }
+  return count + __builtin_popcountll( ( a[n - 1] ^ ca ) & ( b[n - 1] ^ cb ) & last_mask );
+}
@@ -0,0 +1,537 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file exact_synthesis_cache.hpp
+  \brief Persistent binary cache of exact synthesis results
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if !defined( _WIN32 ) && !defined( _WIN64 )
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+
+#include "include/percy.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Persistent binary cache of exact synthesis results.
+ *
+ * Stores the chains computed by exact synthesis, keyed by a configuration
+ * identifier (engine and synthesis parameters) and by the NPN
+ * representative of the synthesized function, in a binary file.  The file
+ * is memory-mapped when the cache is opened, and an index from keys to
+ * records is built by scanning it.  New results are appended to the file
+ * as self-contained records, each written with a single `write` call under
+ * an exclusive file lock, such that several processes can share the same
+ * file.  Records appended by other processes are picked up by `refresh`,
+ * which is also called on each lookup miss.  Records which are incomplete
+ * (e.g., due to an interrupted process) or corrupted are ignored.  A later
+ * record for the same key replaces earlier ones.
+ *
+ * An entry consists of a list of chains and a status: the list may be
+ * empty (no solution within the configured limits), complete, or partial
+ * (only the first solutions of an enumeration).
+ *
+ * The file stores integers in the byte order of the machine.  On Windows,
+ * the file is read into memory instead of being mapped, and appends are
+ * not synchronized between processes.
+ *
+ * The resynthesis functions `exact_resynthesis`, `exact_aig_resynthesis`,
+ * and `exact_xmg_resynthesis` consult the cache passed in their parameters
+ * (`persistent_cache`).  `cached_resynthesis` consults it through the
+ * wrapped resynthesis function.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      exact_resynthesis_params ps;
+      ps.persistent_cache = std::make_shared<exact_synthesis_cache>( "exact.cache" );
+      exact_aig_resynthesis<aig_network> resyn( false, ps );
+      cut_rewriting( aig, resyn );
+   \endverbatim
+ */
+class exact_synthesis_cache
+{
+public:
+  enum class entry_status : uint8_t
+  {
+    /*! \brief No solution within the configured limits. */
+    none = 0,
+    /*! \brief All solutions of the configuration. */
+    complete = 1,
+    /*! \brief The first solutions of an enumeration. */
+    partial = 2
+  };
+
+  struct entry
+  {
+    entry_status status{ entry_status::none };
+    std::vector<percy::chain> chains;
+  };
+
+public:
+  /*! \brief Opens (or creates) the cache file `filename`. */
+  explicit exact_synthesis_cache( std::string const& filename )
+      : _filename( filename )
+  {
+    refresh();
+  }
+
+  ~exact_synthesis_cache()
+  {
+    unmap();
+  }
+
+  exact_synthesis_cache( exact_synthesis_cache const& ) = delete;
+  exact_synthesis_cache& operator=( exact_synthesis_cache const& ) = delete;
+
+  /*! \brief Computes the NPN representative of a function.
+   *
+   * Returns the representative, the phase (output negation in bit
+   * `num_vars`), and the permutation in the format of
+   * `kitty::exact_npn_canonization`.  Functions with more than 6 variables
+   * are their own representative.
+   */
+  static std::tuple<kitty::dynamic_truth_table, uint32_t, std::vector<uint8_t>> canonize( kitty::dynamic_truth_table const& tt )
+  {
+    if ( tt.num_vars() <= 6u )
+    {
+      return kitty::exact_npn_canonization( tt );
+    }
+    std::vector<uint8_t> perm( tt.num_vars() );
+    std::iota( perm.begin(), perm.end(), 0u );
+    return { tt, 0u, perm };
+  }
+
+  /*! \brief Identifier of a synthesis configuration described by a string. */
+  static uint64_t configuration( std::string const& description )
+  {
+    uint64_t h = 0xcbf29ce484222325ull; /* FNV-1a */
+    for ( auto const c : description )
+    {
+      h = ( h ^ static_cast<uint8_t>( c ) ) * 0x100000001b3ull;
+    }
+    return h;
+  }
+
+  /*! \brief Looks up the entry of a function (usually an NPN representative). */
+  std::optional<entry> lookup( uint64_t config, kitty::dynamic_truth_table const& tt )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    auto it = _index.find( { config, tt } );
+    if ( it == _index.end() )
+    {
+      refresh_locked();
+      it = _index.find( { config, tt } );
+    }
+    if ( it == _index.end() )
+    {
+      ++_num_misses;
+      return std::nullopt;
+    }
+    ++_num_hits;
+    return decode_entry( it->second );
+  }
+
+  /*! \brief Appends an entry for a function to the file. */
+  void insert( uint64_t config, kitty::dynamic_truth_table const& tt, entry_status status, std::vector<percy::chain> const& chains )
+  {
+    std::string payload;
+    write_value( payload, config );
+    write_value( payload, static_cast<uint8_t>( tt.num_vars() ) );
+    for ( auto const w : tt )
+    {
+      write_value( payload, static_cast<uint64_t>( w ) );
+    }
+    write_value( payload, static_cast<uint8_t>( status ) );
+    write_value( payload, static_cast<uint32_t>( chains.size() ) );
+    for ( auto const& c : chains )
+    {
+      encode_chain( payload, c );
+    }
+
+    std::string record;
+    write_value( record, static_cast<uint32_t>( payload.size() ) );
+    write_value( record, checksum( payload.data(), payload.size() ) );
+    record += payload;
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    append( record );
+    refresh_locked();
+  }
+
+  /*! \brief Reads the records appended to the file since the last call. */
+  void refresh()
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    refresh_locked();
+  }
+
+  /*! \brief Number of keys in the cache. */
+  uint64_t size() const
+  {
+    return _index.size();
+  }
+
+  uint64_t num_hits() const
+  {
+    return _num_hits;
+  }
+
+  uint64_t num_misses() const
+  {
+    return _num_misses;
+  }
+
+private:
+  static constexpr char magic[8] = { 'M', 'T', 'E', 'X', 'S', 'Y', 'N', '1' };
+
+  struct key_hash
+  {
+    std::size_t operator()( std::pair<uint64_t, kitty::dynamic_truth_table> const& key ) const
+    {
+      auto seed = kitty::hash<kitty::dynamic_truth_table>()( key.second );
+      kitty::hash_combine( seed, std::hash<uint64_t>()( key.first ) );
+      return seed;
+    }
+  };
+
+  template<typename T>
+  static void write_value( std::string& buffer, T const& value )
+  {
+    buffer.append( reinterpret_cast<char const*>( &value ), sizeof( T ) );
+  }
+
+  template<typename T>
+  static bool read_value( char const*& pos, char const* end, T& value )
+  {
+    if ( static_cast<std::size_t>( end - pos ) < sizeof( T ) )
+    {
+      return false;
+    }
+    std::memcpy( &value, pos, sizeof( T ) );
+    pos += sizeof( T );
+    return true;
+  }
+
+  static uint32_t checksum( char const* data, std::size_t size )
+  {
+    uint32_t h = 0x811c9dc5u; /* FNV-1a */
+    for ( auto i = 0u; i < size; ++i )
+    {
+      h = ( h ^ static_cast<uint8_t>( data[i] ) ) * 0x01000193u;
+    }
+    return h;
+  }
+
+  static void encode_chain( std::string& buffer, percy::chain const& c )
+  {
+    write_value( buffer, static_cast<int32_t>( c.get_nr_inputs() ) );
+    write_value( buffer, static_cast<int32_t>( c.get_fanin() ) );
+    write_value( buffer, static_cast<int32_t>( c.get_nr_steps() ) );
+    write_value( buffer, static_cast<int32_t>( c.get_nr_outputs() ) );
+    for ( auto i = 0; i < c.get_nr_steps(); ++i )
+    {
+      for ( auto const child : c.get_step( i ) )
+      {
+        write_value( buffer, static_cast<int32_t>( child ) );
+      }
+      auto const& op = c.get_operator( i );
+      write_value( buffer, static_cast<uint8_t>( op.num_vars() ) );
+      for ( auto const w : op )
+      {
+        write_value( buffer, static_cast<uint64_t>( w ) );
+      }
+    }
+    for ( auto const lit : c.get_outputs() )
+    {
+      write_value( buffer, static_cast<int32_t>( lit ) );
+    }
+  }
+
+  static bool decode_truth_table( char const*& pos, char const* end, kitty::dynamic_truth_table& tt )
+  {
+    uint8_t num_vars;
+    if ( !read_value( pos, end, num_vars ) || num_vars > 16u )
+    {
+      return false;
+    }
+    tt = kitty::dynamic_truth_table( num_vars );
+    for ( auto& w : tt )
+    {
+      uint64_t word;
+      if ( !read_value( pos, end, word ) )
+      {
+        return false;
+      }
+      w = word;
+    }
+    return true;
+  }
+
+  static bool decode_chain( char const*& pos, char const* end, percy::chain& c )
+  {
+    int32_t nr_in, fanin, nr_steps, nr_outputs;
+    if ( !read_value( pos, end, nr_in ) || !read_value( pos, end, fanin ) || !read_value( pos, end, nr_steps ) || !read_value( pos, end, nr_outputs ) )
+    {
+      return false;
+    }
+    if ( nr_in < 0 || fanin < 0 || fanin > percy::MAX_FANIN || nr_steps < 0 || nr_outputs < 0 )
+    {
+      return false;
+    }
+    c.reset( nr_in, nr_outputs, nr_steps, fanin );
+    std::vector<int> step( fanin );
+    for ( auto i = 0; i < nr_steps; ++i )
+    {
+      for ( auto& child : step )
+      {
+        int32_t v;
+        if ( !read_value( pos, end, v ) )
+        {
+          return false;
+        }
+        child = v;
+      }
+      kitty::dynamic_truth_table op;
+      if ( !decode_truth_table( pos, end, op ) )
+      {
+        return false;
+      }
+      c.set_step( i, step, op );
+    }
+    for ( auto i = 0; i < nr_outputs; ++i )
+    {
+      int32_t lit;
+      if ( !read_value( pos, end, lit ) )
+      {
+        return false;
+      }
+      c.set_output( i, lit );
+    }
+    return true;
+  }
+
+  entry decode_entry( uint64_t offset ) const
+  {
+    char const* pos = _data + offset;
+    char const* const end = _data + _size;
+    uint64_t config{ 0 };
+    kitty::dynamic_truth_table tt;
+    uint8_t status{ 0 };
+    uint32_t num_chains{ 0 };
+    read_value( pos, end, config );
+    decode_truth_table( pos, end, tt );
+    read_value( pos, end, status );
+    read_value( pos, end, num_chains );
+
+    entry e;
+    e.status = static_cast<entry_status>( status );
+    e.chains.resize( num_chains );
+    for ( auto& c : e.chains )
+    {
+      decode_chain( pos, end, c );
+    }
+    return e;
+  }
+
+  /* checks the records from `_scanned` on and adds them to the index */
+  void scan()
+  {
+    if ( _scanned == 0u )
+    {
+      if ( _size < sizeof( magic ) || std::memcmp( _data, magic, sizeof( magic ) ) != 0 )
+      {
+        return;
+      }
+      _scanned = sizeof( magic );
+    }
+
+    while ( _scanned + 8u <= _size )
+    {
+      char const* pos = _data + _scanned;
+      uint32_t payload_size, sum;
+      read_value( pos, _data + _size, payload_size );
+      read_value( pos, _data + _size, sum );
+      if ( _scanned + 8u + payload_size > _size )
+      {
+        break; /* incomplete record */
+      }
+
+      char const* const end = pos + payload_size;
+      uint64_t config;
+      kitty::dynamic_truth_table tt;
+      uint8_t status;
+      uint32_t num_chains;
+      bool valid = checksum( pos, payload_size ) == sum;
+      auto const offset = static_cast<uint64_t>( pos - _data );
+      if ( valid && read_value( pos, end, config ) && decode_truth_table( pos, end, tt ) && read_value( pos, end, status ) && read_value( pos, end, num_chains ) )
+      {
+        for ( auto i = 0u; valid && i < num_chains; ++i )
+        {
+          percy::chain c;
+          valid = decode_chain( pos, end, c );
+        }
+        if ( valid && pos == end && status <= static_cast<uint8_t>( entry_status::partial ) )
+        {
+          _index[{ config, tt }] = offset;
+        }
+      }
+      _scanned += 8u + payload_size;
+    }
+  }
+
+#if !defined( _WIN32 ) && !defined( _WIN64 )
+  void refresh_locked()
+  {
+    int const fd = ::open( _filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+      return;
+    }
+    struct stat st;
+    if ( ::fstat( fd, &st ) == 0 && static_cast<uint64_t>( st.st_size ) > _size )
+    {
+      unmap();
+      void* data = ::mmap( nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+      if ( data != MAP_FAILED )
+      {
+        _data = static_cast<char const*>( data );
+        _size = st.st_size;
+        scan();
+      }
+    }
+    ::close( fd );
+  }
+
+  void unmap()
+  {
+    if ( _data != nullptr )
+    {
+      ::munmap( const_cast<char*>( _data ), _size );
+      _data = nullptr;
+    }
+    _size = 0u;
+  }
+
+  void append( std::string const& record )
+  {
+    int const fd = ::open( _filename.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644 );
+    if ( fd < 0 )
+    {
+      return;
+    }
+    if ( ::flock( fd, LOCK_EX ) == 0 )
+    {
+      std::string buffer;
+      struct stat st;
+      if ( ::fstat( fd, &st ) == 0 && st.st_size == 0 )
+      {
+        buffer.append( magic, sizeof( magic ) );
+      }
+      buffer += record;
+      [[maybe_unused]] auto const written = ::write( fd, buffer.data(), buffer.size() );
+      ::flock( fd, LOCK_UN );
+    }
+    ::close( fd );
+  }
+#else
+  void refresh_locked()
+  {
+    std::ifstream in( _filename, std::ios::binary );
+    if ( !in )
+    {
+      return;
+    }
+    std::string contents( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+    if ( contents.size() > _size )
+    {
+      _buffer = std::move( contents );
+      _data = _buffer.data();
+      _size = _buffer.size();
+      scan();
+    }
+  }
+
+  void unmap()
+  {
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0u;
+  }
+
+  void append( std::string const& record )
+  {
+    std::ofstream out( _filename, std::ios::binary | std::ios::app );
+    if ( out.tellp() == 0 )
+    {
+      out.write( magic, sizeof( magic ) );
+    }
+    out.write( record.data(), record.size() );
+  }
+
+  std::string _buffer;
+#endif
+
+private:
+  std::string const _filename;
+  char const* _data{ nullptr };
+  uint64_t _size{ 0u };
+  uint64_t _scanned{ 0u };
+  std::unordered_map<std::pair<uint64_t, kitty::dynamic_truth_table>, uint64_t, key_hash> _index;
+  std::mutex _mutex;
+
+  uint64_t _num_hits{ 0u };
+  uint64_t _num_misses{ 0u };
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,277 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file library_serialization.hpp
+  \brief Binary serialization helpers for the library caches.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../../io/genlib_reader.hpp"
+#include "../../io/super_reader.hpp"
+#include "supergate.hpp"
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/* upper bound on the length of serialized containers, protects against corrupted files */
+static constexpr uint32_t max_serialized_size = 1u << 28;
+
+template<typename T>
+inline void write_binary( std::ostream& os, T const& value )
+{
+  static_assert( std::is_trivially_copyable_v<T>, "T must be trivially copyable" );
+  os.write( reinterpret_cast<char const*>( &value ), sizeof( T ) );
+}
+
+/* reads from the stream buffer directly, avoiding the overhead of `std::istream::read` on small values */
+inline bool read_bytes( std::istream& is, char* data, std::size_t size )
+{
+  if ( static_cast<std::size_t>( is.rdbuf()->sgetn( data, size ) ) != size )
+  {
+    is.setstate( std::ios::failbit );
+    return false;
+  }
+  return true;
+}
+
+template<typename T>
+inline bool read_binary( std::istream& is, T& value )
+{
+  static_assert( std::is_trivially_copyable_v<T>, "T must be trivially copyable" );
+  return read_bytes( is, reinterpret_cast<char*>( &value ), sizeof( T ) );
+}
+
+inline void write_binary( std::ostream& os, std::string const& s )
+{
+  write_binary( os, static_cast<uint32_t>( s.size() ) );
+  os.write( s.data(), s.size() );
+}
+
+inline bool read_binary( std::istream& is, std::string& s )
+{
+  uint32_t size;
+  if ( !read_binary( is, size ) || size > max_serialized_size )
+    return false;
+  s.resize( size );
+  return read_bytes( is, s.data(), size );
+}
+
+template<typename T>
+inline void write_binary( std::ostream& os, std::vector<T> const& v )
+{
+  write_binary( os, static_cast<uint32_t>( v.size() ) );
+  if constexpr ( std::is_trivially_copyable_v<T> )
+  {
+    os.write( reinterpret_cast<char const*>( v.data() ), v.size() * sizeof( T ) );
+  }
+  else
+  {
+    for ( auto const& e : v )
+    {
+      write_binary( os, e );
+    }
+  }
+}
+
+template<typename T>
+inline bool read_binary( std::istream& is, std::vector<T>& v )
+{
+  uint32_t size;
+  if ( !read_binary( is, size ) || size > max_serialized_size )
+    return false;
+  v.resize( size );
+  if constexpr ( std::is_trivially_copyable_v<T> )
+  {
+    return read_bytes( is, reinterpret_cast<char*>( v.data() ), v.size() * sizeof( T ) );
+  }
+  else
+  {
+    for ( auto& e : v )
+    {
+      if ( !read_binary( is, e ) )
+        return false;
+    }
+    return true;
+  }
+}
+
+inline void write_binary( std::ostream& os, kitty::dynamic_truth_table const& tt )
+{
+  write_binary( os, static_cast<uint32_t>( tt.num_vars() ) );
+  for ( auto const& w : tt )
+  {
+    write_binary( os, w );
+  }
+}
+
+/*! \brief Hashes the description of a library (FNV-1a). */
+inline uint64_t library_hash( std::string const& data )
+{
+  uint64_t h = 0xcbf29ce484222325ull;
+  for ( auto const c : data )
+  {
+    h ^= static_cast<uint8_t>( c );
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+/*! \brief Writes the fields of the gates that affect library generation. */
+inline void write_gates_description( std::ostream& os, std::vector<gate> const& gates )
+{
+  write_binary( os, static_cast<uint32_t>( gates.size() ) );
+  for ( auto const& g : gates )
+  {
+    write_binary( os, g.id );
+    write_binary( os, g.name );
+    write_binary( os, g.expression );
+    write_binary( os, g.num_vars );
+    write_binary( os, g.function );
+    write_binary( os, g.area );
+    write_binary( os, g.output_name );
+    write_binary( os, static_cast<uint32_t>( g.pins.size() ) );
+    for ( auto const& p : g.pins )
+    {
+      write_binary( os, p.name );
+      write_binary( os, static_cast<uint8_t>( p.phase ) );
+      write_binary( os, p.input_load );
+      write_binary( os, p.max_load );
+      write_binary( os, p.rise_block_delay );
+      write_binary( os, p.rise_fanout_delay );
+      write_binary( os, p.fall_block_delay );
+      write_binary( os, p.fall_fanout_delay );
+    }
+  }
+}
+
+/*! \brief Writes the supergates specification. */
+inline void write_super_description( std::ostream& os, super_lib const& spec )
+{
+  write_binary( os, spec.genlib_name );
+  write_binary( os, spec.max_num_vars );
+  write_binary( os, spec.num_supergates );
+  write_binary( os, spec.num_lines );
+  write_binary( os, static_cast<uint32_t>( spec.supergates.size() ) );
+  for ( auto const& s : spec.supergates )
+  {
+    write_binary( os, s.id );
+    write_binary( os, s.name );
+    write_binary( os, s.is_super );
+    write_binary( os, s.fanin_id );
+  }
+}
+
+/*! \brief Writes a supergate, `index_of` maps its root to an integer. */
+template<unsigned NInputs, typename IndexFn>
+inline void write_supergate( std::ostream& os, supergate<NInputs> const& sg, IndexFn&& index_of )
+{
+  write_binary( os, static_cast<uint32_t>( index_of( sg.root ) ) );
+  write_binary( os, sg.area );
+  write_binary( os, sg.tdelay );
+  write_binary( os, sg.permutation );
+  write_binary( os, sg.polarity );
+}
+
+/*! \brief Reads a supergate, its root index refers to `roots`. */
+template<unsigned NInputs>
+inline bool read_supergate( std::istream& is, supergate<NInputs>& sg, std::vector<composed_gate<NInputs> const*> const& roots )
+{
+  uint32_t index;
+  if ( !read_binary( is, index ) || index >= roots.size() )
+    return false;
+  sg.root = roots[index];
+  return read_binary( is, sg.area ) && read_binary( is, sg.tdelay ) && read_binary( is, sg.permutation ) && read_binary( is, sg.polarity );
+}
+
+/*! \brief Opens a library cache file and checks its header. */
+inline bool open_library_cache( std::ifstream& is, std::string const& filename, char const ( &magic )[8], uint32_t version, uint64_t key )
+{
+  is.open( filename, std::ios::binary );
+  if ( !is )
+    return false;
+
+  char file_magic[8];
+  uint32_t file_version;
+  uint64_t file_key;
+  if ( !is.read( file_magic, sizeof( file_magic ) ) || !read_binary( is, file_version ) || !read_binary( is, file_key ) )
+    return false;
+  return std::memcmp( file_magic, magic, sizeof( file_magic ) ) == 0 && file_version == version && file_key == key;
+}
+
+/*! \brief Writes a library cache file.
+ *
+ * The content is written to a temporary file that replaces `filename`
+ * once complete, such that concurrent readers never see partial data.
+ */
+template<typename Fn>
+inline bool write_library_cache( std::string const& filename, char const ( &magic )[8], uint32_t version, uint64_t key, Fn&& write_content )
+{
+  std::string const tmp_filename = filename + ".tmp";
+  {
+    std::ofstream os( tmp_filename, std::ios::binary | std::ios::trunc );
+    if ( !os )
+      return false;
+    os.write( magic, sizeof( magic ) );
+    write_binary( os, version );
+    write_binary( os, key );
+    if ( !write_content( os ) || !os.flush() )
+    {
+      os.close();
+      std::remove( tmp_filename.c_str() );
+      return false;
+    }
+  }
+
+  if ( std::rename( tmp_filename.c_str(), filename.c_str() ) != 0 )
+  {
+    /* some platforms do not replace existing files */
+    std::remove( filename.c_str() );
+    if ( std::rename( tmp_filename.c_str(), filename.c_str() ) != 0 )
+    {
+      std::remove( tmp_filename.c_str() );
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace detail
+
+} // namespace mockturtle
@@ -0,0 +1,389 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compiled_simulator.hpp
+  \brief Straight-line programs for repeated simulation of index lists and networks.
+*/
+
+#pragma once
+
+#include "../../traits.hpp"
+#include "../node_map.hpp"
+#include "../simd_kernels.hpp"
+#include "index_list.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Straight-line program for bit-parallel simulation.
+ *
+ * A program is a sequence of instructions over dense slots.  Slot 0 holds
+ * the constant 0, slots 1 to `num_inputs` hold the inputs, and instruction
+ * `i` writes slot `num_inputs + 1 + i`.  Each operand is a slot index with
+ * its complement flag resolved at compile time, such that no node type
+ * checks or literal decoding are needed when the program is executed.
+ *
+ * Programs are created with `compile` from an `xag_index_list`, a
+ * `mig_index_list`, or a network, and executed by `compiled_simulator`.
+ */
+struct straight_line_program
+{
+  enum class opcode : uint8_t
+  {
+    and2,
+    xor2,
+    maj3,
+    xor3
+  };
+
+  struct instruction
+  {
+    opcode op;
+    /*! \brief Bit `i` is set if operand `i` is complemented. */
+    uint8_t complements;
+    uint32_t operands[3];
+  };
+
+  uint32_t num_inputs{ 0u };
+  std::vector<instruction> instructions;
+  /*! \brief Output literals (`2 * slot + complement`). */
+  std::vector<uint32_t> outputs;
+
+  uint32_t num_slots() const
+  {
+    return num_inputs + 1u + static_cast<uint32_t>( instructions.size() );
+  }
+
+  uint32_t num_outputs() const
+  {
+    return static_cast<uint32_t>( outputs.size() );
+  }
+
+  /*! \brief Appends an instruction on literals (`2 * slot + complement`) and returns the literal of its result. */
+  uint32_t add_instruction( opcode op, uint32_t lit0, uint32_t lit1, uint32_t lit2 = 0u )
+  {
+    instructions.push_back( { op, static_cast<uint8_t>( ( lit0 & 1u ) | ( ( lit1 & 1u ) << 1u ) | ( ( lit2 & 1u ) << 2u ) ), { lit0 >> 1u, lit1 >> 1u, lit2 >> 1u } } );
+    return ( num_slots() - 1u ) << 1u;
+  }
+};
+
+/*! \brief Compiles an XAG index list into a straight-line program. */
+template<bool separate_header>
+straight_line_program compile( xag_index_list<separate_header> const& list )
+{
+  using opcode = straight_line_program::opcode;
+
+  straight_line_program prog;
+  prog.num_inputs = static_cast<uint32_t>( list.num_pis() );
+  prog.instructions.reserve( list.num_gates() );
+
+  auto const to_lit = [&]( auto const& lit ) {
+    return ( list.get_index( lit ) << 1u ) | static_cast<uint32_t>( list.is_complemented( lit ) );
+  };
+  list.foreach_gate( [&]( auto const& lit0, auto const& lit1 ) {
+    prog.add_instruction( list.is_and( lit0, lit1 ) ? opcode::and2 : opcode::xor2, to_lit( lit0 ), to_lit( lit1 ) );
+  } );
+  list.foreach_po( [&]( auto const& lit ) {
+    prog.outputs.emplace_back( to_lit( lit ) );
+  } );
+  return prog;
+}
+
+/*! \brief Compiles an MIG index list into a straight-line program. */
+inline straight_line_program compile( mig_index_list const& list )
+{
+  straight_line_program prog;
+  prog.num_inputs = static_cast<uint32_t>( list.num_pis() );
+  prog.instructions.reserve( list.num_gates() );
+
+  list.foreach_gate( [&]( uint32_t lit0, uint32_t lit1, uint32_t lit2 ) {
+    prog.add_instruction( straight_line_program::opcode::maj3, lit0, lit1, lit2 );
+  } );
+  list.foreach_po( [&]( uint32_t lit ) {
+    prog.outputs.emplace_back( lit );
+  } );
+  return prog;
+}
+
+/*! \brief Compiles a network into a straight-line program.
+ *
+ * The program inputs are the primary inputs and the program outputs are the
+ * primary outputs of the network.  Supported gates are AND, XOR (with two
+ * fanins), MAJ and XOR3 (with three fanins), hence AIGs, XAGs, MIGs, and
+ * XMGs can be compiled.  Only the transitive fanin of the primary outputs is
+ * compiled.
+ *
+ * **Required network functions:**
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `is_and`, `is_xor`, `is_maj`, `is_xor3`
+ */
+template<class Ntk>
+straight_line_program compile_network( Ntk const& ntk )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+  static_assert( has_is_and_v<Ntk>, "Ntk does not implement the is_and method" );
+  static_assert( has_is_xor_v<Ntk>, "Ntk does not implement the is_xor method" );
+  static_assert( has_is_maj_v<Ntk>, "Ntk does not implement the is_maj method" );
+  static_assert( has_is_xor3_v<Ntk>, "Ntk does not implement the is_xor3 method" );
+
+  using node = typename Ntk::node;
+  using opcode = straight_line_program::opcode;
+
+  straight_line_program prog;
+  prog.num_inputs = ntk.num_pis();
+
+  /* literal of every compiled node, 0 marks nodes not compiled yet */
+  constexpr uint32_t unmapped = 0u;
+  node_map<uint32_t, Ntk> lits( ntk, unmapped );
+
+  auto const const0 = ntk.get_node( ntk.get_constant( false ) );
+  auto const const1 = ntk.get_node( ntk.get_constant( true ) );
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    lits[n] = ( i + 1u ) << 1u;
+  } );
+
+  std::vector<node> stack;
+  auto const lit_of = [&]( auto const& f ) {
+    auto const n = ntk.get_node( f );
+    if ( n == const0 )
+    {
+      return static_cast<uint32_t>( ntk.is_complemented( f ) );
+    }
+    if ( n == const1 )
+    {
+      return static_cast<uint32_t>( !ntk.is_complemented( f ) );
+    }
+    return lits[n] ^ static_cast<uint32_t>( ntk.is_complemented( f ) );
+  };
+
+  /* compiles the transitive fanin of `root` in topological order */
+  auto const compile_cone = [&]( node const& root ) {
+    stack.push_back( root );
+    while ( !stack.empty() )
+    {
+      auto const n = stack.back();
+      if ( n == const0 || n == const1 || lits[n] != unmapped )
+      {
+        stack.pop_back();
+        continue;
+      }
+
+      bool fanins_ready = true;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        auto const fn = ntk.get_node( f );
+        if ( fn != const0 && fn != const1 && lits[fn] == unmapped )
+        {
+          stack.push_back( fn );
+          fanins_ready = false;
+        }
+      } );
+      if ( !fanins_ready )
+      {
+        continue;
+      }
+      stack.pop_back();
+
+      std::array<uint32_t, 3u> fanin_lits{};
+      auto i = 0u;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        if ( i < 3u )
+        {
+          fanin_lits[i] = lit_of( f );
+        }
+        ++i;
+      } );
+
+      auto const fanin_size = ntk.fanin_size( n );
+      if ( fanin_size == 3u && ntk.is_maj( n ) )
+      {
+        lits[n] = prog.add_instruction( opcode::maj3, fanin_lits[0], fanin_lits[1], fanin_lits[2] );
+      }
+      else if ( fanin_size == 3u && ntk.is_xor3( n ) )
+      {
+        lits[n] = prog.add_instruction( opcode::xor3, fanin_lits[0], fanin_lits[1], fanin_lits[2] );
+      }
+      else if ( fanin_size == 2u && ntk.is_and( n ) )
+      {
+        lits[n] = prog.add_instruction( opcode::and2, fanin_lits[0], fanin_lits[1] );
+      }
+      else if ( fanin_size == 2u && ntk.is_xor( n ) )
+      {
+        lits[n] = prog.add_instruction( opcode::xor2, fanin_lits[0], fanin_lits[1] );
+      }
+      else
+      {
+        throw std::invalid_argument( "Unsupported gate type in compile_network." );
+      }
+    }
+  };
+
+  ntk.foreach_po( [&]( auto const& f ) {
+    compile_cone( ntk.get_node( f ) );
+    prog.outputs.emplace_back( lit_of( f ) );
+  } );
+  return prog;
+}
+
+/*! \brief Interpreter for straight-line programs.
+ *
+ * Executes a `straight_line_program` on bit-parallel input patterns.  The
+ * values of all slots are kept in one contiguous buffer, which is reused
+ * across calls, and each instruction is evaluated with a tight loop over the
+ * words of its operands (vectorized with the kernels of `simd_kernels.hpp`).
+ * This makes the simulator suitable to simulate the same program many
+ * times, e.g., in pattern generation or fault simulation.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      auto const prog = compile_network( aig );
+      compiled_simulator sim;
+
+      std::vector<kitty::partial_truth_table const*> inputs = ...;
+      sim( prog, inputs );
+
+      kitty::partial_truth_table out( 1024 );
+      sim.get_output( out, prog, 0 );
+   \endverbatim
+ */
+class compiled_simulator
+{
+public:
+  using opcode = straight_line_program::opcode;
+
+  /*! \brief Executes `prog` on `num_words` words per input. */
+  void run( straight_line_program const& prog, std::vector<uint64_t const*> const& inputs, uint32_t num_words )
+  {
+    if ( prog.num_inputs != inputs.size() )
+    {
+      throw std::invalid_argument( "Mismatch between number of PIs and input simulations." );
+    }
+
+    words = num_words;
+    buffer.resize( static_cast<std::size_t>( prog.num_slots() ) * num_words );
+    std::fill_n( buffer.begin(), num_words, uint64_t( 0 ) );
+    for ( auto i = 0u; i < prog.num_inputs; ++i )
+    {
+      std::copy_n( inputs[i], num_words, slot( i + 1u ) );
+    }
+
+    auto r = slot( prog.num_inputs + 1u );
+    for ( auto const& ins : prog.instructions )
+    {
+      uint64_t const* a = slot( ins.operands[0] );
+      uint64_t const* b = slot( ins.operands[1] );
+      uint64_t const ca = simd::detail::complement_mask( ins.complements & 1u );
+      uint64_t const cb = simd::detail::complement_mask( ins.complements & 2u );
+
+      switch ( ins.op )
+      {
+      case opcode::and2:
+        simd::and2( r, a, b, num_words, ca, cb );
+        break;
+      case opcode::xor2:
+        simd::xor2( r, a, b, num_words, ca, cb );
+        break;
+      case opcode::maj3:
+        simd::maj3( r, a, b, slot( ins.operands[2] ), num_words, ca, cb, simd::detail::complement_mask( ins.complements & 4u ) );
+        break;
+      case opcode::xor3:
+      {
+        uint64_t const* c = slot( ins.operands[2] );
+        uint64_t const cm = ca ^ cb ^ simd::detail::complement_mask( ins.complements & 4u );
+        for ( auto w = 0u; w < num_words; ++w )
+        {
+          r[w] = a[w] ^ b[w] ^ c[w] ^ cm;
+        }
+      }
+      break;
+      }
+      r += num_words;
+    }
+  }
+
+  /*! \brief Executes `prog` on input truth tables.
+   *
+   * All inputs must have the same number of blocks.
+   */
+  template<class TT>
+  void operator()( straight_line_program const& prog, std::vector<TT const*> const& inputs )
+  {
+    input_words.resize( inputs.size() );
+    std::transform( inputs.begin(), inputs.end(), input_words.begin(), []( auto const* tt ) { return &*tt->cbegin(); } );
+    run( prog, input_words, inputs.empty() ? 1u : static_cast<uint32_t>( inputs.front()->num_blocks() ) );
+  }
+
+  /*! \brief Returns the words of slot `index` of the last execution. */
+  uint64_t const* slot_words( uint32_t index ) const
+  {
+    return buffer.data() + static_cast<std::size_t>( index ) * words;
+  }
+
+  /*! \brief Stores the value of output `index` of the last execution in `res`. */
+  template<class TT>
+  void get_output( TT& res, straight_line_program const& prog, uint32_t index ) const
+  {
+    assert( res.num_blocks() == words );
+    auto const lit = prog.outputs.at( index );
+    auto const* src = slot_words( lit >> 1u );
+    auto const c = simd::detail::complement_mask( lit & 1u );
+    std::transform( src, src + words, res.begin(), [c]( uint64_t w ) { return w ^ c; } );
+    res.mask_bits();
+  }
+
+private:
+  uint64_t* slot( uint32_t index )
+  {
+    return buffer.data() + static_cast<std::size_t>( index ) * words;
+  }
+
+private:
+  std::vector<uint64_t> buffer;
+  std::vector<uint64_t const*> input_words;
+  uint32_t words{ 0u };
+}; /* compiled_simulator */
+
+} /* namespace mockturtle */
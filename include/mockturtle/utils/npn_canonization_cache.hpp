@@ -0,0 +1,203 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file npn_canonization_cache.hpp
+  \brief Precomputed and cached exact NPN canonization
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/static_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Exact NPN canonization of all 4-input functions.
+ *
+ * The table maps each of the 65536 4-input truth tables to the NPN
+ * configuration returned by `kitty::exact_npn_canonization`, i.e., its
+ * representative, the input and output negations, and the permutation.
+ *
+ * The table is built once, on first use of `get()`, and is read-only
+ * afterwards, so it can be shared between threads and algorithms.
+ */
+class npn4_canonization_table
+{
+public:
+  using truth_table_t = kitty::static_truth_table<4u>;
+  using config_t = std::tuple<truth_table_t, uint32_t, std::vector<uint8_t>>;
+
+private:
+  struct entry
+  {
+    uint16_t repr;
+    uint8_t phase;
+    std::array<uint8_t, 4u> perm;
+  };
+
+  npn4_canonization_table()
+      : entries( 1u << 16u )
+  {
+    truth_table_t tt;
+    do
+    {
+      auto const [repr, phase, perm] = kitty::exact_npn_canonization( tt );
+      entries[*tt.cbegin()] = { static_cast<uint16_t>( *repr.cbegin() ), static_cast<uint8_t>( phase ), { perm[0], perm[1], perm[2], perm[3] } };
+      if ( repr == tt )
+      {
+        ++classes;
+      }
+      kitty::next_inplace( tt );
+    } while ( !kitty::is_const0( tt ) );
+  }
+
+public:
+  /*! \brief Returns the table, which is built on first use. */
+  static npn4_canonization_table const& get()
+  {
+    static npn4_canonization_table const table;
+    return table;
+  }
+
+  /*! \brief NPN configuration of a 4-input function as returned by `kitty::exact_npn_canonization`. */
+  config_t operator()( uint16_t tt ) const
+  {
+    auto const& e = entries[tt];
+    truth_table_t repr;
+    repr._bits = e.repr;
+    return { repr, e.phase, std::vector<uint8_t>( e.perm.begin(), e.perm.end() ) };
+  }
+
+  /*! \brief Truth table of the NPN representative of a 4-input function. */
+  uint16_t representative( uint16_t tt ) const
+  {
+    return entries[tt].repr;
+  }
+
+  /*! \brief Number of NPN classes (222). */
+  uint32_t num_classes() const
+  {
+    return classes;
+  }
+
+private:
+  std::vector<entry> entries;
+  uint32_t classes{ 0u };
+};
+
+/*! \brief Cache for exact NPN canonization.
+ *
+ * Drop-in replacement for `kitty::exact_npn_canonization`.  Functions with
+ * 4 variables are looked up in `npn4_canonization_table`.  For other
+ * functions, the configurations of the `capacity` most recently used
+ * functions are kept in a least-recently-used cache.
+ *
+ * The cache is not thread-safe; every thread should own its cache.
+ */
+template<class TT = kitty::dynamic_truth_table>
+class npn_canonization_cache
+{
+public:
+  using config_t = std::tuple<TT, uint32_t, std::vector<uint8_t>>;
+
+  explicit npn_canonization_cache( uint32_t capacity = 4096u )
+      : capacity( capacity ), table( npn4_canonization_table::get() )
+  {
+  }
+
+  /*! \brief NPN configuration of `tt` as returned by `kitty::exact_npn_canonization`. */
+  config_t operator()( TT const& tt )
+  {
+    if ( tt.num_vars() == 4u )
+    {
+      ++hits;
+      auto [repr, phase, perm] = table( static_cast<uint16_t>( *tt.cbegin() ) );
+      if constexpr ( std::is_same_v<TT, kitty::static_truth_table<4u>> )
+      {
+        return { repr, phase, perm };
+      }
+      else
+      {
+        TT res = tt.construct();
+        *res.begin() = *repr.cbegin();
+        return { res, phase, perm };
+      }
+    }
+
+    if ( auto it = index.find( tt ); it != index.end() )
+    {
+      ++hits;
+      entries.splice( entries.begin(), entries, it->second );
+      return it->second->second;
+    }
+
+    ++misses;
+    entries.emplace_front( tt, kitty::exact_npn_canonization( tt ) );
+    index.emplace( tt, entries.begin() );
+    if ( entries.size() > capacity )
+    {
+      index.erase( entries.back().first );
+      entries.pop_back();
+    }
+    return entries.front().second;
+  }
+
+  /*! \brief Number of lookups answered by the table or the cache. */
+  uint64_t num_hits() const
+  {
+    return hits;
+  }
+
+  /*! \brief Number of canonizations computed. */
+  uint64_t num_misses() const
+  {
+    return misses;
+  }
+
+private:
+  uint32_t capacity;
+  npn4_canonization_table const& table;
+
+  std::list<std::pair<TT, config_t>> entries;
+  std::unordered_map<TT, typename std::list<std::pair<TT, config_t>>::iterator, kitty::hash<TT>> index;
+
+  uint64_t hits{ 0u };
+  uint64_t misses{ 0u };
+};
+
+} /* namespace mockturtle */
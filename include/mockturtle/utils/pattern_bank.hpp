@@ -0,0 +1,523 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file pattern_bank.hpp
+  \brief Set of simulation patterns with scoring and compaction
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/constructors.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include "../algorithms/simulation.hpp"
+#include "../io/binary_patterns.hpp"
+#include "../traits.hpp"
+#include "node_map.hpp"
+#include "stopwatch.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for pattern_bank::compact.
+ *
+ * The data structure `pattern_bank_params` holds configurable parameters with
+ * default arguments for `pattern_bank::compact`.
+ */
+struct pattern_bank_params
+{
+  /*! \brief Maximum number of patterns to keep (0 = no limit).
+   *
+   * If more patterns split equivalence classes, the ones which split the
+   * most classes are kept.
+   */
+  uint32_t max_patterns{ 0u };
+
+  /*! \brief Whether to merge patterns with compatible care bits. */
+  bool merge_patterns{ true };
+
+  /*! \brief Random seed to fill don't-care bits. */
+  std::default_random_engine::result_type random_seed{ 1 };
+};
+
+/*! \brief Statistics for pattern_bank::compact. */
+struct pattern_bank_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of patterns merged into other patterns. */
+  uint32_t num_merged{ 0u };
+
+  /*! \brief Number of patterns dropped because they split fewer classes than others. */
+  uint32_t num_dropped{ 0u };
+
+  /*! \brief Number of equivalence classes (up to complementation) of the network nodes. */
+  uint32_t num_classes{ 0u };
+
+  void report() const
+  {
+    // clang-format off
+    fmt::print( "[i] merged patterns  = {:8d}\n", num_merged );
+    fmt::print( "[i] dropped patterns = {:8d}\n", num_dropped );
+    fmt::print( "[i] classes          = {:8d}\n", num_classes );
+    fmt::print( "[i] total time       = {:>5.2f} secs\n", to_seconds( time_total ) );
+    // clang-format on
+  }
+};
+
+/*! \brief Set of simulation patterns with care bits.
+ *
+ * A pattern bank collects simulation patterns (counter-examples,
+ * observability patterns, random patterns) for one design and keeps them
+ * small.  Like in `bit_packed_simulator`, each pattern has a care bit for
+ * every primary input.
+ *
+ * `compact` first merges patterns whose care bits do not conflict, which
+ * also removes duplicates, and fills the remaining don't-care bits
+ * randomly.  Then, it scores each pattern by the number of equivalence
+ * classes (up to complementation) of the network nodes it splits, when the
+ * patterns are applied in order, and drops the patterns which split none.
+ * The bank can be saved to and loaded from the binary pattern format (see
+ * `binary_patterns.hpp`), so that it can be reused by later runs on the
+ * same design.
+ *
+ * **Example**
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      pattern_bank bank( sim );   // partial_simulator or bit_packed_simulator
+      bank.compact( aig );
+      bank.save( "design.pat" );
+
+      partial_simulator sim2 = bank.simulator();
+   \endverbatim
+ */
+class pattern_bank
+{
+public:
+  /*! \brief Creates an empty bank for `num_pis` primary inputs. */
+  explicit pattern_bank( uint32_t num_pis )
+      : patterns( num_pis, kitty::partial_truth_table( 0u ) ),
+        care( num_pis, kitty::partial_truth_table( 0u ) )
+  {
+  }
+
+  /*! \brief Creates a bank from the patterns of a simulator, all bits are care bits. */
+  explicit pattern_bank( partial_simulator const& sim )
+      : patterns( sim.get_patterns() )
+  {
+    for ( auto const& tt : patterns )
+    {
+      care.emplace_back( ~kitty::partial_truth_table( tt.num_bits() ) );
+    }
+  }
+
+  /*! \brief Creates a bank from the patterns and care bits of a simulator. */
+  explicit pattern_bank( bit_packed_simulator const& sim )
+      : patterns( sim.get_patterns() ), care( sim.get_care() )
+  {
+  }
+
+  /*! \brief Number of primary inputs. */
+  uint32_t num_pis() const
+  {
+    return static_cast<uint32_t>( patterns.size() );
+  }
+
+  /*! \brief Number of patterns. */
+  uint32_t num_patterns() const
+  {
+    return patterns.empty() ? 0u : patterns[0].num_bits();
+  }
+
+  /*! \brief Adds a pattern in which all bits are care bits. */
+  void add_pattern( std::vector<bool> const& pattern )
+  {
+    add_pattern( pattern, std::vector<bool>( pattern.size(), true ) );
+  }
+
+  /*! \brief Adds a pattern with care bits. */
+  void add_pattern( std::vector<bool> const& pattern, std::vector<bool> const& care_bits )
+  {
+    assert( pattern.size() == patterns.size() );
+    assert( care_bits.size() == patterns.size() );
+
+    for ( auto i = 0u; i < patterns.size(); ++i )
+    {
+      patterns[i].add_bit( care_bits[i] && pattern[i] );
+      care[i].add_bit( care_bits[i] );
+    }
+  }
+
+  /*! \brief Patterns, one partial truth table per primary input. */
+  std::vector<kitty::partial_truth_table> const& get_patterns() const
+  {
+    return patterns;
+  }
+
+  /*! \brief Care bits, one partial truth table per primary input. */
+  std::vector<kitty::partial_truth_table> const& get_care() const
+  {
+    return care;
+  }
+
+  /*! \brief Returns a simulator with the patterns of the bank. */
+  partial_simulator simulator() const
+  {
+    assert( num_patterns() > 0u );
+    return partial_simulator( patterns );
+  }
+
+  /*! \brief Merges patterns whose care bits do not conflict.
+   *
+   * Every pattern is merged into the first preceding pattern which agrees
+   * with it on all primary inputs that are care bits in both patterns.
+   *
+   * \return Number of merged (removed) patterns
+   */
+  uint32_t merge()
+  {
+    auto const num = num_patterns();
+    std::vector<bool> merged( num, false );
+    std::vector<uint32_t> cared;
+    uint32_t num_merged{ 0u };
+
+    for ( int64_t p = int64_t( num ) - 1; p > 0; --p )
+    {
+      cared.clear();
+      for ( auto i = 0u; i < patterns.size(); ++i )
+      {
+        if ( kitty::get_bit( care[i], p ) )
+        {
+          cared.emplace_back( i );
+        }
+      }
+
+      /* find the first preceding pattern without conflicts, 64 candidates at a time */
+      for ( auto block = 0u; block <= ( ( p - 1 ) >> 6 ); ++block )
+      {
+        uint64_t conflicts = 0u;
+        for ( auto i : cared )
+        {
+          auto const value = kitty::get_bit( patterns[i], p ) ? ~patterns[i]._bits[block] : patterns[i]._bits[block];
+          conflicts |= care[i]._bits[block] & value;
+        }
+        if ( block == ( p >> 6 ) )
+        {
+          conflicts |= ~( ( uint64_t( 1 ) << ( p & 63 ) ) - 1u );
+        }
+        if ( conflicts == ~uint64_t( 0 ) )
+        {
+          continue;
+        }
+
+        auto const q = ( block << 6 ) + kitty::find_first_bit_in_word( ~conflicts );
+        for ( auto i : cared )
+        {
+          kitty::copy_bit( patterns[i], p, patterns[i], q );
+          kitty::set_bit( care[i], q );
+        }
+        merged[p] = true;
+        ++num_merged;
+        break;
+      }
+    }
+
+    if ( num_merged > 0u )
+    {
+      std::vector<uint32_t> kept;
+      for ( auto p = 0u; p < num; ++p )
+      {
+        if ( !merged[p] )
+        {
+          kept.emplace_back( p );
+        }
+      }
+      keep( kept );
+    }
+    return num_merged;
+  }
+
+  /*! \brief Assigns random values to all don't-care bits. */
+  void fill_dont_cares( std::default_random_engine::result_type seed = 1 )
+  {
+    for ( auto i = 0u; i < patterns.size(); ++i )
+    {
+      kitty::partial_truth_table tt( num_patterns() );
+      kitty::create_random( tt, std::default_random_engine::result_type( seed + i ) );
+      patterns[i] = ( patterns[i] & care[i] ) | ( tt & ~care[i] );
+    }
+  }
+
+  /*! \brief Scores the patterns with respect to a network.
+   *
+   * All nodes of `ntk` are simulated with all patterns.  Starting from a
+   * single class, the patterns are applied in order, and the score of a
+   * pattern is the number of new equivalence classes (up to
+   * complementation) that it creates.  As all classes are normalized with
+   * respect to the first pattern, the first pattern gets the maximum
+   * score.
+   *
+   * \param ntk Network
+   * \param num_classes (optional) Number of equivalence classes with all patterns
+   * \return One score per pattern
+   */
+  template<class Ntk>
+  std::vector<uint32_t> score( Ntk const& ntk, uint32_t* num_classes = nullptr ) const
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+
+    auto const num = num_patterns();
+    std::vector<uint32_t> scores( num, 0u );
+    if ( num == 0u )
+    {
+      return scores;
+    }
+    scores[0] = std::numeric_limits<uint32_t>::max();
+
+    /* fanin cones are simulated recursively, as the network may not be in topological order after substitutions */
+    partial_simulator const sim( patterns );
+    incomplete_node_map<kitty::partial_truth_table, Ntk> tts( ntk );
+    simulate_nodes( ntk, tts, sim, true );
+
+    std::vector<kitty::partial_truth_table const*> active;
+    ntk.foreach_node( [&]( auto const& n ) {
+      if ( tts.has( n ) )
+      {
+        active.emplace_back( &tts[n] );
+      }
+    } );
+
+    std::vector<uint32_t> classes( active.size(), 0u );
+    std::vector<uint64_t> words( active.size() );
+    std::vector<uint32_t> next;
+    uint32_t total{ 1u };
+    uint32_t current{ 1u }; /* number of non-singleton classes in `classes` */
+
+    for ( auto block = 0u; block < ( ( num + 63u ) >> 6 ) && !active.empty(); ++block )
+    {
+      for ( auto j = 0u; j < active.size(); ++j )
+      {
+        auto const& tt = *active[j];
+        words[j] = ( tt._bits[0] & 1 ) ? ~tt._bits[block] : tt._bits[block];
+      }
+
+      auto const end = std::min( 64u, num - ( block << 6 ) );
+      for ( auto b = block == 0u ? 1u : 0u; b < end; ++b )
+      {
+        next.assign( 2u * current, std::numeric_limits<uint32_t>::max() );
+        uint32_t count{ 0u };
+        for ( auto j = 0u; j < active.size(); ++j )
+        {
+          auto& id = next[2u * classes[j] + ( ( words[j] >> b ) & 1 )];
+          if ( id == std::numeric_limits<uint32_t>::max() )
+          {
+            id = count++;
+          }
+          classes[j] = id;
+        }
+        scores[( block << 6 ) + b] = count - current;
+        total += count - current;
+        current = count;
+      }
+
+      /* singleton classes cannot be split anymore */
+      std::vector<uint32_t> sizes( current, 0u );
+      for ( auto c : classes )
+      {
+        ++sizes[c];
+      }
+      std::vector<uint32_t> renumber( current, 0u );
+      current = 0u;
+      for ( auto c = 0u; c < sizes.size(); ++c )
+      {
+        renumber[c] = sizes[c] > 1u ? current++ : std::numeric_limits<uint32_t>::max();
+      }
+      auto k = 0u;
+      for ( auto j = 0u; j < active.size(); ++j )
+      {
+        if ( renumber[classes[j]] != std::numeric_limits<uint32_t>::max() )
+        {
+          active[k] = active[j];
+          classes[k++] = renumber[classes[j]];
+        }
+      }
+      active.resize( k );
+      classes.resize( k );
+    }
+
+    if ( num_classes )
+    {
+      *num_classes = total;
+    }
+    return scores;
+  }
+
+  /*! \brief Merges, scores, and drops patterns.
+   *
+   * Merges patterns (if `ps.merge_patterns` is set), fills don't-care bits
+   * randomly, and drops all patterns which split no equivalence class of
+   * the nodes in `ntk`.  If `ps.max_patterns` is set, at most that many
+   * patterns with the highest scores are kept.  The order of the kept
+   * patterns does not change.
+   *
+   * \param ntk Network
+   * \param ps Parameters
+   * \param pst Statistics
+   */
+  template<class Ntk>
+  void compact( Ntk const& ntk, pattern_bank_params const& ps = {}, pattern_bank_stats* pst = nullptr )
+  {
+    pattern_bank_stats st;
+    {
+      stopwatch t( st.time_total );
+
+      if ( ps.merge_patterns )
+      {
+        st.num_merged = merge();
+      }
+      fill_dont_cares( ps.random_seed );
+
+      auto const scores = score( ntk, &st.num_classes );
+      std::vector<uint32_t> kept;
+      for ( auto p = 0u; p < scores.size(); ++p )
+      {
+        if ( scores[p] > 0u )
+        {
+          kept.emplace_back( p );
+        }
+      }
+
+      if ( ps.max_patterns != 0u && kept.size() > ps.max_patterns )
+      {
+        std::stable_sort( kept.begin(), kept.end(), [&]( auto a, auto b ) { return scores[a] > scores[b]; } );
+        kept.resize( ps.max_patterns );
+        std::sort( kept.begin(), kept.end() );
+      }
+
+      st.num_dropped = num_patterns() - static_cast<uint32_t>( kept.size() );
+      if ( st.num_dropped > 0u )
+      {
+        keep( kept );
+      }
+    }
+
+    if ( pst )
+    {
+      *pst = st;
+    }
+  }
+
+  /*! \brief Writes the patterns to a binary pattern file.
+   *
+   * Care bits are not stored, don't-care bits are written with their
+   * current values.
+   */
+  void save( std::string const& filename ) const
+  {
+    std::ofstream os( filename, std::ofstream::out | std::ofstream::binary );
+    binary_pattern_writer writer( os, num_pis() );
+    writer.add_patterns( patterns );
+  }
+
+  /*! \brief Appends the patterns of a binary pattern file.
+   *
+   * All loaded bits are care bits.  Nothing is loaded if the file is not a
+   * valid binary pattern file or has a different number of primary inputs.
+   *
+   * \return Whether patterns were loaded
+   */
+  bool load( std::string const& filename )
+  {
+    auto const loaded = read_binary_patterns( filename );
+    if ( loaded.size() != patterns.size() || loaded.empty() )
+    {
+      return false;
+    }
+
+    auto const offset = num_patterns();
+    auto const num = loaded[0].num_bits();
+    for ( auto i = 0u; i < patterns.size(); ++i )
+    {
+      patterns[i].resize( offset + num );
+      care[i].resize( offset + num );
+      for ( auto p = 0u; p < num; ++p )
+      {
+        if ( kitty::get_bit( loaded[i], p ) )
+        {
+          kitty::set_bit( patterns[i], offset + p );
+        }
+        kitty::set_bit( care[i], offset + p );
+      }
+    }
+    return true;
+  }
+
+private:
+  /* keeps the patterns at the (increasing) positions in `kept` */
+  void keep( std::vector<uint32_t> const& kept )
+  {
+    for ( auto i = 0u; i < patterns.size(); ++i )
+    {
+      kitty::partial_truth_table values( static_cast<uint32_t>( kept.size() ) ), cares( static_cast<uint32_t>( kept.size() ) );
+      for ( auto k = 0u; k < kept.size(); ++k )
+      {
+        if ( kitty::get_bit( patterns[i], kept[k] ) )
+        {
+          kitty::set_bit( values, k );
+        }
+        if ( kitty::get_bit( care[i], kept[k] ) )
+        {
+          kitty::set_bit( cares, k );
+        }
+      }
+      patterns[i] = values;
+      care[i] = cares;
+    }
+  }
+
+private:
+  std::vector<kitty::partial_truth_table> patterns;
+  std::vector<kitty::partial_truth_table> care;
+};
+
+} // namespace mockturtle
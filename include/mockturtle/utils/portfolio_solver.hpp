@@ -0,0 +1,427 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file portfolio_solver.hpp
+  \brief Portfolio of concurrent SAT solvers sharing one CNF
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <bill/sat/interface/abc_bsat2.hpp>
+#include <bill/sat/interface/common.hpp>
+#include <bill/sat/interface/ghack.hpp>
+#include <bill/sat/interface/glucose.hpp>
+#include <bill/sat/interface/maple.hpp>
+#include <bill/sat/interface/z3.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Configuration of an additional solver in a portfolio. */
+struct portfolio_member
+{
+  /*! \brief SAT solver back-end. */
+  bill::solvers solver{ bill::solvers::bsat2 };
+
+  /*! \brief Seed for random initial phases (only `bsat2`, 0 keeps the default phases). */
+  uint32_t seed{ 0u };
+};
+
+namespace detail
+{
+
+class portfolio_member_base
+{
+public:
+  virtual ~portfolio_member_base() = default;
+
+  virtual void add_variables( uint32_t num_variables ) = 0;
+  virtual bool add_clause( std::vector<bill::lit_type> const& clause ) = 0;
+  virtual bill::result::states solve( std::vector<bill::lit_type> const& assumptions, uint32_t conflict_limit, bool resume ) = 0;
+  virtual bill::result get_model() const = 0;
+};
+
+/* continues solving a problem after the conflict limit has been reached */
+template<bill::solvers Solver, class SolverType>
+bill::result::states solve_slice( SolverType& solver, std::vector<bill::lit_type> const& assumptions, uint32_t conflict_limit, bool resume )
+{
+  /* the MiniSat-based interfaces return the state of the previous call when
+     solving again without assumptions, unless a clause has been added */
+  if ( resume && assumptions.empty() && solver.num_variables() > 0u && ( Solver == bill::solvers::glucose_41 || Solver == bill::solvers::ghack
+#if !defined( BILL_WINDOWS_PLATFORM )
+                                          || Solver == bill::solvers::maple
+#endif
+                                          ) )
+  {
+    auto const lit = bill::lit_type( 0u, bill::lit_type::polarities::positive );
+    solver.add_clause( std::vector<bill::lit_type>{ lit, ~lit } );
+  }
+  return solver.solve( assumptions, conflict_limit );
+}
+
+template<bill::solvers Solver>
+class portfolio_member_impl : public portfolio_member_base
+{
+public:
+  explicit portfolio_member_impl( uint32_t seed )
+  {
+    if constexpr ( Solver == bill::solvers::bsat2 )
+    {
+      if ( seed != 0u )
+      {
+        solver.set_random_phase( seed );
+      }
+    }
+    (void)seed;
+  }
+
+  void add_variables( uint32_t num_variables ) override
+  {
+    solver.add_variables( num_variables );
+  }
+
+  bool add_clause( std::vector<bill::lit_type> const& clause ) override
+  {
+    return solver.add_clause( clause );
+  }
+
+  bill::result::states solve( std::vector<bill::lit_type> const& assumptions, uint32_t conflict_limit, bool resume ) override
+  {
+    return solve_slice<Solver>( solver, assumptions, conflict_limit, resume );
+  }
+
+  bill::result get_model() const override
+  {
+    return solver.get_model();
+  }
+
+private:
+  bill::solver<Solver> solver;
+};
+
+inline std::unique_ptr<portfolio_member_base> make_portfolio_member( portfolio_member const& config )
+{
+  switch ( config.solver )
+  {
+  case bill::solvers::glucose_41:
+    return std::make_unique<portfolio_member_impl<bill::solvers::glucose_41>>( config.seed );
+  case bill::solvers::ghack:
+    return std::make_unique<portfolio_member_impl<bill::solvers::ghack>>( config.seed );
+#if !defined( BILL_WINDOWS_PLATFORM )
+  case bill::solvers::maple:
+    return std::make_unique<portfolio_member_impl<bill::solvers::maple>>( config.seed );
+#endif
+#if defined( BILL_HAS_Z3 )
+  case bill::solvers::z3:
+    return std::make_unique<portfolio_member_impl<bill::solvers::z3>>( config.seed );
+#endif
+  case bill::solvers::bsat2:
+  default:
+    return std::make_unique<portfolio_member_impl<bill::solvers::bsat2>>( config.seed );
+  }
+}
+
+} // namespace detail
+
+/*! \brief Portfolio of SAT solvers.
+ *
+ * This class has the interface of `bill::solver` and can be used in its
+ * place.  Variables and clauses are added to a primary solver of type
+ * `Solver`.  If additional solvers are configured, the clauses are also
+ * recorded and, once a call to `solve` is not decided by the primary solver
+ * within its first `first_slice` conflicts, every additional solver catches
+ * up on the recorded clauses and all solvers run concurrently on the same
+ * problem.  The first solver which decides the problem wins, and the others
+ * are cancelled cooperatively: they solve in slices of a growing number of
+ * conflicts and stop at the end of the current slice.  The conflict limit
+ * of `solve` applies to every solver.
+ *
+ * Different back-ends (or seeds) often behave very differently on the same
+ * hard instance, such that the portfolio is only as slow as its fastest
+ * member.  Without additional solvers, all calls are forwarded to the
+ * primary solver without overhead.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      portfolio_solver<bill::solvers::bsat2> solver( { { bill::solvers::glucose_41 }, { bill::solvers::bsat2, 42u } } );
+      auto const a = solver.add_variable();
+      ...
+      auto const res = solver.solve( { bill::lit_type( a, bill::lit_type::polarities::positive ) }, 100000u );
+   \endverbatim
+ */
+template<bill::solvers Solver = bill::solvers::bsat2>
+class portfolio_solver
+{
+public:
+  /*! \brief Number of conflicts of the primary solver before the portfolio is started. */
+  static constexpr uint32_t first_slice = 1000u;
+
+  /*! \brief Maximum number of conflicts between two checks for cancellation. */
+  static constexpr uint32_t max_slice = 16u * first_slice;
+
+  explicit portfolio_solver( std::vector<portfolio_member> const& portfolio = {} )
+      : configs( portfolio )
+  {
+    reset_members();
+  }
+
+  portfolio_solver( portfolio_solver const& ) = delete;
+  portfolio_solver& operator=( portfolio_solver const& ) = delete;
+
+  void restart()
+  {
+    primary.restart();
+    log.clear();
+    bookmarks.clear();
+    num_vars = 0u;
+    last_winner = 0u;
+    reset_members();
+  }
+
+  bill::var_type add_variable()
+  {
+    ++num_vars;
+    return primary.add_variable();
+  }
+
+  void add_variables( uint32_t num_variables = 1 )
+  {
+    num_vars += num_variables;
+    primary.add_variables( num_variables );
+  }
+
+  bool add_clause( std::vector<bill::lit_type> const& clause )
+  {
+    if ( !members.empty() )
+    {
+      log.emplace_back( clause );
+    }
+    return primary.add_clause( clause );
+  }
+
+  bool add_clause( bill::lit_type lit )
+  {
+    if ( !members.empty() )
+    {
+      log.emplace_back( std::vector<bill::lit_type>{ lit } );
+    }
+    return primary.add_clause( lit );
+  }
+
+  /*! \brief Returns the model (or core) found by the solver which decided the last call. */
+  bill::result get_model() const
+  {
+    return last_winner == 0u ? primary.get_model() : members[last_winner - 1u].solver->get_model();
+  }
+
+  bill::result::states solve( std::vector<bill::lit_type> const& assumptions = {}, uint32_t conflict_limit = 0 )
+  {
+    last_winner = 0u;
+    if ( members.empty() )
+    {
+      return primary.solve( assumptions, conflict_limit );
+    }
+
+    /* easy problems are solved without starting the portfolio */
+    auto const slice = conflict_limit == 0u ? first_slice : std::min( conflict_limit, first_slice );
+    auto const state = primary.solve( assumptions, slice );
+    if ( is_decided( state ) || conflict_limit == slice )
+    {
+      return state;
+    }
+
+    std::atomic<bool> done{ false };
+    std::vector<bill::result::states> states( members.size() + 1u, bill::result::states::undefined );
+    auto const race = [&]( uint32_t index, uint32_t budget, uint32_t next_slice, auto&& solve_fn ) {
+      while ( !done )
+      {
+        auto const limit = budget == 0u ? next_slice : std::min( budget, next_slice );
+        auto const res = solve_fn( limit );
+        if ( is_decided( res ) )
+        {
+          states[index] = res;
+          done = true;
+          return;
+        }
+        if ( budget != 0u && ( budget -= limit ) == 0u )
+        {
+          return;
+        }
+        next_slice = std::min( 2u * next_slice, max_slice );
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve( members.size() );
+    for ( auto i = 0u; i < members.size(); ++i )
+    {
+      threads.emplace_back( [&, i]() {
+        auto& member = members[i];
+        if ( !catch_up( member ) )
+        {
+          states[i + 1u] = bill::result::states::unsatisfiable;
+          done = true;
+          return;
+        }
+        bool resume = false;
+        race( i + 1u, conflict_limit, first_slice, [&]( uint32_t limit ) {
+          auto const res = member.solver->solve( assumptions, limit, resume );
+          resume = true;
+          return res;
+        } );
+      } );
+    }
+    race( 0u, conflict_limit == 0u ? 0u : conflict_limit - slice, 2u * first_slice, [&]( uint32_t limit ) {
+      return detail::solve_slice<Solver>( primary, assumptions, limit, true );
+    } );
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+
+    /* several solvers may finish in the same slice, the one with the smallest index is taken */
+    for ( auto i = 0u; i < states.size(); ++i )
+    {
+      if ( is_decided( states[i] ) )
+      {
+        last_winner = i;
+        return states[i];
+      }
+    }
+    return bill::result::states::undefined;
+  }
+
+  uint32_t num_variables() const
+  {
+    return primary.num_variables();
+  }
+
+  uint32_t num_clauses() const
+  {
+    return primary.num_clauses();
+  }
+
+  void push()
+  {
+    primary.push();
+    bookmarks.emplace_back( static_cast<uint32_t>( log.size() ), num_vars );
+  }
+
+  void pop( uint32_t num_levels = 1u )
+  {
+    primary.pop( num_levels );
+    assert( bookmarks.size() >= num_levels );
+    auto const [log_size, vars] = bookmarks[bookmarks.size() - num_levels];
+    bookmarks.resize( bookmarks.size() - num_levels );
+    log.resize( log_size );
+    num_vars = vars;
+
+    /* members cannot roll back, those which have seen the removed part start over */
+    for ( auto i = 0u; i < members.size(); ++i )
+    {
+      if ( members[i].num_clauses > log_size || members[i].num_vars > vars )
+      {
+        members[i] = member_state{ detail::make_portfolio_member( configs[i] ) };
+      }
+    }
+  }
+
+  void set_random_phase( uint32_t seed = 0u )
+  {
+    primary.set_random_phase( seed );
+  }
+
+  /*! \brief Index of the solver which decided the last call (0 is the primary solver, `i` is the `i`-th additional solver). */
+  uint32_t winner() const
+  {
+    return last_winner;
+  }
+
+private:
+  struct member_state
+  {
+    std::unique_ptr<detail::portfolio_member_base> solver;
+    uint32_t num_vars{ 0u };
+    uint32_t num_clauses{ 0u };
+    bool conflicting{ false };
+  };
+
+  static bool is_decided( bill::result::states state )
+  {
+    return state == bill::result::states::satisfiable || state == bill::result::states::unsatisfiable;
+  }
+
+  void reset_members()
+  {
+    members.clear();
+    for ( auto const& config : configs )
+    {
+      members.push_back( member_state{ detail::make_portfolio_member( config ) } );
+    }
+  }
+
+  /* adds the variables and clauses which the member has not seen yet, returns false if they are conflicting */
+  bool catch_up( member_state& member ) const
+  {
+    if ( member.num_vars < num_vars )
+    {
+      member.solver->add_variables( num_vars - member.num_vars );
+      member.num_vars = num_vars;
+    }
+    for ( ; member.num_clauses < log.size(); ++member.num_clauses )
+    {
+      if ( !member.solver->add_clause( log[member.num_clauses] ) )
+      {
+        member.conflicting = true;
+      }
+    }
+    return !member.conflicting;
+  }
+
+private:
+  bill::solver<Solver> primary;
+  std::vector<portfolio_member> configs;
+  std::vector<member_state> members;
+
+  std::vector<std::vector<bill::lit_type>> log;
+  std::vector<std::pair<uint32_t, uint32_t>> bookmarks;
+  uint32_t num_vars{ 0u };
+  uint32_t last_winner{ 0u };
+};
+
+} // namespace mockturtle
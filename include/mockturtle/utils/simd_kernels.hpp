@@ -0,0 +1,533 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file simd_kernels.hpp
+  \brief Runtime-dispatched vectorized kernels on truth tables
+
+  The kernels operate on the 64-bit words of completely specified truth
+  tables (`kitty::static_truth_table`, `kitty::dynamic_truth_table`, and
+  `kitty::partial_truth_table`).  On x86 with GCC or Clang, AVX2 and
+  AVX-512 versions are compiled next to the scalar version and the widest
+  instruction set supported by the running CPU is selected at runtime.
+  Defining `MOCKTURTLE_DISABLE_SIMD` restricts the kernels to the scalar
+  version.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <kitty/detail/constants.hpp>
+#include <kitty/traits.hpp>
+
+#if !defined( MOCKTURTLE_DISABLE_SIMD ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define MOCKTURTLE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace mockturtle
+{
+
+namespace simd
+{
+
+/*! \brief Instruction sets for which kernels are available. */
+enum class instruction_set : uint8_t
+{
+  scalar,
+  avx2,
+  avx512
+};
+
+namespace detail
+{
+
+struct scalar_ops
+{
+  using vec = uint64_t;
+  static constexpr std::size_t lanes = 1u;
+
+  static inline vec load( uint64_t const* p ) { return *p; }
+  static inline void store( uint64_t* p, vec v ) { *p = v; }
+  static inline vec set1( uint64_t w ) { return w; }
+  static inline vec and_( vec a, vec b ) { return a & b; }
+  static inline vec or_( vec a, vec b ) { return a | b; }
+  static inline vec xor_( vec a, vec b ) { return a ^ b; }
+  static inline bool is_zero( vec a ) { return a == 0u; }
+  static inline uint64_t popcount( vec a ) { return __builtin_popcountll( a ); }
+};
+
+namespace scalar
+{
+using ops = scalar_ops;
+#include "detail/simd_kernels_impl.hpp"
+} // namespace scalar
+
+#if defined( MOCKTURTLE_SIMD_X86 )
+
+#if defined( __clang__ )
+#pragma clang attribute push( __attribute__( ( target( "avx2" ) ) ), apply_to = function )
+#else
+#pragma GCC push_options
+#pragma GCC target( "avx2" )
+#endif
+
+struct avx2_ops
+{
+  using vec = __m256i;
+  static constexpr std::size_t lanes = 4u;
+
+  static inline vec load( uint64_t const* p ) { return _mm256_loadu_si256( reinterpret_cast<__m256i const*>( p ) ); }
+  static inline void store( uint64_t* p, vec v ) { _mm256_storeu_si256( reinterpret_cast<__m256i*>( p ), v ); }
+  static inline vec set1( uint64_t w ) { return _mm256_set1_epi64x( static_cast<long long>( w ) ); }
+  static inline vec and_( vec a, vec b ) { return _mm256_and_si256( a, b ); }
+  static inline vec or_( vec a, vec b ) { return _mm256_or_si256( a, b ); }
+  static inline vec xor_( vec a, vec b ) { return _mm256_xor_si256( a, b ); }
+  static inline bool is_zero( vec a ) { return _mm256_testz_si256( a, a ) != 0; }
+
+  /* nibble lookup table followed by a horizontal byte sum */
+  static inline uint64_t popcount( vec a )
+  {
+    __m256i const lut = _mm256_setr_epi8( 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                          0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 );
+    __m256i const low = _mm256_set1_epi8( 0x0f );
+    __m256i const lo = _mm256_shuffle_epi8( lut, _mm256_and_si256( a, low ) );
+    __m256i const hi = _mm256_shuffle_epi8( lut, _mm256_and_si256( _mm256_srli_epi16( a, 4 ), low ) );
+    __m256i const sums = _mm256_sad_epu8( _mm256_add_epi8( lo, hi ), _mm256_setzero_si256() );
+    return static_cast<uint64_t>( _mm256_extract_epi64( sums, 0 ) + _mm256_extract_epi64( sums, 1 ) +
+                                  _mm256_extract_epi64( sums, 2 ) + _mm256_extract_epi64( sums, 3 ) );
+  }
+};
+
+namespace avx2
+{
+using ops = avx2_ops;
+#include "detail/simd_kernels_impl.hpp"
+} // namespace avx2
+
+#if defined( __clang__ )
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined( __clang__ )
+#pragma clang attribute push( __attribute__( ( target( "avx512f,avx512bw" ) ) ), apply_to = function )
+#else
+#pragma GCC push_options
+#pragma GCC target( "avx512f,avx512bw" )
+#endif
+
+struct avx512_ops
+{
+  using vec = __m512i;
+  static constexpr std::size_t lanes = 8u;
+
+  static inline vec load( uint64_t const* p ) { return _mm512_loadu_si512( p ); }
+  static inline void store( uint64_t* p, vec v ) { _mm512_storeu_si512( p, v ); }
+  static inline vec set1( uint64_t w ) { return _mm512_set1_epi64( static_cast<long long>( w ) ); }
+  static inline vec and_( vec a, vec b ) { return _mm512_and_si512( a, b ); }
+  static inline vec or_( vec a, vec b ) { return _mm512_or_si512( a, b ); }
+  static inline vec xor_( vec a, vec b ) { return _mm512_xor_si512( a, b ); }
+  static inline bool is_zero( vec a ) { return _mm512_test_epi64_mask( a, a ) == 0; }
+
+  /* nibble lookup table followed by a horizontal byte sum */
+  static inline uint64_t popcount( vec a )
+  {
+    __m512i const lut = _mm512_set_epi64( 0x0403030203020201, 0x0302020102010100, 0x0403030203020201, 0x0302020102010100,
+                                          0x0403030203020201, 0x0302020102010100, 0x0403030203020201, 0x0302020102010100 );
+    __m512i const low = _mm512_set1_epi8( 0x0f );
+    __m512i const lo = _mm512_shuffle_epi8( lut, _mm512_and_si512( a, low ) );
+    __m512i const hi = _mm512_shuffle_epi8( lut, _mm512_and_si512( _mm512_srli_epi16( a, 4 ), low ) );
+    alignas( 64 ) uint64_t sums[8];
+    _mm512_store_si512( sums, _mm512_sad_epu8( _mm512_add_epi8( lo, hi ), _mm512_setzero_si512() ) );
+    return sums[0] + sums[1] + sums[2] + sums[3] + sums[4] + sums[5] + sums[6] + sums[7];
+  }
+};
+
+namespace avx512
+{
+using ops = avx512_ops;
+#include "detail/simd_kernels_impl.hpp"
+} // namespace avx512
+
+#if defined( __clang__ )
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* MOCKTURTLE_SIMD_X86 */
+
+/* truth tables with fewer words than this are processed by the inlined scalar kernels */
+static constexpr std::size_t dispatch_threshold = 4u;
+
+inline instruction_set& current_instruction_set();
+
+} // namespace detail
+
+/*! \brief Returns the widest instruction set supported by the running CPU. */
+inline instruction_set detect_instruction_set()
+{
+#if defined( MOCKTURTLE_SIMD_X86 )
+  __builtin_cpu_init();
+  if ( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512bw" ) )
+  {
+    return instruction_set::avx512;
+  }
+  if ( __builtin_cpu_supports( "avx2" ) )
+  {
+    return instruction_set::avx2;
+  }
+#endif
+  return instruction_set::scalar;
+}
+
+/*! \brief Returns the instruction set currently used by the kernels. */
+inline instruction_set active_instruction_set()
+{
+  return detail::current_instruction_set();
+}
+
+/*! \brief Selects the instruction set used by the kernels.
+ *
+ * Mainly useful for testing and benchmarking.  The selection is ignored if
+ * the running CPU does not support the requested instruction set.
+ *
+ * \return `true` if the requested instruction set is now active
+ */
+inline bool set_instruction_set( instruction_set isa )
+{
+  if ( static_cast<uint8_t>( isa ) > static_cast<uint8_t>( detect_instruction_set() ) )
+  {
+    return false;
+  }
+  detail::current_instruction_set() = isa;
+  return true;
+}
+
+namespace detail
+{
+
+inline instruction_set& current_instruction_set()
+{
+  static instruction_set isa = detect_instruction_set();
+  return isa;
+}
+
+inline constexpr uint64_t complement_mask( bool c )
+{
+  return c ? ~uint64_t( 0 ) : uint64_t( 0 );
+}
+
+template<class TT>
+inline uint64_t const* words( TT const& tt )
+{
+  return tt.num_blocks() == 0u ? nullptr : &*tt.cbegin();
+}
+
+template<class TT>
+inline uint64_t* words( TT& tt )
+{
+  return tt.num_blocks() == 0u ? nullptr : &*tt.begin();
+}
+
+/* mask of the valid bits in the last word of a truth table */
+template<class TT>
+inline uint64_t last_block_mask( TT const& tt )
+{
+  if constexpr ( kitty::is_complete_truth_table<TT>::value )
+  {
+    return tt.num_vars() < 6 ? kitty::detail::masks[tt.num_vars()] : ~uint64_t( 0 );
+  }
+  else
+  {
+    return ( tt.num_bits() & 0x3f ) == 0u ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( tt.num_bits() & 0x3f ) ) - 1u;
+  }
+}
+
+} // namespace detail
+
+#if defined( MOCKTURTLE_SIMD_X86 )
+#define MOCKTURTLE_SIMD_DISPATCH( n, kernel, ... )                                  \
+  if ( ( n ) >= detail::dispatch_threshold )                                        \
+  {                                                                                 \
+    switch ( detail::current_instruction_set() )                                    \
+    {                                                                               \
+    case instruction_set::avx512:                                                   \
+      return detail::avx512::kernel( __VA_ARGS__ );                                 \
+    case instruction_set::avx2:                                                     \
+      return detail::avx2::kernel( __VA_ARGS__ );                                   \
+    default:                                                                        \
+      break;                                                                        \
+    }                                                                               \
+  }                                                                                 \
+  return detail::scalar::kernel( __VA_ARGS__ )
+#else
+#define MOCKTURTLE_SIMD_DISPATCH( n, kernel, ... ) \
+  return detail::scalar::kernel( __VA_ARGS__ )
+#endif
+
+/*! \brief Word-level kernels.
+ *
+ * All kernels process `n` words.  The complement flags (`ca`, `cb`, ...) are
+ * word masks (either 0 or all ones) XOR-ed onto the respective operand.  The
+ * predicates and counts only consider the bits of the last word that are set
+ * in `last_mask`.
+ */
+inline void and2( uint64_t* r, uint64_t const* a, uint64_t const* b, std::size_t n, uint64_t ca = 0u, uint64_t cb = 0u )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, and2, r, a, b, n, ca, cb );
+}
+
+inline void xor2( uint64_t* r, uint64_t const* a, uint64_t const* b, std::size_t n, uint64_t ca = 0u, uint64_t cb = 0u )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, xor2, r, a, b, n, ca, cb );
+}
+
+inline void maj3( uint64_t* r, uint64_t const* a, uint64_t const* b, uint64_t const* c, std::size_t n, uint64_t ca = 0u, uint64_t cb = 0u, uint64_t cc = 0u )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, maj3, r, a, b, c, n, ca, cb, cc );
+}
+
+inline void mux3( uint64_t* r, uint64_t const* s, uint64_t const* t, uint64_t const* e, std::size_t n, uint64_t cs = 0u, uint64_t ct = 0u, uint64_t ce = 0u )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, mux3, r, s, t, e, n, cs, ct, ce );
+}
+
+inline void lut6( uint64_t* r, uint64_t const* const* x, uint32_t k, uint64_t func, std::size_t n )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, lut6, r, x, k, func, n );
+}
+
+inline bool and2_is_zero( uint64_t const* a, uint64_t const* b, std::size_t n, uint64_t ca, uint64_t cb, uint64_t last_mask )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, and2_is_zero, a, b, n, ca, cb, last_mask );
+}
+
+inline bool and3_is_zero( uint64_t const* a, uint64_t const* b, uint64_t const* c, std::size_t n, uint64_t ca, uint64_t cb, uint64_t cc, uint64_t last_mask )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, and3_is_zero, a, b, c, n, ca, cb, cc, last_mask );
+}
+
+inline bool and2_equal( uint64_t const* a, uint64_t const* b, uint64_t const* t, uint64_t const* care, std::size_t n, uint64_t ca, uint64_t cb, uint64_t ct, uint64_t last_mask )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, and2_equal, a, b, t, care, n, ca, cb, ct, last_mask );
+}
+
+inline bool xor2_equal( uint64_t const* a, uint64_t const* b, uint64_t const* t, uint64_t const* care, std::size_t n, uint64_t ca, uint64_t last_mask )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, xor2_equal, a, b, t, care, n, ca, last_mask );
+}
+
+inline uint64_t popcount( uint64_t const* a, std::size_t n, uint64_t last_mask )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, popcount, a, n, last_mask );
+}
+
+inline uint64_t popcount_and2( uint64_t const* a, uint64_t const* b, std::size_t n, uint64_t ca, uint64_t cb, uint64_t last_mask )
+{
+  MOCKTURTLE_SIMD_DISPATCH( n, popcount_and2, a, b, n, ca, cb, last_mask );
+}
+
+#undef MOCKTURTLE_SIMD_DISPATCH
+
+/*! \brief Computes `r = ( a ^ ca ) & ( b ^ cb )`.
+ *
+ * `r` must have the same size as `a` and `b`.
+ */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+void binary_and( TT& r, TT const& a, TT const& b, bool ca = false, bool cb = false )
+{
+  and2( detail::words( r ), detail::words( a ), detail::words( b ), a.num_blocks(), detail::complement_mask( ca ), detail::complement_mask( cb ) );
+  r.mask_bits();
+}
+
+/*! \brief Computes `r = ( a ^ ca ) ^ ( b ^ cb )`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+void binary_xor( TT& r, TT const& a, TT const& b, bool ca = false, bool cb = false )
+{
+  xor2( detail::words( r ), detail::words( a ), detail::words( b ), a.num_blocks(), detail::complement_mask( ca ), detail::complement_mask( cb ) );
+  r.mask_bits();
+}
+
+/*! \brief Computes `r = <a ^ ca, b ^ cb, c ^ cc>`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+void ternary_majority( TT& r, TT const& a, TT const& b, TT const& c, bool ca = false, bool cb = false, bool cc = false )
+{
+  maj3( detail::words( r ), detail::words( a ), detail::words( b ), detail::words( c ), a.num_blocks(),
+        detail::complement_mask( ca ), detail::complement_mask( cb ), detail::complement_mask( cc ) );
+  r.mask_bits();
+}
+
+/*! \brief Computes `r = ( s ^ cs ) ? ( t ^ ct ) : ( e ^ ce )`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+void ternary_ite( TT& r, TT const& s, TT const& t, TT const& e, bool cs = false, bool ct = false, bool ce = false )
+{
+  mux3( detail::words( r ), detail::words( s ), detail::words( t ), detail::words( e ), s.num_blocks(),
+        detail::complement_mask( cs ), detail::complement_mask( ct ), detail::complement_mask( ce ) );
+  r.mask_bits();
+}
+
+/*! \brief Evaluates a function of at most 6 variables on truth tables.
+ *
+ * Computes `r = function( *begin, ..., *( end - 1 ) )`, where the `i`-th
+ * truth table in the range is assigned to variable `i` of `function`.  All
+ * 64 bits of a word are evaluated at once by a tree of multiplexers.
+ */
+template<typename TT, typename FunctionTT, typename Iterator, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+void lut( TT& r, FunctionTT const& function, Iterator begin, Iterator end )
+{
+  std::array<uint64_t const*, 6u> fanins;
+  uint32_t k = 0u;
+  for ( ; begin != end; ++begin )
+  {
+    assert( k < 6u );
+    fanins[k++] = detail::words( *begin );
+  }
+  lut6( detail::words( r ), fanins.data(), k, *function.cbegin(), r.num_blocks() );
+  r.mask_bits();
+}
+
+/*! \brief Checks whether the intersection of two truth tables is empty.
+ *
+ * Same semantics as `kitty::intersection_is_empty`, but bits beyond the
+ * length of the truth tables are never taken into account.
+ */
+template<typename TT, bool polarity1 = true, bool polarity2 = true, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool intersection_is_empty( TT const& a, TT const& b )
+{
+  return and2_is_zero( detail::words( a ), detail::words( b ), a.num_blocks(),
+                       detail::complement_mask( !polarity1 ), detail::complement_mask( !polarity2 ), detail::last_block_mask( a ) );
+}
+
+/*! \brief Checks whether the intersection of three truth tables is empty. */
+template<typename TT, bool polarity1 = true, bool polarity2 = true, bool polarity3 = true, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool intersection_is_empty( TT const& a, TT const& b, TT const& c )
+{
+  return and3_is_zero( detail::words( a ), detail::words( b ), detail::words( c ), a.num_blocks(),
+                       detail::complement_mask( !polarity1 ), detail::complement_mask( !polarity2 ), detail::complement_mask( !polarity3 ),
+                       detail::last_block_mask( a ) );
+}
+
+/*! \brief Checks whether `( a ^ ca ) & ( b ^ cb )` is empty.
+ *
+ * Same as `intersection_is_empty` with polarities given at runtime.
+ */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool and_is_empty( TT const& a, TT const& b, bool ca, bool cb )
+{
+  return and2_is_zero( detail::words( a ), detail::words( b ), a.num_blocks(),
+                       detail::complement_mask( ca ), detail::complement_mask( cb ), detail::last_block_mask( a ) );
+}
+
+/*! \brief Checks whether `( a ^ ca ) & ( b ^ cb ) & ( c ^ cc )` is empty. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool and_is_empty( TT const& a, TT const& b, TT const& c, bool ca, bool cb, bool cc )
+{
+  return and3_is_zero( detail::words( a ), detail::words( b ), detail::words( c ), a.num_blocks(),
+                       detail::complement_mask( ca ), detail::complement_mask( cb ), detail::complement_mask( cc ),
+                       detail::last_block_mask( a ) );
+}
+
+/*! \brief Checks whether `a` implies `b`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool implies( TT const& a, TT const& b )
+{
+  return simd::intersection_is_empty<TT, true, false>( a, b );
+}
+
+/*! \brief Checks whether `( a ^ ca ) & ( b ^ cb )` equals `target ^ ct`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool and_equals( TT const& a, TT const& b, TT const& target, bool ca = false, bool cb = false, bool ct = false )
+{
+  return and2_equal( detail::words( a ), detail::words( b ), detail::words( target ), nullptr, a.num_blocks(),
+                     detail::complement_mask( ca ), detail::complement_mask( cb ), detail::complement_mask( ct ), detail::last_block_mask( a ) );
+}
+
+/*! \brief Checks whether `( a ^ ca ) & ( b ^ cb )` equals `target ^ ct` under `care`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool and_equals_under_care( TT const& a, TT const& b, TT const& target, TT const& care, bool ca = false, bool cb = false, bool ct = false )
+{
+  return and2_equal( detail::words( a ), detail::words( b ), detail::words( target ), detail::words( care ), a.num_blocks(),
+                     detail::complement_mask( ca ), detail::complement_mask( cb ), detail::complement_mask( ct ), detail::last_block_mask( a ) );
+}
+
+/*! \brief Checks whether `a ^ b ^ c` equals `target`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool xor_equals( TT const& a, TT const& b, TT const& target, bool c = false )
+{
+  return xor2_equal( detail::words( a ), detail::words( b ), detail::words( target ), nullptr, a.num_blocks(),
+                     detail::complement_mask( c ), detail::last_block_mask( a ) );
+}
+
+/*! \brief Checks whether `a ^ b ^ c` equals `target` under `care`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool xor_equals_under_care( TT const& a, TT const& b, TT const& target, TT const& care, bool c = false )
+{
+  return xor2_equal( detail::words( a ), detail::words( b ), detail::words( target ), detail::words( care ), a.num_blocks(),
+                     detail::complement_mask( c ), detail::last_block_mask( a ) );
+}
+
+/*! \brief Checks whether `a` equals `b` under `care`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+bool equal_under_care( TT const& a, TT const& b, TT const& care )
+{
+  return and2_equal( detail::words( a ), detail::words( a ), detail::words( b ), detail::words( care ), a.num_blocks(),
+                     0u, 0u, 0u, detail::last_block_mask( a ) );
+}
+
+/*! \brief Counts the ones in a truth table. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+uint64_t count_ones( TT const& a )
+{
+  return popcount( detail::words( a ), a.num_blocks(), detail::last_block_mask( a ) );
+}
+
+/*! \brief Counts the ones in the intersection of two truth tables. */
+template<typename TT, bool polarity1 = true, bool polarity2 = true, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+uint64_t count_ones_intersection( TT const& a, TT const& b )
+{
+  return popcount_and2( detail::words( a ), detail::words( b ), a.num_blocks(),
+                        detail::complement_mask( !polarity1 ), detail::complement_mask( !polarity2 ), detail::last_block_mask( a ) );
+}
+
+/*! \brief Counts the ones in `( a ^ ca ) & ( b ^ cb )`. */
+template<typename TT, typename = std::enable_if_t<kitty::is_completely_specified_truth_table<TT>::value>>
+uint64_t count_ones_and( TT const& a, TT const& b, bool ca, bool cb )
+{
+  return popcount_and2( detail::words( a ), detail::words( b ), a.num_blocks(),
+                        detail::complement_mask( ca ), detail::complement_mask( cb ), detail::last_block_mask( a ) );
+}
+
+} // namespace simd
+
+} // namespace mockturtle
@@ -50,6 +50,7 @@
 #include <parallel_hashmap/phmap.h>
 
 #include "../io/genlib_reader.hpp"
+#include "include/library_serialization.hpp"
 #include "include/supergate.hpp"
 
 namespace mockturtle
@@ -262,6 +263,58 @@ public:
     return num_large_gates;
   }
 
+  /*! \brief Writes the structural library to a binary stream.
+   *
+   * Gates are stored by index in the list of composed gates, which
+   * is regenerated from the library gates by `load`.
+   */
+  bool save( std::ostream& os ) const
+  {
+    detail::write_binary( os, static_cast<uint32_t>( _supergates.size() ) );
+    detail::write_binary( os, num_large_gates );
+
+    detail::write_binary( os, static_cast<uint32_t>( _and_table.size() ) );
+    for ( auto const& [key, id] : _and_table )
+    {
+      detail::write_binary( os, std::get<0>( key ).data );
+      detail::write_binary( os, std::get<1>( key ).data );
+      detail::write_binary( os, id );
+    }
+
+    auto const index_of = [&]( composed_gate<NInputs> const* g ) {
+      return static_cast<uint32_t>( g - _supergates.data() );
+    };
+    detail::write_binary( os, static_cast<uint32_t>( _label_to_gate.size() ) );
+    for ( auto const& [id, list] : _label_to_gate )
+    {
+      detail::write_binary( os, id );
+      detail::write_binary( os, static_cast<uint32_t>( list.size() ) );
+      for ( auto const& sg : list )
+      {
+        detail::write_supergate( os, sg, index_of );
+      }
+    }
+    return static_cast<bool>( os );
+  }
+
+  /*! \brief Reads a structural library written by `save`.
+   *
+   * Returns false and leaves the library empty if the stream does
+   * not contain a valid library for the current gates.
+   */
+  bool load( std::istream& is )
+  {
+    if ( !load_tables( is ) )
+    {
+      _supergates.clear();
+      _and_table.clear();
+      _label_to_gate.clear();
+      num_large_gates = 0;
+      return false;
+    }
+    return true;
+  }
+
   /*! \brief Print and table.
    *
    */
@@ -278,6 +331,58 @@ public:
   }
 
 private:
+  bool load_tables( std::istream& is )
+  {
+    uint32_t num_supergates, table_size;
+    if ( !detail::read_binary( is, num_supergates ) || !detail::read_binary( is, num_large_gates ) )
+      return false;
+
+    _supergates.clear();
+    if ( num_supergates > 0 )
+    {
+      _supergates.reserve( _gates.size() );
+      generate_composed_gates();
+    }
+    if ( _supergates.size() != num_supergates )
+      return false;
+
+    std::vector<composed_gate<NInputs> const*> roots;
+    roots.reserve( _supergates.size() );
+    for ( auto const& g : _supergates )
+    {
+      roots.push_back( &g );
+    }
+
+    if ( !detail::read_binary( is, table_size ) || table_size > detail::max_serialized_size )
+      return false;
+    _and_table.reserve( table_size );
+    for ( auto i = 0u; i < table_size; ++i )
+    {
+      signal l, r;
+      uint32_t id;
+      if ( !detail::read_binary( is, l.data ) || !detail::read_binary( is, r.data ) || !detail::read_binary( is, id ) )
+        return false;
+      _and_table[std::make_tuple( l, r )] = id;
+    }
+
+    if ( !detail::read_binary( is, table_size ) || table_size > detail::max_serialized_size )
+      return false;
+    for ( auto i = 0u; i < table_size; ++i )
+    {
+      uint32_t id, list_size;
+      if ( !detail::read_binary( is, id ) || !detail::read_binary( is, list_size ) || list_size > detail::max_serialized_size )
+        return false;
+      auto& list = _label_to_gate[id];
+      list.resize( list_size );
+      for ( auto& sg : list )
+      {
+        if ( !detail::read_supergate( is, sg, roots ) )
+          return false;
+      }
+    }
+    return true;
+  }
+
   void generate_library( uint32_t min_vars )
   {
     /* select and load gates */
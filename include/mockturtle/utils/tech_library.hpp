@@ -35,7 +35,13 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <cassert>
+#include <optional>
+#include <sstream>
+#include <typeinfo>
+#include <set>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -51,10 +57,14 @@
 
 #include "../io/genlib_reader.hpp"
 #include "../io/super_reader.hpp"
+#include "../traits.hpp"
+#include "include/library_serialization.hpp"
 #include "include/supergate.hpp"
+#include "npn_canonization_cache.hpp"
 #include "standard_cell.hpp"
 #include "struct_library.hpp"
 #include "super_utils.hpp"
+#include "truth_table_utils.hpp"
 
 namespace mockturtle
 {
@@ -99,6 +109,11 @@ enum class classification_type : uint32_t
   /*! \brief generate the n configurations (2^n)
    *  Direct fast matching, less quality */
   n_configurations = 2,
+
+  /*! \brief store one semi-canonical NP form per gate
+   *  Matching by semi-canonization of the function:
+   *  fast construction for large libraries */
+  sc_configurations = 3,
 };
 
 struct tech_library_params
@@ -126,6 +141,22 @@ struct tech_library_params
 
   /*! \brief reports all the entries in the library */
   bool very_verbose{ false };
+
+  /*! \brief Maximum number of candidates of the semi-canonization (SC-configurations only).
+   *
+   * Gates whose functions have more candidates are enumerated as
+   * NP-configurations.
+   */
+  uint32_t max_sc_candidates{ 256u };
+
+  /*! \brief Binary file caching the generated library (empty: no cache).
+   *
+   * The library is loaded from the file if its key matches a hash of
+   * the gates, the supergates specification, the template arguments,
+   * and the parameters affecting the generation.  Otherwise, the
+   * library is generated and the file is (re)written.
+   */
+  std::string cache_filename{};
 };
 
 namespace detail
@@ -155,7 +186,13 @@ struct tuple_tt_hash
  *
  * The configuration is selected using the template
  * parameter `Configuration`. P-configuration is suggested
- * for big libraries with few symmetric gates. The template
+ * for big libraries with few symmetric gates.
+ * SC-configuration stores each gate once, under the
+ * semi-canonical NP form of its function (see
+ * `semi_np_canonization`) together with its automorphisms,
+ * and derives the NP-configurations for a function when it
+ * is first looked up.  The lookups are cached in the
+ * library and are not thread-safe.  The template
  * parameter `NInputs` selects the maximum number of variables
  * allowed for a gate in the library.
  *
@@ -197,6 +234,15 @@ private:
   using multi_func_t = phmap::flat_hash_map<uint64_t, uint64_t>;
   using struct_lib_t = phmap::flat_hash_map<uint32_t, supergates_list_t>;
 
+  struct sc_entry
+  {
+    composed_gate<NInputs> const* root;
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> configs;
+  };
+  using sc_lib_t = phmap::flat_hash_map<TT, std::vector<sc_entry>, tt_hash>;
+  using sc_matches_t = std::unordered_map<TT, supergates_list_t, tt_hash>;
+  using sc_signatures_t = std::bitset<( truth_table_size + 1u ) * ( ( 1u << truth_table_size ) + 1u )>;
+
 public:
   explicit tech_library( std::vector<gate> const& gates, tech_library_params const ps = {}, super_lib const& supergates_spec = {} )
       : _gates( gates ),
@@ -212,15 +258,7 @@ public:
   {
     static_assert( NInputs < 16, "The technology library database supports NInputs up to 15\n" );
 
-    generate_library();
-
-    if ( ps.load_multioutput_gates )
-      generate_multioutput_library();
-
-    if ( ps.load_large_gates )
-    {
-      _struct.construct( 2 );
-    }
+    initialize();
   }
 
   explicit tech_library( std::vector<gate> const& gates, super_lib const& supergates_spec, tech_library_params const ps = {} )
@@ -237,15 +275,7 @@ public:
   {
     static_assert( NInputs < 16, "The technology library database supports NInputs up to 15\n" );
 
-    generate_library();
-
-    if ( ps.load_multioutput_gates )
-      generate_multioutput_library();
-
-    if ( ps.load_large_gates )
-    {
-      _struct.construct( 2 );
-    }
+    initialize();
   }
 
   tech_library ( const tech_library& ) = delete;
@@ -258,6 +288,11 @@ public:
    */
   const supergates_list_t* get_supergates( TT const& tt ) const
   {
+    if constexpr ( Configuration == classification_type::sc_configurations )
+    {
+      return get_supergates_sc( tt );
+    }
+
     auto match = _super_lib.find( tt );
     if ( match != _super_lib.end() )
       return &match->second;
@@ -371,7 +406,268 @@ public:
     return _struct.get_struct_library().size();
   }
 
+  /*! \brief Returns true if the library has been loaded from the cache file. */
+  bool loaded_from_cache() const
+  {
+    return _loaded_from_cache;
+  }
+
 private:
+  void initialize()
+  {
+    if ( !_ps.cache_filename.empty() && load_cache() )
+    {
+      _loaded_from_cache = true;
+      return;
+    }
+
+    generate_library();
+
+    if ( _ps.load_multioutput_gates )
+      generate_multioutput_library();
+
+    if ( _ps.load_large_gates )
+    {
+      _struct.construct( 2 );
+    }
+
+    if ( !_ps.cache_filename.empty() )
+    {
+      save_cache();
+    }
+  }
+
+#pragma region Cache
+  static constexpr char cache_magic[8] = { 'M', 'T', 'T', 'E', 'C', 'H', 'L', 'B' };
+  static constexpr uint32_t cache_version = 1u;
+
+  uint64_t cache_key() const
+  {
+    std::ostringstream os;
+    detail::write_binary( os, NInputs );
+    detail::write_binary( os, static_cast<uint32_t>( Configuration ) );
+    detail::write_binary( os, truth_table_size );
+    detail::write_binary( os, _use_supergates );
+    detail::write_binary( os, _ps.load_large_gates );
+    detail::write_binary( os, _ps.load_multioutput_gates );
+    detail::write_binary( os, _ps.ignore_symmetries );
+    detail::write_binary( os, _ps.load_minimum_size_only );
+    detail::write_binary( os, _ps.remove_dominated_gates );
+    detail::write_binary( os, _ps.load_multioutput_gates_single );
+    detail::write_binary( os, _ps.max_sc_candidates );
+    detail::write_gates_description( os, _gates );
+    detail::write_super_description( os, _supergates_spec );
+    return detail::library_hash( os.str() );
+  }
+
+  /* composed gates are referenced by index: the supergates first, then the multi-output gates */
+  std::vector<composed_gate<NInputs> const*> composed_gates_index() const
+  {
+    std::vector<composed_gate<NInputs> const*> roots;
+    for ( auto const& g : _super.get_super_library() )
+    {
+      roots.push_back( &g );
+    }
+    for ( auto const& multi_gate : _super.get_multioutput_library() )
+    {
+      for ( auto const& g : multi_gate )
+      {
+        roots.push_back( &g );
+      }
+    }
+    return roots;
+  }
+
+  void save_cache() const
+  {
+    auto const roots = composed_gates_index();
+    std::unordered_map<composed_gate<NInputs> const*, uint32_t> index;
+    index.reserve( roots.size() );
+    for ( auto i = 0u; i < roots.size(); ++i )
+    {
+      index[roots[i]] = i;
+    }
+    auto const index_of = [&]( composed_gate<NInputs> const* g ) {
+      return index.at( g );
+    };
+    auto const write_list = [&]( std::ostream& os, supergates_list_t const& list ) {
+      detail::write_binary( os, static_cast<uint32_t>( list.size() ) );
+      for ( auto const& sg : list )
+      {
+        detail::write_supergate( os, sg, index_of );
+      }
+    };
+
+    detail::write_library_cache( _ps.cache_filename, cache_magic, cache_version, cache_key(), [&]( std::ostream& os ) {
+      detail::write_binary( os, static_cast<uint32_t>( roots.size() ) );
+      detail::write_binary( os, _inv_area );
+      detail::write_binary( os, _inv_delay );
+      detail::write_binary( os, _inv_id );
+      detail::write_binary( os, _buf_area );
+      detail::write_binary( os, _buf_delay );
+      detail::write_binary( os, _buf_id );
+      detail::write_binary( os, _max_size );
+
+      detail::write_binary( os, static_cast<uint32_t>( _super_lib.size() ) );
+      for ( auto const& [tt, list] : _super_lib )
+      {
+        detail::write_binary( os, tt );
+        write_list( os, list );
+      }
+
+      detail::write_binary( os, static_cast<uint32_t>( _multi_lib.size() ) );
+      for ( auto const& [tts, lists] : _multi_lib )
+      {
+        detail::write_binary( os, tts );
+        for ( auto const& list : lists )
+        {
+          write_list( os, list );
+        }
+      }
+
+      detail::write_binary( os, static_cast<uint32_t>( _multi_funcs.size() ) );
+      for ( auto const& [tt, func] : _multi_funcs )
+      {
+        detail::write_binary( os, tt );
+        detail::write_binary( os, func );
+      }
+
+      detail::write_binary( os, static_cast<uint32_t>( _sc_lib.size() ) );
+      for ( auto const& [tt, entries] : _sc_lib )
+      {
+        detail::write_binary( os, tt );
+        detail::write_binary( os, static_cast<uint32_t>( entries.size() ) );
+        for ( auto const& entry : entries )
+        {
+          detail::write_binary( os, index_of( entry.root ) );
+          detail::write_binary( os, static_cast<uint32_t>( entry.configs.size() ) );
+          for ( auto const& [phase, perm] : entry.configs )
+          {
+            detail::write_binary( os, phase );
+            detail::write_binary( os, perm );
+          }
+        }
+      }
+      detail::write_binary( os, _sc_signatures );
+
+      return _struct.save( os );
+    } );
+  }
+
+  bool load_cache()
+  {
+    std::ifstream is;
+    if ( !detail::open_library_cache( is, _ps.cache_filename, cache_magic, cache_version, cache_key() ) )
+      return false;
+
+    if ( !load_tables( is ) )
+    {
+      _inv_area = _inv_delay = _buf_area = _buf_delay = 0.0f;
+      _inv_id = _buf_id = UINT32_MAX;
+      _max_size = 0;
+      _super_lib.clear();
+      _multi_lib.clear();
+      _multi_funcs.clear();
+      _sc_lib.clear();
+      _sc_signatures.reset();
+      return false;
+    }
+    return true;
+  }
+
+  bool load_tables( std::istream& is )
+  {
+    auto const roots = composed_gates_index();
+    auto const read_list = [&]( supergates_list_t& list ) {
+      uint32_t size;
+      if ( !detail::read_binary( is, size ) || size > detail::max_serialized_size )
+        return false;
+      list.resize( size );
+      for ( auto& sg : list )
+      {
+        if ( !detail::read_supergate( is, sg, roots ) )
+          return false;
+      }
+      return true;
+    };
+
+    uint32_t num_roots, size;
+    if ( !detail::read_binary( is, num_roots ) || num_roots != roots.size() )
+      return false;
+    if ( !detail::read_binary( is, _inv_area ) || !detail::read_binary( is, _inv_delay ) || !detail::read_binary( is, _inv_id ) ||
+         !detail::read_binary( is, _buf_area ) || !detail::read_binary( is, _buf_delay ) || !detail::read_binary( is, _buf_id ) ||
+         !detail::read_binary( is, _max_size ) )
+      return false;
+
+    if ( !detail::read_binary( is, size ) || size > detail::max_serialized_size )
+      return false;
+    _super_lib.reserve( size );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      TT tt;
+      if ( !detail::read_binary( is, tt ) || !read_list( _super_lib[tt] ) )
+        return false;
+    }
+
+    if ( !detail::read_binary( is, size ) || size > detail::max_serialized_size )
+      return false;
+    _multi_lib.reserve( size );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      multi_relation_t tts;
+      if ( !detail::read_binary( is, tts ) )
+        return false;
+      auto& lists = _multi_lib[tts];
+      for ( auto& list : lists )
+      {
+        if ( !read_list( list ) )
+          return false;
+      }
+    }
+
+    if ( !detail::read_binary( is, size ) || size > detail::max_serialized_size )
+      return false;
+    _multi_funcs.reserve( size );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      uint64_t tt, func;
+      if ( !detail::read_binary( is, tt ) || !detail::read_binary( is, func ) )
+        return false;
+      _multi_funcs[tt] = func;
+    }
+
+    if ( !detail::read_binary( is, size ) || size > detail::max_serialized_size )
+      return false;
+    _sc_lib.reserve( size );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      TT tt;
+      uint32_t num_entries;
+      if ( !detail::read_binary( is, tt ) || !detail::read_binary( is, num_entries ) || num_entries > detail::max_serialized_size )
+        return false;
+      auto& entries = _sc_lib[tt];
+      entries.resize( num_entries );
+      for ( auto& entry : entries )
+      {
+        uint32_t root, num_configs;
+        if ( !detail::read_binary( is, root ) || root >= roots.size() || !detail::read_binary( is, num_configs ) || num_configs > detail::max_serialized_size )
+          return false;
+        entry.root = roots[root];
+        entry.configs.resize( num_configs );
+        for ( auto& [phase, perm] : entry.configs )
+        {
+          if ( !detail::read_binary( is, phase ) || !detail::read_binary( is, perm ) )
+            return false;
+        }
+      }
+    }
+    if ( !detail::read_binary( is, _sc_signatures ) )
+      return false;
+
+    return _struct.load( is );
+  }
+#pragma endregion
+
   void generate_library()
   {
     bool inv = false;
@@ -561,7 +857,26 @@ private:
           }
         };
 
-        if constexpr ( Configuration == classification_type::np_configurations )
+        std::optional<std::tuple<TT, uint32_t, std::vector<uint8_t>>> sc;
+        std::vector<std::pair<uint32_t, std::vector<uint8_t>>> sc_configs;
+        if constexpr ( Configuration == classification_type::sc_configurations )
+        {
+          /* single-input gates are enumerated as in NP mode (no input negation) */
+          if ( gate.num_vars > 1 )
+          {
+            sc = semi_np_canonization( kitty::extend_to<truth_table_size>( gate.function ), _ps.max_sc_candidates, &sc_configs );
+          }
+        }
+
+        if ( sc )
+        {
+          /* store the gate under its semi-canonical form with all configurations leading to it */
+          expand_sc_configurations( gate, std::get<0>( *sc ), sc_configs );
+          np_count += static_cast<uint32_t>( sc_configs.size() );
+          _sc_lib[std::get<0>( *sc )].push_back( { &gate, std::move( sc_configs ) } );
+          _sc_signatures[sc_signature( std::get<0>( *sc ) )] = true;
+        }
+        else if constexpr ( Configuration == classification_type::np_configurations || Configuration == classification_type::sc_configurations )
         {
           /* NP enumeration of the function */
           const auto tt = gate.function;
@@ -713,7 +1028,7 @@ private:
           }
         };
 
-        if constexpr ( Configuration == classification_type::np_configurations )
+        if constexpr ( Configuration == classification_type::np_configurations || Configuration == classification_type::sc_configurations )
         {
           /* N enumeration of the function */
           const auto tt = gate.function;
@@ -1004,15 +1319,15 @@ private:
       polarity = static_cast<uint16_t>( std::get<1>( canon ) );
     }
 
-    auto entry = _super_lib.find( tt );
-    if ( entry == _super_lib.end() )
+    auto const entry = get_supergates( tt );
+    if ( entry == nullptr )
     {
       std::cerr << fmt::format( "[i] WARNING: library does not contain cells that can implement output pin {} of the multi-output cell {}\n", pin, g.root->name );
       return false;
     }
 
     /* check delay (at least one entry must have better or equal delay) */
-    for ( auto const& sg : entry->second )
+    for ( auto const& sg : *entry )
     {
       bool valid = true;
       for ( uint32_t i = 0; i < g.num_vars; ++i )
@@ -1055,6 +1370,190 @@ private:
     return worst_delay;
   }
 
+  /* derives the configurations of the gates stored under the semi-canonical form of `tt` */
+  /* NP-invariant signature of a function: number of support variables and of minterms */
+  static uint32_t sc_signature( TT const& tt )
+  {
+    uint32_t support_size{ 0u };
+    for ( uint8_t i = 0u; i < truth_table_size; ++i )
+    {
+      support_size += kitty::has_var( tt, i ) ? 1u : 0u;
+    }
+    return support_size * ( tt.num_bits() + 1u ) + static_cast<uint32_t>( kitty::count_ones( tt ) );
+  }
+
+  /* adds the configurations obtained by permuting the pins connected to symmetric
+   * variables of the semi-canonical form if they differ in delay or polarity */
+  void expand_sc_configurations( composed_gate<NInputs> const& gate, TT const& tt_canon, std::vector<std::pair<uint32_t, std::vector<uint8_t>>>& configs ) const
+  {
+    std::vector<std::pair<uint8_t, uint8_t>> symmetric_pairs;
+    for ( uint8_t p = 0u; p + 1u < gate.num_vars; ++p )
+    {
+      for ( uint8_t q = p + 1u; q < gate.num_vars; ++q )
+      {
+        if ( kitty::is_symmetric_in( tt_canon, p, q ) )
+        {
+          symmetric_pairs.emplace_back( p, q );
+        }
+      }
+    }
+    if ( symmetric_pairs.empty() )
+    {
+      return;
+    }
+
+    /* two configurations are equivalent if they have the same pin polarity and delay on each position */
+    using config_key_t = std::vector<std::pair<uint32_t, double>>;
+    auto const key = [&]( auto const& config ) {
+      config_key_t k( gate.num_vars );
+      for ( auto p = 0u; p < gate.num_vars; ++p )
+      {
+        auto const pin = config.second[p];
+        k[p] = { ( config.first >> pin ) & 1, ( _ps.ignore_symmetries || pin >= gate.num_vars ) ? 0.0 : gate.tdelay[pin] };
+      }
+      return k;
+    };
+
+    std::set<config_key_t> visited;
+    for ( auto const& config : configs )
+    {
+      visited.insert( key( config ) );
+    }
+    for ( auto i = 0u; i < configs.size(); ++i )
+    {
+      for ( auto const& [p, q] : symmetric_pairs )
+      {
+        auto config = configs[i];
+        std::swap( config.second[p], config.second[q] );
+        if ( visited.insert( key( config ) ).second )
+        {
+          configs.push_back( std::move( config ) );
+        }
+      }
+    }
+  }
+
+  const supergates_list_t* get_supergates_sc( TT const& tt ) const
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock( _sc_mutex );
+      if ( auto const it = _sc_matches.find( tt ); it != _sc_matches.end() )
+      {
+        return it->second.empty() ? nullptr : &it->second;
+      }
+    }
+
+    /* derive the matches outside of the lock, the first thread to insert them wins */
+    supergates_list_t v;
+    derive_sc_matches( tt, v );
+
+    std::unique_lock<std::shared_mutex> lock( _sc_mutex );
+    auto const& entry = _sc_matches.try_emplace( tt, std::move( v ) ).first->second;
+    return entry.empty() ? nullptr : &entry;
+  }
+
+  void derive_sc_matches( TT const& tt, supergates_list_t& v ) const
+  {
+    if ( auto const match = _super_lib.find( tt ); match != _super_lib.end() )
+    {
+      v = match->second;
+    }
+
+    /* skip the canonization if no gate has the same number of support variables and minterms */
+    if ( !_sc_signatures[sc_signature( tt )] )
+    {
+      return;
+    }
+
+    auto const sc = semi_np_canonization( tt, _ps.max_sc_candidates );
+    if ( !sc )
+    {
+      return;
+    }
+    auto const& [tt_canon, phase, perm] = *sc;
+    auto const entries = _sc_lib.find( tt_canon );
+    if ( entries == _sc_lib.end() )
+    {
+      return;
+    }
+
+    std::array<uint8_t, truth_table_size> inv_perm;
+    for ( auto i = 0u; i < truth_table_size; ++i )
+    {
+      inv_perm[perm[i]] = i;
+    }
+
+    for ( auto const& e : entries->second )
+    {
+      for ( auto const& [e_phase, e_perm] : e.configs )
+      {
+        /* leaf j is connected to the gate pin mapped to the same variable of the canonical form */
+        supergate<NInputs> sg = { e.root,
+                                  static_cast<float>( e.root->area ),
+                                  {},
+                                  std::vector<uint8_t>( e.root->num_vars ),
+                                  0 };
+        bool valid = true;
+        for ( auto j = 0u; j < e.root->num_vars; ++j )
+        {
+          auto const pin = e_perm[inv_perm[j]];
+          if ( pin >= e.root->num_vars )
+          {
+            valid = false;
+            break;
+          }
+          sg.permutation[j] = pin;
+          sg.tdelay[j] = e.root->tdelay[pin];
+          sg.polarity |= ( ( ( phase >> j ) ^ ( e_phase >> pin ) ) & 1 ) << j;
+        }
+        if ( !valid )
+        {
+          continue;
+        }
+
+        /* ordered insert by ascending area and number of input pins */
+        auto it = std::lower_bound( v.begin(), v.end(), sg, [&]( auto const& s1, auto const& s2 ) {
+          if ( s1.area < s2.area )
+            return true;
+          if ( s1.area > s2.area )
+            return false;
+          if ( s1.root->num_vars < s2.root->num_vars )
+            return true;
+          if ( s1.root->num_vars > s2.root->num_vars )
+            return true;
+          return s1.root->id < s2.root->id;
+        } );
+
+        bool to_add = true;
+        /* search for duplicated element due to symmetries */
+        while ( it != v.end() )
+        {
+          if ( sg.root->id == it->root->id )
+          {
+            /* if already in the library exit, else ignore permutations if with equal delay cost */
+            if ( sg.polarity == it->polarity && ( _ps.ignore_symmetries || sg.tdelay == it->tdelay ) )
+            {
+              to_add = false;
+              break;
+            }
+          }
+          else
+          {
+            break;
+          }
+          ++it;
+        }
+
+        if ( to_add )
+        {
+          v.insert( it, sg );
+        }
+      }
+    }
+
+    return;
+  }
+
   bool compare_sizes( composed_gate<NInputs> const& s1, composed_gate<NInputs> const& s2 )
   {
     if ( s1.area < s2.area )
@@ -1163,6 +1662,8 @@ private:
 
   unsigned _max_size{ 0 }; /* max #fanins of the gates in the library */
 
+  bool _loaded_from_cache{ false };
+
   bool _use_supergates;
 
   std::vector<gate> const _gates;    /* collection of gates */
@@ -1171,13 +1672,17 @@ private:
 
   std::vector<standard_cell> const _cells; /* collection of standard cells */
 
-  super_utils<NInputs> _super;     /* supergates generation */
-  struct_library<NInputs> _struct; /* library for structural matching */
-  lib_t _super_lib;                /* library of enumerated gates */
-  multi_lib_t _multi_lib;          /* library of enumerated multioutput gates */
-  multi_func_t _multi_funcs;       /* enumerated functions for multioutput gates */
-  struct_lib_t _struct_lib;        /* library of gates for patterns IDs */
-};                                 /* class tech_library */
+  super_utils<NInputs> _super;      /* supergates generation */
+  struct_library<NInputs> _struct;  /* library for structural matching */
+  lib_t _super_lib;                 /* library of enumerated gates */
+  multi_lib_t _multi_lib;           /* library of enumerated multioutput gates */
+  multi_func_t _multi_funcs;        /* enumerated functions for multioutput gates */
+  struct_lib_t _struct_lib;         /* library of gates for patterns IDs */
+  sc_lib_t _sc_lib;                 /* gates by semi-canonical form */
+  sc_signatures_t _sc_signatures;   /* signatures of the semi-canonical forms */
+  mutable sc_matches_t _sc_matches; /* derived configurations by function */
+  mutable std::shared_mutex _sc_mutex; /* guards the derived configurations */
+};                                  /* class tech_library */
 
 template<typename Ntk, unsigned NInputs>
 struct exact_supergate
@@ -1217,6 +1722,15 @@ struct exact_library_params
   bool compute_dc_classes{ false };
   /* verbose */
   bool verbose{ false };
+
+  /*! \brief Binary file caching the generated library (empty: no cache).
+   *
+   * The key of the file is a hash of these parameters, of the number of
+   * inputs, and of the network type.  The rewriting function is not part
+   * of the key: use different files for different rewriting functions.
+   * The database is cached for AIGs, XAGs, MIGs, and XMGs.
+   */
+  std::string cache_filename{};
 };
 
 /*! \brief Library of graph structures for Boolean matching
@@ -1266,7 +1780,19 @@ public:
         _dc_lib()
   {
     _super_lib.reserve( 222 );
+
+    if ( !_ps.cache_filename.empty() && load_cache() )
+    {
+      _loaded_from_cache = true;
+      return;
+    }
+
     generate_library( rewriting_fn );
+
+    if ( !_ps.cache_filename.empty() )
+    {
+      save_cache();
+    }
   }
 
   template<class RewritingFn>
@@ -1357,7 +1883,273 @@ public:
     return std::make_pair( _ps.area_inverter, _ps.delay_inverter );
   }
 
+  /*! \brief Returns true if the library has been loaded from the cache file. */
+  bool loaded_from_cache() const
+  {
+    return _loaded_from_cache;
+  }
+
 private:
+#pragma region Cache
+  static constexpr char cache_magic[8] = { 'M', 'T', 'E', 'X', 'A', 'C', 'T', 'L' };
+  static constexpr uint32_t cache_version = 1u;
+  static constexpr bool cache_supported = has_is_and_v<Ntk> && has_is_xor_v<Ntk> && has_is_maj_v<Ntk> && has_is_xor3_v<Ntk> &&
+                                          has_create_and_v<Ntk> && has_create_xor_v<Ntk> && has_create_maj_v<Ntk> && has_create_xor3_v<Ntk>;
+
+  enum gate_kind : uint8_t
+  {
+    kind_and,
+    kind_xor,
+    kind_maj,
+    kind_xor3
+  };
+
+  uint64_t cache_key() const
+  {
+    std::ostringstream os;
+    detail::write_binary( os, NInputs );
+    detail::write_binary( os, std::string( typeid( Ntk ).name() ) );
+    detail::write_binary( os, _ps.area_gate );
+    detail::write_binary( os, _ps.area_inverter );
+    detail::write_binary( os, _ps.delay_gate );
+    detail::write_binary( os, _ps.delay_inverter );
+    detail::write_binary( os, _ps.np_classification );
+    detail::write_binary( os, _ps.compute_dc_classes );
+    return detail::library_hash( os.str() );
+  }
+
+  void save_cache() const
+  {
+    if constexpr ( cache_supported )
+    {
+      /* signals are stored as literals of the node order: constant, PIs, gates */
+      std::vector<uint32_t> order( _database.size(), UINT32_MAX );
+      uint32_t num_nodes = 0u;
+      order[_database.node_to_index( _database.get_node( _database.get_constant( false ) ) )] = num_nodes++;
+      _database.foreach_pi( [&]( auto const& n ) {
+        order[_database.node_to_index( n )] = num_nodes++;
+      } );
+      auto const literal = [&]( signal<Ntk> const& f ) {
+        return 2u * order[_database.node_to_index( _database.get_node( f ) )] + ( _database.is_complemented( f ) ? 1u : 0u );
+      };
+
+      std::unordered_map<supergates_list_t const*, TT> list_keys;
+      for ( auto const& [tt, list] : _super_lib )
+      {
+        list_keys[&list] = tt;
+      }
+
+      detail::write_library_cache( _ps.cache_filename, cache_magic, cache_version, cache_key(), [&]( std::ostream& os ) {
+        detail::write_binary( os, static_cast<uint32_t>( _database.num_pis() ) );
+        detail::write_binary( os, static_cast<uint32_t>( _database.num_gates() ) );
+        bool valid = true;
+        _database.foreach_gate( [&]( auto const& n ) {
+          std::vector<uint32_t> fanins;
+          _database.foreach_fanin( n, [&]( auto const& f ) {
+            fanins.push_back( literal( f ) );
+          } );
+
+          gate_kind kind;
+          if ( fanins.size() == 2u )
+          {
+            kind = _database.is_xor( n ) ? kind_xor : kind_and;
+          }
+          else if ( fanins.size() == 3u && ( _database.is_maj( n ) || _database.is_xor3( n ) ) )
+          {
+            kind = _database.is_maj( n ) ? kind_maj : kind_xor3;
+          }
+          else
+          {
+            valid = false;
+            return false;
+          }
+          detail::write_binary( os, kind );
+          for ( auto const& lit : fanins )
+          {
+            detail::write_binary( os, lit );
+          }
+          order[_database.node_to_index( n )] = num_nodes++;
+          return true;
+        } );
+        if ( !valid )
+          return false;
+
+        std::vector<uint32_t> outputs;
+        _database.foreach_po( [&]( auto const& f ) {
+          outputs.push_back( literal( f ) );
+        } );
+        detail::write_binary( os, outputs );
+
+        detail::write_binary( os, static_cast<uint32_t>( _super_lib.size() ) );
+        for ( auto const& [tt, list] : _super_lib )
+        {
+          detail::write_binary( os, tt );
+          detail::write_binary( os, static_cast<uint32_t>( list.size() ) );
+          for ( auto const& sg : list )
+          {
+            detail::write_binary( os, literal( sg.root ) );
+            detail::write_binary( os, sg.n_inputs );
+            detail::write_binary( os, sg.polarity );
+            detail::write_binary( os, sg.area );
+            detail::write_binary( os, sg.worstDelay );
+            detail::write_binary( os, sg.tdelay );
+          }
+        }
+
+        detail::write_binary( os, static_cast<uint32_t>( _dc_lib.size() ) );
+        for ( auto const& [tt, transformations] : _dc_lib )
+        {
+          detail::write_binary( os, tt );
+          detail::write_binary( os, static_cast<uint32_t>( transformations.size() ) );
+          for ( auto const& [dc, transformation] : transformations )
+          {
+            detail::write_binary( os, dc );
+            detail::write_binary( os, list_keys.at( std::get<0>( transformation ) ) );
+            detail::write_binary( os, std::get<1>( transformation ) );
+            detail::write_binary( os, std::get<2>( transformation ) );
+          }
+        }
+        return true;
+      } );
+    }
+  }
+
+  bool load_cache()
+  {
+    if constexpr ( cache_supported )
+    {
+      std::ifstream is;
+      if ( !detail::open_library_cache( is, _ps.cache_filename, cache_magic, cache_version, cache_key() ) )
+        return false;
+
+      if ( !load_tables( is ) )
+      {
+        _database = Ntk();
+        _super_lib.clear();
+        _dc_lib.clear();
+        return false;
+      }
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  bool load_tables( std::istream& is )
+  {
+    std::vector<signal<Ntk>> nodes = { _database.get_constant( false ) };
+    bool valid = true;
+    auto const get_signal = [&]( uint32_t lit ) {
+      if ( ( lit >> 1 ) >= nodes.size() )
+      {
+        valid = false;
+        return nodes[0];
+      }
+      auto const f = nodes[lit >> 1];
+      return ( lit & 1 ) ? _database.create_not( f ) : f;
+    };
+
+    uint32_t num_pis, num_gates, size;
+    if ( !detail::read_binary( is, num_pis ) || num_pis != NInputs || !detail::read_binary( is, num_gates ) || num_gates > detail::max_serialized_size )
+      return false;
+    for ( auto i = 0u; i < num_pis; ++i )
+    {
+      nodes.push_back( _database.create_pi() );
+    }
+
+    for ( auto i = 0u; i < num_gates; ++i )
+    {
+      gate_kind kind;
+      std::array<uint32_t, 3u> fanins{};
+      if ( !detail::read_binary( is, kind ) || kind > kind_xor3 )
+        return false;
+      for ( auto j = 0u; j < ( kind >= kind_maj ? 3u : 2u ); ++j )
+      {
+        if ( !detail::read_binary( is, fanins[j] ) )
+          return false;
+      }
+      auto const a = get_signal( fanins[0] );
+      auto const b = get_signal( fanins[1] );
+      auto const c = get_signal( fanins[2] );
+      if ( !valid )
+        return false;
+
+      switch ( kind )
+      {
+      case kind_and:
+        nodes.push_back( _database.create_and( a, b ) );
+        break;
+      case kind_xor:
+        nodes.push_back( _database.create_xor( a, b ) );
+        break;
+      case kind_maj:
+        nodes.push_back( _database.create_maj( a, b, c ) );
+        break;
+      case kind_xor3:
+        nodes.push_back( _database.create_xor3( a, b, c ) );
+        break;
+      }
+    }
+
+    std::vector<uint32_t> outputs;
+    if ( !detail::read_binary( is, outputs ) )
+      return false;
+    for ( auto const& lit : outputs )
+    {
+      _database.create_po( get_signal( lit ) );
+    }
+
+    if ( !detail::read_binary( is, size ) || size > detail::max_serialized_size )
+      return false;
+    for ( auto i = 0u; i < size; ++i )
+    {
+      TT tt;
+      uint32_t list_size;
+      if ( !detail::read_binary( is, tt ) || !detail::read_binary( is, list_size ) || list_size > detail::max_serialized_size )
+        return false;
+      auto& list = _super_lib[tt];
+      for ( auto j = 0u; j < list_size; ++j )
+      {
+        uint32_t root;
+        if ( !detail::read_binary( is, root ) )
+          return false;
+        exact_supergate<Ntk, NInputs> sg( get_signal( root ) );
+        if ( !detail::read_binary( is, sg.n_inputs ) || !detail::read_binary( is, sg.polarity ) || !detail::read_binary( is, sg.area ) ||
+             !detail::read_binary( is, sg.worstDelay ) || !detail::read_binary( is, sg.tdelay ) )
+          return false;
+        list.push_back( sg );
+      }
+    }
+
+    if ( !detail::read_binary( is, size ) || size > detail::max_serialized_size )
+      return false;
+    for ( auto i = 0u; i < size; ++i )
+    {
+      TT tt;
+      uint32_t num_transformations;
+      if ( !detail::read_binary( is, tt ) || !detail::read_binary( is, num_transformations ) || num_transformations > detail::max_serialized_size )
+        return false;
+      auto& transformations = _dc_lib[tt];
+      for ( auto j = 0u; j < num_transformations; ++j )
+      {
+        TT dc, key;
+        uint32_t phase;
+        std::array<uint8_t, NInputs> perm;
+        if ( !detail::read_binary( is, dc ) || !detail::read_binary( is, key ) || !detail::read_binary( is, phase ) || !detail::read_binary( is, perm ) )
+          return false;
+        auto const list = _super_lib.find( key );
+        if ( list == _super_lib.end() )
+          return false;
+        transformations.emplace_back( dc, std::make_tuple( &list->second, phase, perm ) );
+      }
+    }
+
+    return valid;
+  }
+#pragma endregion
+
   template<class RewritingFn>
   void generate_library( RewritingFn const& rewriting_fn )
   {
@@ -1372,8 +2164,17 @@ private:
     TT tt;
     do
     {
-      const auto res = kitty::exact_npn_canonization( tt );
-      classes.insert( std::get<0>( res ) );
+      if constexpr ( NInputs == 4u )
+      {
+        TT repr;
+        repr._bits = npn4_canonization_table::get().representative( static_cast<uint16_t>( *tt.cbegin() ) );
+        classes.insert( repr );
+      }
+      else
+      {
+        const auto res = kitty::exact_npn_canonization( tt );
+        classes.insert( std::get<0>( res ) );
+      }
       kitty::next_inplace( tt );
     } while ( !kitty::is_const0( tt ) );
 
@@ -1647,6 +2448,7 @@ private:
   exact_library_params const _ps;
   lib_t _super_lib;
   dc_lib_t _dc_lib;
+  bool _loaded_from_cache{ false };
 }; /* class exact_library */
 
 } // namespace mockturtle
@@ -0,0 +1,187 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file thread_pool.hpp
+  \brief Persistent worker threads for data-parallel loops
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Persistent worker threads for data-parallel loops.
+ *
+ * The pool keeps `num_threads - 1` threads alive between calls of
+ * `parallel_for`, such that many short parallel loops (e.g., one per
+ * topological level of a network) do not pay for thread creation.  The
+ * calling thread takes part in the loop as thread 0.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      thread_pool pool( 4u );
+      std::vector<uint32_t> values( 1000u );
+      pool.parallel_for( values.size(), [&]( uint64_t i, uint32_t thread_id ) {
+        values[i] = i * i;
+      } );
+   \endverbatim
+ */
+class thread_pool
+{
+public:
+  /*! \brief Creates a pool with `num_threads` threads (including the caller). */
+  explicit thread_pool( uint32_t num_threads )
+      : _num_threads( std::max( num_threads, 1u ) )
+  {
+    for ( auto id = 1u; id < _num_threads; ++id )
+    {
+      _threads.emplace_back( [this, id]() { worker( id ); } );
+    }
+  }
+
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _stop = true;
+    }
+    _start.notify_all();
+    for ( auto& t : _threads )
+    {
+      t.join();
+    }
+  }
+
+  thread_pool( thread_pool const& ) = delete;
+  thread_pool& operator=( thread_pool const& ) = delete;
+
+  /*! \brief Returns the number of threads, including the calling thread. */
+  uint32_t num_threads() const
+  {
+    return _num_threads;
+  }
+
+  /*! \brief Calls `fn( i, thread_id )` for each `i` in `[0, size)`.
+   *
+   * Indices are distributed dynamically in chunks of `grain` indices.
+   * Loops with at most `grain` indices run on the calling thread only.
+   * The function returns after all calls have finished.  `fn` must not
+   * call `parallel_for` on the same pool.
+   */
+  template<typename Fn>
+  void parallel_for( uint64_t size, Fn&& fn, uint64_t grain = 1u )
+  {
+    grain = std::max<uint64_t>( grain, 1u );
+    if ( _num_threads == 1u || size <= grain )
+    {
+      for ( uint64_t i = 0u; i < size; ++i )
+      {
+        fn( i, 0u );
+      }
+      return;
+    }
+
+    std::atomic<uint64_t> next{ 0u };
+    auto const job = [&]( uint32_t thread_id ) {
+      uint64_t begin;
+      while ( ( begin = next.fetch_add( grain ) ) < size )
+      {
+        auto const end = std::min( begin + grain, size );
+        for ( auto i = begin; i < end; ++i )
+        {
+          fn( i, thread_id );
+        }
+      }
+    };
+
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _job = job;
+      _pending = _num_threads - 1u;
+      ++_generation;
+    }
+    _start.notify_all();
+
+    job( 0u );
+
+    std::unique_lock<std::mutex> lock( _mutex );
+    _done.wait( lock, [&]() { return _pending == 0u; } );
+    _job = nullptr;
+  }
+
+private:
+  void worker( uint32_t id )
+  {
+    uint64_t generation = 0u;
+    while ( true )
+    {
+      std::function<void( uint32_t )> job;
+      {
+        std::unique_lock<std::mutex> lock( _mutex );
+        _start.wait( lock, [&]() { return _stop || _generation != generation; } );
+        if ( _stop )
+          return;
+        generation = _generation;
+        job = _job;
+      }
+
+      job( id );
+
+      {
+        std::lock_guard<std::mutex> lock( _mutex );
+        --_pending;
+      }
+      _done.notify_one();
+    }
+  }
+
+private:
+  uint32_t const _num_threads;
+  std::vector<std::thread> _threads;
+
+  std::mutex _mutex;
+  std::condition_variable _start;
+  std::condition_variable _done;
+  std::function<void( uint32_t )> _job;
+  uint64_t _generation{ 0u };
+  uint32_t _pending{ 0u };
+  bool _stop{ false };
+};
+
+} // namespace mockturtle
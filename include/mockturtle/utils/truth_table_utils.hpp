@@ -32,6 +32,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <tuple>
+#include <vector>
+
 #include <kitty/kitty.hpp>
 
 namespace mockturtle
@@ -60,4 +68,215 @@ bool can_replace_majority_fanin( TT const& fanin0, TT const& fanin1, TT const& f
   return kitty::is_const0( ( ( fanin0 ^ replacement ) & ( fanin1 ^ fanin2 ) ) );
 }
 
+/*! \brief Signature-based NP canonization of small functions.
+ *
+ * Normalizes the input phases such that the negative cofactor of each
+ * variable has at least as many minterms as the positive one, and orders
+ * the variables by decreasing size of their negative cofactors.  Variables
+ * which are not in the support are moved to the end.  The remaining ties
+ * (variables with balanced cofactors, and variables with the same signature
+ * which are not symmetric) are resolved by enumerating all candidates and
+ * taking the smallest truth table.
+ *
+ * If all candidates are enumerated, the result is the same for all
+ * NP-equivalent functions, i.e., it can be used as a key to match
+ * functions.  If there are more than `max_candidates` candidates, no form
+ * is returned.  Since the number of candidates is the same for all
+ * NP-equivalent functions, a function without form can only be
+ * NP-equivalent to functions without form.
+ *
+ * The result is returned in the format of `kitty::exact_npn_canonization`
+ * (without output negation), such that `kitty::create_from_npn_config`
+ * yields `tt`.
+ *
+ * If `all_configs` is given, all the enumerated configurations (phase and
+ * permutation) which yield the form are stored in it.  Together with the
+ * permutations of symmetric variables of the form, they give all the
+ * configurations which yield the form.
+ *
+ * \param tt Truth table with at most 6 variables
+ * \param max_candidates Maximum number of candidates to enumerate
+ * \param all_configs Optional output of all configurations yielding the form
+ */
+template<uint32_t NumVars>
+std::optional<std::tuple<kitty::static_truth_table<NumVars>, uint32_t, std::vector<uint8_t>>> semi_np_canonization( kitty::static_truth_table<NumVars> const& tt, uint32_t max_candidates = 256u, std::vector<std::pair<uint32_t, std::vector<uint8_t>>>* all_configs = nullptr )
+{
+  static_assert( NumVars <= 6u, "semi_np_canonization supports up to 6 variables" );
+  using TT = kitty::static_truth_table<NumVars>;
+
+  /* normalize the phases and compute the signatures */
+  TT t = tt;
+  uint32_t phase{ 0u };
+  uint32_t ties{ 0u };
+  uint32_t num_ties{ 0u };
+  std::array<uint32_t, NumVars> key{};
+  for ( uint8_t i = 0u; i < NumVars; ++i )
+  {
+    if ( !kitty::has_var( t, i ) )
+    {
+      continue;
+    }
+    auto const c0 = kitty::count_ones( kitty::cofactor0( t, i ) );
+    auto const c1 = kitty::count_ones( kitty::cofactor1( t, i ) );
+    if ( c1 > c0 )
+    {
+      kitty::flip_inplace( t, i );
+      phase |= 1u << i;
+    }
+    else if ( c1 == c0 )
+    {
+      ties |= 1u << i;
+      ++num_ties;
+    }
+    key[i] = 1u + static_cast<uint32_t>( std::max( c0, c1 ) );
+  }
+
+  std::array<uint8_t, NumVars> order;
+  std::iota( order.begin(), order.end(), 0u );
+  std::sort( order.begin(), order.end(), [&]( auto a, auto b ) { return key[a] > key[b] || ( key[a] == key[b] && a < b ); } );
+
+  /* groups of support variables with the same signature; symmetric
+   * variables with fixed phase share a label, such that only the distinct
+   * arrangements of the labels are enumerated */
+  struct group
+  {
+    uint32_t begin{ 0u };
+    uint32_t size{ 0u };
+    uint32_t num_labels{ 0u };
+    std::array<uint8_t, NumVars> labels{};
+    std::array<uint8_t, NumVars> label_size{};
+    std::array<std::array<uint8_t, NumVars>, NumVars> members{};
+  };
+  std::array<group, NumVars> groups;
+  uint32_t num_groups{ 0u };
+  uint64_t num_candidates = uint64_t( 1u ) << num_ties;
+  for ( auto i = 0u; i < NumVars && key[order[i]] != 0u; )
+  {
+    auto& g = groups[num_groups++];
+    g.begin = i;
+    for ( ; i < NumVars && key[order[i]] == key[order[g.begin]]; ++i )
+    {
+      auto const v = order[i];
+      auto label = g.num_labels;
+      if ( ( ( ties >> v ) & 1 ) == 0 )
+      {
+        for ( auto l = 0u; l < g.num_labels; ++l )
+        {
+          auto const w = g.members[l][0];
+          if ( ( ( ties >> w ) & 1 ) == 0 && kitty::is_symmetric_in( t, v, w ) )
+          {
+            label = l;
+            break;
+          }
+        }
+      }
+      if ( label == g.num_labels )
+      {
+        ++g.num_labels;
+      }
+      g.members[label][g.label_size[label]++] = v;
+      g.labels[g.size++] = static_cast<uint8_t>( label );
+    }
+
+    /* number of distinct arrangements of the labels */
+    uint64_t arrangements{ 1u };
+    for ( auto k = 1u; k <= g.size; ++k )
+    {
+      arrangements *= k;
+    }
+    for ( auto l = 0u; l < g.num_labels; ++l )
+    {
+      for ( auto k = 2u; k <= g.label_size[l]; ++k )
+      {
+        arrangements /= k;
+      }
+    }
+    num_candidates *= arrangements;
+    if ( num_candidates > max_candidates )
+    {
+      return std::nullopt;
+    }
+
+    std::sort( g.labels.begin(), g.labels.begin() + g.size );
+  }
+
+  TT best;
+  uint32_t best_phase{ 0u };
+  bool has_best{ false };
+  std::array<uint8_t, NumVars> perm = order;
+  std::array<uint8_t, NumVars> best_perm{};
+
+  /* move variable perm[p] to position p */
+  auto const evaluate = [&]( TT const& flipped, uint32_t flips ) {
+    auto c = flipped;
+    std::array<uint8_t, NumVars> var_at, pos_of;
+    std::iota( var_at.begin(), var_at.end(), 0u );
+    std::iota( pos_of.begin(), pos_of.end(), 0u );
+    for ( uint8_t p = 0u; p < NumVars; ++p )
+    {
+      auto const q = pos_of[perm[p]];
+      if ( q != p )
+      {
+        kitty::swap_inplace( c, p, q );
+        std::swap( var_at[p], var_at[q] );
+        pos_of[var_at[p]] = p;
+        pos_of[var_at[q]] = q;
+      }
+    }
+    if ( !has_best || c < best )
+    {
+      has_best = true;
+      best = c;
+      best_phase = phase ^ flips;
+      best_perm = perm;
+      if ( all_configs )
+      {
+        all_configs->clear();
+      }
+    }
+    if ( all_configs && c == best )
+    {
+      all_configs->emplace_back( phase ^ flips, std::vector<uint8_t>( perm.begin(), perm.end() ) );
+    }
+  };
+
+  auto const arrange = [&]( auto&& self, uint32_t index, TT const& flipped, uint32_t flips ) -> void {
+    if ( index == num_groups )
+    {
+      evaluate( flipped, flips );
+      return;
+    }
+    auto& g = groups[index];
+    do
+    {
+      std::array<uint8_t, NumVars> next{};
+      for ( auto k = 0u; k < g.size; ++k )
+      {
+        perm[g.begin + k] = g.members[g.labels[k]][next[g.labels[k]]++];
+      }
+      self( self, index + 1u, flipped, flips );
+    } while ( std::next_permutation( g.labels.begin(), g.labels.begin() + g.size ) );
+  };
+
+  /* enumerate the phases of the balanced variables */
+  for ( uint32_t flips = 0u; flips <= ties; flips = ( ( flips | ~ties ) + 1u ) & ties )
+  {
+    auto flipped = t;
+    for ( uint8_t i = 0u; i < NumVars; ++i )
+    {
+      if ( ( flips >> i ) & 1 )
+      {
+        kitty::flip_inplace( flipped, i );
+      }
+    }
+    arrange( arrange, 0u, flipped, flips );
+    if ( flips == ties )
+    {
+      break;
+    }
+  }
+
+  return std::make_tuple( best, best_phase, std::vector<uint8_t>( best_perm.begin(), best_perm.end() ) );
+}
+
 } // namespace mockturtle
\ No newline at end of file
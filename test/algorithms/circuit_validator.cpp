@@ -2,6 +2,7 @@
 
 #include <bill/sat/interface/abc_bsat2.hpp>
 #include <mockturtle/algorithms/circuit_validator.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
@@ -184,4 +185,52 @@ TEST_CASE( "Validating with ODC", "[validator]" )
   v.set_odc_levels( 2 );
   CHECK( *( v.validate( f1, false ) ) == true );
   CHECK( *( v.validate( aig.get_node( f1 ), aig.get_constant( false ) ) ) == true );
-}
\ No newline at end of file
+}
+TEST_CASE( "Validating with a portfolio of SAT solvers", "[validator]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> a( 5 ), b( 5 );
+  std::generate( a.begin(), a.end(), [&]() { return xag.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return xag.create_pi(); } );
+  auto const ab = carry_ripple_multiplier( xag, a, b );
+  auto const ba = carry_ripple_multiplier( xag, b, a );
+
+  validator_params ps;
+  ps.conflict_limit = 0;
+  ps.portfolio = { { bill::solvers::bsat2, 1u }, { bill::solvers::ghack } };
+  circuit_validator<xag_network, bill::solvers::bsat2> v( xag, ps );
+
+  for ( auto i = 0u; i < ab.size(); ++i )
+  {
+    CHECK( *( v.validate( ab[i], ba[i] ) ) == true );
+  }
+  CHECK( *( v.validate( ab[4], ba[5] ) ) == false );
+}
+
+TEST_CASE( "Retiring clauses of validation queries and deleted nodes", "[validator]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( f1, c );
+  auto const f3 = aig.create_and( b, c );
+  auto const f4 = aig.create_and( a, f3 );
+  aig.create_po( f2 );
+
+  circuit_validator v( aig );
+
+  CHECK( *( v.validate( f2, f4 ) ) == true );
+  CHECK( *( v.validate( f1, f3 ) ) == false );
+  CHECK( v.stats().num_solves == 2u );
+  CHECK( v.stats().num_encoded_nodes == 4u );
+  CHECK( v.stats().num_retired_clauses == 4u ); /* two miter clauses per query */
+
+  /* the clauses of f4 and f3 are retired when they are taken out */
+  aig.substitute_node( aig.get_node( f4 ), f2 );
+  CHECK( aig.is_dead( aig.get_node( f4 ) ) );
+  CHECK( v.stats().num_retired_clauses == 10u );
+
+  CHECK( *( v.validate( f2, aig.create_and( b, c ) ) ) == false );
+}
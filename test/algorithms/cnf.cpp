@@ -1,11 +1,14 @@
 #include <catch.hpp>
 
 #include <mockturtle/algorithms/cnf.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/utils/include/percy.hpp>
 
 #include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 
@@ -108,3 +111,84 @@ TEST_CASE( "Use CNF generation for CEC on XAG", "[cnf]" )
   const auto res = solver.solve( 0 );
   CHECK( res == percy::synth_result::failure );
 }
+
+TEST_CASE( "CNF templates of cut functions", "[cnf]" )
+{
+  detail::cnf_template_cache cache;
+
+  for ( auto num_vars = 2u; num_vars <= 5u; ++num_vars )
+  {
+    for ( auto seed = 0u; seed < 20u; ++seed )
+    {
+      kitty::dynamic_truth_table tt( num_vars );
+      kitty::create_random( tt, seed );
+
+      auto const& clauses = cache( tt );
+
+      /* the clauses are satisfied exactly if the output agrees with the function */
+      for ( auto m = 0u; m < ( 2u << num_vars ); ++m )
+      {
+        bool const output = ( m >> num_vars ) & 1;
+        bool satisfied = true;
+        for ( auto const& c : clauses )
+        {
+          bool sat_clause = false;
+          for ( auto i = 0u; i <= num_vars; ++i )
+          {
+            if ( c.get_mask( i ) && c.get_bit( i ) == ( ( m >> i ) & 1 ) )
+            {
+              sat_clause = true;
+            }
+          }
+          satisfied &= sat_clause;
+        }
+        CHECK( satisfied == ( output == kitty::get_bit( tt, m & ( ( 1u << num_vars ) - 1u ) ) ) );
+      }
+    }
+  }
+
+  /* AND functions with different input polarities share one class */
+  detail::cnf_template_cache and_cache;
+  kitty::dynamic_truth_table a( 2u ), b( 2u );
+  kitty::create_nth_var( a, 0 );
+  kitty::create_nth_var( b, 1 );
+  and_cache( a & b );
+  and_cache( ~a & b );
+  and_cache( ~( a & ~b ) );
+  CHECK( and_cache.num_classes() == 1u );
+}
+
+TEST_CASE( "Cut-based CNF for CEC on AIG", "[cnf]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4 ), b( 4 );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto const ab = carry_ripple_multiplier( aig, a, b );
+  auto const ba = carry_ripple_multiplier( aig, b, a );
+  for ( auto i = 0u; i < ab.size(); ++i )
+  {
+    aig.create_po( aig.create_xor( ab[i], ba[i] ) );
+  }
+
+  generate_cnf_params ps;
+  ps.cut_based = true;
+
+  uint32_t num_tseytin{ 0 }, num_cuts{ 0 };
+  generate_cnf( aig, [&]( auto const& clause ) { (void)clause; ++num_tseytin; } );
+
+  percy::bsat_wrapper solver;
+  auto const outputs = generate_cnf(
+      aig, [&]( auto const& clause ) {
+        solver.add_clause( clause );
+        ++num_cuts;
+      },
+      {}, ps );
+  CHECK( num_cuts < num_tseytin );
+
+  for ( auto i = 0u; i < outputs.size(); ++i )
+  {
+    int output = outputs[i];
+    CHECK( solver.solve( &output, &output + 1, 0 ) == percy::synth_result::failure );
+  }
+}
@@ -1011,4 +1011,52 @@ TEST_CASE( "Emap on circuit with don't touch cells", "[emap]" )
   CHECK( st.area < 11.0f + eps );
   CHECK( st.delay > 5.8f - eps );
   CHECK( st.delay < 5.8f + eps );
-}
\ No newline at end of file
+}
+TEST_CASE( "Emap with multiple threads", "[emap]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+  tech_library<3, classification_type::sc_configurations> lib_sc( gates );
+
+  aig_network aig;
+
+  std::vector<typename aig_network::signal> a( 8 ), b( 8 );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+
+  for ( auto const& o : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( o );
+  }
+
+  auto const check_same = []( binding_view<klut_network> const& luts1, emap_stats const& st1, binding_view<klut_network> const& luts2, emap_stats const& st2 ) {
+    CHECK( luts1.size() == luts2.size() );
+    CHECK( st1.area == st2.area );
+    CHECK( st1.delay == st2.delay );
+    luts1.foreach_gate( [&]( auto const& n ) {
+      CHECK( luts1.get_binding_index( n ) == luts2.get_binding_index( n ) );
+    } );
+  };
+
+  for ( auto const area_oriented : { false, true } )
+  {
+    emap_params ps;
+    ps.area_oriented_mapping = area_oriented;
+    emap_stats st1, st4;
+    binding_view<klut_network> luts1 = emap_klut( aig, lib, ps, &st1 );
+    ps.num_threads = 4u;
+    binding_view<klut_network> luts4 = emap_klut( aig, lib, ps, &st4 );
+    check_same( luts1, st1, luts4, st4 );
+
+    emap_stats st_sc1, st_sc4;
+    binding_view<klut_network> luts_sc4 = emap_klut( aig, lib_sc, ps, &st_sc4 );
+    ps.num_threads = 1u;
+    binding_view<klut_network> luts_sc1 = emap_klut( aig, lib_sc, ps, &st_sc1 );
+    check_same( luts_sc1, st_sc1, luts_sc4, st_sc4 );
+  }
+}
@@ -4,6 +4,8 @@
 
 #include <mockturtle/algorithms/equivalence_checking.hpp>
 #include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
 
@@ -72,3 +74,70 @@ TEST_CASE( "Equivalence check on two non-equivalent AIGs", "[equivalence_checkin
   CHECK( !*result );
   CHECK( st.counter_example == std::vector<bool>( { true, true } ) );
 }
+
+TEST_CASE( "Equivalence check with a portfolio of SAT solvers", "[equivalence_checking]" )
+{
+  /* multiplier with swapped operands, one output bit is flipped under a0 = 1 */
+  auto const multiplier = []( bool swap, bool flip ) {
+    aig_network aig;
+    std::vector<aig_network::signal> a( 6 ), b( 6 );
+    std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+    std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+    auto const outputs = swap ? carry_ripple_multiplier( aig, b, a ) : carry_ripple_multiplier( aig, a, b );
+    for ( auto i = 0u; i < outputs.size(); ++i )
+    {
+      aig.create_po( flip && i == 5u ? aig.create_xor( outputs[i], a[0] ) : outputs[i] );
+    }
+    return aig;
+  };
+
+  equivalence_checking_params ps;
+  ps.functional_reduction = false;
+  ps.portfolio = { { bill::solvers::glucose_41 }, { bill::solvers::bsat2, 1u } };
+
+  const auto miter_ntk = *miter<aig_network>( multiplier( false, false ), multiplier( true, false ) );
+  CHECK( *equivalence_checking( miter_ntk, ps ) );
+  CHECK( *equivalence_checking_bill( miter_ntk, ps ) );
+
+  const auto miter_neq = *miter<aig_network>( multiplier( false, false ), multiplier( true, true ) );
+  equivalence_checking_stats st;
+  const auto result = equivalence_checking( miter_neq, ps, &st );
+  CHECK( result );
+  CHECK( !*result );
+
+  default_simulator<bool> sim( st.counter_example );
+  CHECK( simulate<bool>( miter_neq, sim )[0] );
+}
+
+TEST_CASE( "Equivalence check with cut-based CNF", "[equivalence_checking]" )
+{
+  auto const multiplier = []( bool swap, bool flip ) {
+    xag_network xag;
+    std::vector<xag_network::signal> a( 5 ), b( 5 );
+    std::generate( a.begin(), a.end(), [&]() { return xag.create_pi(); } );
+    std::generate( b.begin(), b.end(), [&]() { return xag.create_pi(); } );
+    auto const outputs = swap ? carry_ripple_multiplier( xag, b, a ) : carry_ripple_multiplier( xag, a, b );
+    for ( auto i = 0u; i < outputs.size(); ++i )
+    {
+      xag.create_po( flip && i == 4u ? xag.create_and( outputs[i], !b[1] ) : outputs[i] );
+    }
+    return xag;
+  };
+
+  equivalence_checking_params ps;
+  ps.functional_reduction = false;
+  ps.cut_based_cnf = true;
+
+  const auto miter_ntk = *miter<xag_network>( multiplier( false, false ), multiplier( true, false ) );
+  CHECK( *equivalence_checking( miter_ntk, ps ) );
+  CHECK( *equivalence_checking_bill( miter_ntk, ps ) );
+
+  const auto miter_neq = *miter<xag_network>( multiplier( false, false ), multiplier( true, true ) );
+  equivalence_checking_stats st;
+  const auto result = equivalence_checking_bill( miter_neq, ps, &st );
+  CHECK( result );
+  CHECK( !*result );
+
+  default_simulator<bool> sim( st.counter_example );
+  CHECK( simulate<bool>( miter_neq, sim )[0] );
+}
@@ -2,6 +2,9 @@
 
 #include <kitty/static_truth_table.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/functional_reduction.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
@@ -129,3 +132,64 @@ TEST_CASE( "functional reduction on XMG", "[functional_reduction]" )
   CHECK( ntk.size() == 9 );
   CHECK( vals == simulate<kitty::static_truth_table<4>>( ntk ) );
 }
+
+TEST_CASE( "parallel functional reduction on AIG", "[functional_reduction]" )
+{
+  aig_network ntk;
+
+  std::vector<aig_network::signal> xs( 8u );
+  std::generate( xs.begin(), xs.end(), [&]() { return ntk.create_pi(); } );
+  for ( auto i = 0u; i + 1u < xs.size(); ++i )
+  {
+    const auto f1 = ntk.create_or( ntk.create_and( xs[i], !xs[i + 1] ), ntk.create_and( !xs[i], xs[i + 1] ) );  // xi ^ xi+1
+    const auto f2 = !ntk.create_or( ntk.create_and( xs[i], xs[i + 1] ), ntk.create_and( !xs[i], !xs[i + 1] ) ); // xi ^ xi+1
+    ntk.create_po( f1 );
+    ntk.create_po( ntk.create_and( f2, xs[( i + 2u ) % xs.size()] ) );
+    ntk.create_po( ntk.create_and( f1, !f2 ) ); // 0
+  }
+
+  auto vals = simulate<kitty::static_truth_table<8>>( ntk );
+
+  aig_network sequential = ntk.clone();
+  functional_reduction( sequential );
+  sequential = cleanup_dangling( sequential );
+
+  functional_reduction_params ps;
+  ps.num_threads = 4u;
+  functional_reduction_stats st;
+  functional_reduction( ntk, ps, &st );
+  ntk = cleanup_dangling( ntk );
+
+  CHECK( ntk.num_gates() == sequential.num_gates() );
+  CHECK( st.num_equ_accepts >= 7u );
+  CHECK( vals == simulate<kitty::static_truth_table<8>>( ntk ) );
+}
+
+TEST_CASE( "functional reduction with pattern compaction", "[functional_reduction]" )
+{
+  aig_network ntk;
+
+  std::vector<aig_network::signal> xs( 10u );
+  std::generate( xs.begin(), xs.end(), [&]() { return ntk.create_pi(); } );
+  for ( auto i = 0u; i + 1u < xs.size(); ++i )
+  {
+    const auto f1 = ntk.create_or( ntk.create_and( xs[i], !xs[i + 1] ), ntk.create_and( !xs[i], xs[i + 1] ) );  // xi ^ xi+1
+    const auto f2 = !ntk.create_or( ntk.create_and( xs[i], xs[i + 1] ), ntk.create_and( !xs[i], !xs[i + 1] ) ); // xi ^ xi+1
+    ntk.create_po( ntk.create_and( f1, ntk.create_and( xs[( i + 2u ) % xs.size()], xs[( i + 3u ) % xs.size()] ) ) );
+    ntk.create_po( ntk.create_and( f2, ntk.create_and( xs[( i + 2u ) % xs.size()], xs[( i + 3u ) % xs.size()] ) ) );
+  }
+
+  auto vals = simulate<kitty::static_truth_table<10>>( ntk );
+
+  /* few random patterns, so that counter-examples quickly exceed the limit */
+  functional_reduction_params ps;
+  ps.num_patterns = 4u;
+  ps.max_patterns = 8u;
+  functional_reduction_stats st;
+  functional_reduction( ntk, ps, &st );
+  ntk = cleanup_dangling( ntk );
+
+  CHECK( st.num_compactions > 0u );
+  CHECK( st.num_equ_accepts >= 9u );
+  CHECK( vals == simulate<kitty::static_truth_table<10>>( ntk ) );
+}
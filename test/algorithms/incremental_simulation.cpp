@@ -0,0 +1,99 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/incremental_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+void check_against_full_simulation( Ntk const& ntk, incremental_simulation<Ntk>& inc_sim, partial_simulator const& sim )
+{
+  unordered_node_map<kitty::partial_truth_table, Ntk> expected( ntk );
+  simulate_nodes<Ntk>( ntk, expected, sim, true );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( inc_sim[n] == expected[n] );
+  } );
+}
+
+} // namespace
+
+TEST_CASE( "Incremental simulation when adding patterns", "[incremental_simulation]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { aig.create_po( f ); } );
+
+  partial_simulator sim( aig.num_pis(), 10 );
+  incremental_simulation<aig_network> inc_sim( aig, sim, { false } );
+  inc_sim.simulate_all();
+  check_against_full_simulation( aig, inc_sim, sim );
+
+  std::mt19937 rng( 1 );
+  for ( auto num_new_patterns : { 1u, 53u, 64u, 1u, 130u } )
+  {
+    for ( auto i = 0u; i < num_new_patterns; ++i )
+    {
+      std::vector<bool> pattern( aig.num_pis() );
+      std::generate( pattern.begin(), pattern.end(), [&]() { return rng() & 1; } );
+      sim.add_pattern( pattern );
+    }
+
+    /* only the TFI of the first PO is extended */
+    auto const po = aig.get_node( aig.po_at( 0 ) );
+    auto const num_extended = inc_sim.stats().num_extended_nodes;
+    CHECK( inc_sim[po].num_bits() == sim.num_bits() );
+    CHECK( inc_sim.stats().num_extended_nodes - num_extended < aig.num_gates() );
+
+    check_against_full_simulation( aig, inc_sim, sim );
+  }
+  CHECK( inc_sim.stats().num_simulated_nodes == aig.num_gates() );
+}
+
+TEST_CASE( "Incremental simulation when modifying the network", "[incremental_simulation]" )
+{
+  xag_network xag;
+  auto const a = xag.create_pi();
+  auto const b = xag.create_pi();
+  auto const c = xag.create_pi();
+  auto const d = xag.create_pi();
+  auto const f1 = xag.create_and( a, b );
+  auto const f2 = xag.create_xor( f1, c );
+  auto const f3 = xag.create_and( f2, d );
+  auto const f4 = xag.create_xor( c, d );
+  xag.create_po( f3 );
+  xag.create_po( f4 );
+
+  fanout_view<xag_network> fxag{ xag };
+  partial_simulator sim( xag.num_pis(), 100 );
+  incremental_simulation<fanout_view<xag_network>> inc_sim( fxag, sim );
+  inc_sim.simulate_all();
+  check_against_full_simulation<fanout_view<xag_network>>( fxag, inc_sim, sim );
+
+  /* change the function of f1; only f1's fanouts are re-simulated */
+  auto const f5 = fxag.create_or( a, b );
+  auto const num_simulated = inc_sim.stats().num_simulated_nodes;
+  fxag.substitute_node( xag.get_node( f1 ), f5 );
+  check_against_full_simulation<fanout_view<xag_network>>( fxag, inc_sim, sim );
+  CHECK( inc_sim.stats().num_invalidated_nodes == 2u );
+  CHECK( inc_sim.stats().num_simulated_nodes - num_simulated == 3u );
+
+  /* patterns added after the modification */
+  sim.add_pattern( { true, false, true, true } );
+  check_against_full_simulation<fanout_view<xag_network>>( fxag, inc_sim, sim );
+}
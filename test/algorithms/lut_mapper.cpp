@@ -4,6 +4,7 @@
 #include <mockturtle/algorithms/equivalence_checking.hpp>
 #include <mockturtle/algorithms/lut_mapper.hpp>
 #include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
@@ -334,3 +335,39 @@ TEST_CASE( "LUT map remapping LUT network", "[lut_mapper]" )
   CHECK( mapped_ntk.num_cells() == 1 );
   CHECK( *equivalence_checking( miter_ntk ) == true );
 }
+
+TEST_CASE( "LUT map with multiple threads", "[lut_mapper]" )
+{
+  aig_network aig;
+
+  std::vector<aig_network::signal> a( 16 ), b( 16 );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+
+  for ( auto const& o : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( o );
+  }
+
+  lut_map_params ps;
+  lut_map_stats st1, st2, st4;
+  const klut_network klut1 = lut_map( aig, ps, &st1 );
+  ps.num_threads = 2u;
+  const klut_network klut2 = lut_map( aig, ps, &st2 );
+  ps.num_threads = 4u;
+  const klut_network klut4 = lut_map( aig, ps, &st4 );
+
+  /* the result does not depend on the number of threads */
+  CHECK( st2.num_threads == 2u );
+  CHECK( st4.num_threads == 4u );
+  CHECK( st2.area == st4.area );
+  CHECK( st2.delay == st4.delay );
+  CHECK( st2.edges == st4.edges );
+  CHECK( klut2.num_gates() == klut4.num_gates() );
+  CHECK( st1.delay == st4.delay );
+  CHECK( st4.time_parallel.count() > 0 );
+
+  /* random simulation, equivalence checking of the multiplier is too slow */
+  partial_simulator sim( aig.num_pis(), 1024u );
+  CHECK( simulate<kitty::partial_truth_table>( aig, sim ) == simulate<kitty::partial_truth_table>( klut4, sim ) );
+}
@@ -0,0 +1,174 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <mockturtle/algorithms/output_equivalence_checking.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/block.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+Ntk make_adder( uint32_t bitwidth, bool use_xor_carry )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+
+  auto carry = ntk.get_constant( false );
+  for ( auto i = 0u; i < bitwidth; ++i )
+  {
+    auto const p = ntk.create_xor( a[i], b[i] );
+    ntk.create_po( ntk.create_xor( p, carry ) );
+    carry = use_xor_carry ? ntk.create_xor( ntk.create_and( a[i], b[i] ), ntk.create_and( p, carry ) )
+                          : ntk.create_maj( a[i], b[i], carry );
+  }
+  ntk.create_po( carry );
+  return ntk;
+}
+
+/* ripple-carry adder of multiple-output full-adder gates, the gate at `inverted_bit` has inverted outputs */
+block_network make_block_adder( uint32_t bitwidth, uint32_t inverted_bit )
+{
+  block_network ntk;
+  std::vector<block_network::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+
+  auto carry = ntk.get_constant( false );
+  for ( auto i = 0u; i < bitwidth; ++i )
+  {
+    auto const fa = i == inverted_bit ? ntk.create_fai( a[i], b[i], carry ) : ntk.create_fa( a[i], b[i], carry );
+    ntk.create_po( ntk.next_output_pin( fa ) );
+    carry = fa;
+  }
+  ntk.create_po( carry );
+  return ntk;
+}
+
+} // namespace
+
+TEST_CASE( "Output equivalence checking of equivalent networks", "[output_equivalence_checking]" )
+{
+  auto const xag = make_adder<xag_network>( 8u, true );
+  auto const xag2 = make_adder<xag_network>( 8u, false );
+  auto const mig = make_adder<mig_network>( 8u, false );
+
+  for ( auto num_threads : { 1u, 3u } )
+  {
+    output_equivalence_checking_params ps;
+    ps.num_threads = num_threads;
+    output_equivalence_checking_stats st;
+    auto result = output_equivalence_checking( xag, mig, ps, &st );
+
+    CHECK( result );
+    CHECK( *result );
+    CHECK( st.output_results.size() == 9u );
+    CHECK( std::all_of( st.output_results.begin(), st.output_results.end(), []( auto const& r ) { return r == true; } ) );
+
+    /* only the least significant sum bits are structurally equal */
+    ps.functional_reduction = false;
+    result = output_equivalence_checking( xag, xag2, ps, &st );
+    CHECK( result );
+    CHECK( *result );
+    CHECK( st.num_structural == 1u );
+    CHECK( st.num_sat_calls == 8u );
+
+    /* functional reduction merges the carry chains */
+    ps.functional_reduction = true;
+    result = output_equivalence_checking( xag, xag2, ps, &st );
+    CHECK( result );
+    CHECK( *result );
+    CHECK( st.num_structural + st.num_sat_calls == 9u );
+  }
+}
+
+TEST_CASE( "Output equivalence checking of non-equivalent networks", "[output_equivalence_checking]" )
+{
+  auto const aig = make_adder<aig_network>( 6u, false );
+  auto xag = make_adder<xag_network>( 6u, true );
+
+  /* replace the fourth sum bit by an AND */
+  xag_network xag2;
+  std::vector<xag_network::signal> pis( xag.num_pis() );
+  std::generate( pis.begin(), pis.end(), [&]() { return xag2.create_pi(); } );
+  auto pos = cleanup_dangling( xag, xag2, pis.begin(), pis.end() );
+  pos[3] = xag2.create_and( pos[3], pis[0] );
+  for ( auto const& f : pos )
+  {
+    xag2.create_po( f );
+  }
+
+  output_equivalence_checking_params ps;
+  ps.num_threads = 2u;
+  output_equivalence_checking_stats st;
+  auto const result = output_equivalence_checking( aig, xag2, ps, &st );
+
+  CHECK( result );
+  CHECK( !*result );
+  for ( auto i = 0u; i < st.output_results.size(); ++i )
+  {
+    REQUIRE( st.output_results[i] );
+    CHECK( *st.output_results[i] == ( i != 3u ) );
+    CHECK( st.counter_examples[i].size() == ( i == 3u ? aig.num_pis() : 0u ) );
+  }
+
+  /* the counter-example distinguishes the outputs */
+  default_simulator<bool> sim( st.counter_examples[3] );
+  CHECK( simulate<bool>( aig, sim )[3] != simulate<bool>( xag2, sim )[3] );
+}
+
+TEST_CASE( "Output equivalence checking with mismatching interfaces", "[output_equivalence_checking]" )
+{
+  auto const aig = make_adder<aig_network>( 4u, false );
+  auto const xag = make_adder<xag_network>( 5u, true );
+  CHECK( !output_equivalence_checking( aig, xag ) );
+}
+
+TEST_CASE( "Output equivalence checking of networks with node functions", "[output_equivalence_checking]" )
+{
+  auto const aig = make_adder<aig_network>( 8u, false );
+  auto const klut = make_adder<klut_network>( 8u, false );
+  auto const block = make_block_adder( 8u, 8u );
+
+  output_equivalence_checking_stats st;
+  auto result = output_equivalence_checking( aig, klut, {}, &st );
+  CHECK( result );
+  CHECK( *result );
+
+  result = output_equivalence_checking( block, aig, {}, &st );
+  CHECK( result );
+  CHECK( *result );
+
+  /* the inverted full adder changes its sum bit and all following outputs */
+  auto const block2 = make_block_adder( 8u, 5u );
+  result = output_equivalence_checking( klut, block2, {}, &st );
+  CHECK( result );
+  CHECK( !*result );
+  CHECK( st.num_simulated == 4u );
+  for ( auto i = 0u; i < st.output_results.size(); ++i )
+  {
+    REQUIRE( st.output_results[i] );
+    CHECK( *st.output_results[i] == ( i < 5u ) );
+  }
+
+  /* without simulation, the difference is found by SAT */
+  output_equivalence_checking_params ps;
+  ps.num_random_patterns = 0u;
+  result = output_equivalence_checking( klut, block2, ps, &st );
+  CHECK( result );
+  CHECK( !*result );
+  CHECK( st.num_simulated == 0u );
+  default_simulator<bool> sim( st.counter_examples[5] );
+  CHECK( simulate<bool>( klut, sim )[5] != simulate<bool>( block2, sim )[5] );
+}
@@ -0,0 +1,126 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+
+#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
+#include <mockturtle/algorithms/parallel_exact_synthesis.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+percy::spec make_spec( kitty::dynamic_truth_table const& function, int fanin, bool aig )
+{
+  percy::spec spec;
+  spec.verbosity = 0;
+  spec.fanin = fanin;
+  if ( aig )
+  {
+    spec.set_primitive( percy::AIG );
+  }
+  spec[0] = function;
+  return spec;
+}
+
+} // namespace
+
+TEST_CASE( "Parallel exact synthesis finds optimum chains", "[parallel_exact_synthesis]" )
+{
+  std::vector<kitty::dynamic_truth_table> functions;
+  for ( auto const& hex : { "e8", "96", "d8", "8ff0", "0770" } )
+  {
+    functions.emplace_back( hex[2] == '\0' ? 3u : 4u );
+    kitty::create_from_hex_string( functions.back(), hex );
+  }
+
+  for ( auto const& [fanin, aig] : std::vector<std::pair<int, bool>>{ { 2, true }, { 2, false }, { 3, false } } )
+  {
+    for ( auto const& f : functions )
+    {
+      auto spec = make_spec( f, fanin, aig );
+      percy::chain expected;
+      REQUIRE( percy::synthesize( spec, expected ) == percy::success );
+
+      parallel_exact_synthesis_params ps;
+      ps.num_threads = 4u;
+      parallel_exact_synthesis_stats st;
+      auto pspec = make_spec( f, fanin, aig );
+      percy::chain c;
+      REQUIRE( parallel_exact_synthesis( pspec, c, ps, &st ) == percy::success );
+      CHECK( c.get_nr_steps() == expected.get_nr_steps() );
+      CHECK( c.simulate()[0] == f );
+      CHECK( st.num_jobs > 0u );
+
+      /* each encoding alone */
+      for ( auto i = 0u; i < 3u; ++i )
+      {
+        ps.num_threads = 2u;
+        ps.use_ssv = i == 0u;
+        ps.use_fences = i == 1u;
+        ps.use_dags = i == 2u;
+        auto sspec = make_spec( f, fanin, aig );
+        percy::chain sc;
+        REQUIRE( parallel_exact_synthesis( sspec, sc, ps ) == percy::success );
+        CHECK( sc.get_nr_steps() == expected.get_nr_steps() );
+        CHECK( sc.simulate()[0] == f );
+      }
+    }
+  }
+}
+
+TEST_CASE( "Parallel exact synthesis respects limits", "[parallel_exact_synthesis]" )
+{
+  kitty::dynamic_truth_table f( 6u );
+  kitty::create_from_hex_string( f, "9a6f0b2c71e435d8" );
+
+  parallel_exact_synthesis_params ps;
+  ps.num_threads = 2u;
+  ps.time_limit = 50u;
+  parallel_exact_synthesis_stats st;
+  auto spec = make_spec( f, 2, true );
+  percy::chain c;
+  CHECK( parallel_exact_synthesis( spec, c, ps, &st ) == percy::timeout );
+  CHECK( to_seconds( st.time_total ) < 5.0 );
+
+  ps.time_limit = 0u;
+  spec = make_spec( f, 2, true );
+  spec.conflict_limit = 100;
+  CHECK( parallel_exact_synthesis( spec, c, ps ) == percy::timeout );
+
+  /* no chain with at most two steps */
+  kitty::dynamic_truth_table parity( 3u );
+  kitty::create_parity( parity );
+  spec = make_spec( parity, 2, true );
+  spec.max_nr_steps = 2;
+  CHECK( parallel_exact_synthesis( spec, c, ps ) == percy::failure );
+}
+
+TEST_CASE( "Exact AIG resynthesis with several threads", "[parallel_exact_synthesis]" )
+{
+  exact_resynthesis_params ps;
+  ps.num_threads = 2u;
+  ps.time_limit = 10000u;
+  exact_aig_resynthesis<aig_network> resyn( false, ps );
+
+  kitty::dynamic_truth_table f( 4u );
+  kitty::create_from_hex_string( f, "cafe" );
+
+  aig_network aig;
+  std::vector<aig_network::signal> pis( 4u );
+  std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+  resyn( aig, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+    aig.create_po( s );
+  } );
+
+  REQUIRE( aig.num_pos() == 1u );
+  default_simulator<kitty::dynamic_truth_table> sim( 4u );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim )[0] == f );
+}
@@ -117,3 +117,38 @@ TEST_CASE( "With observability awareness", "[pattern_generation]" )
   /* the generated pattern should be either 000, 010, or 101 */
   CHECK( ( ( !kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) || ( kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 1 ), 3 ) && kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) ) == true );
 }
+
+TEST_CASE( "Pattern generation with compaction", "[pattern_generation]" )
+{
+  aig_network aig;
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+
+  const auto f = aig.create_and( aig.create_and( a, b ), !aig.create_and( c, d ) );
+  aig.create_po( f );
+
+  bit_packed_simulator sim( aig.num_pis(), 0 );
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    sim.add_pattern( { 0, 0, 0, 0 }, { 1, 1, 1, 1 } );
+    sim.add_pattern( { 1, 1, 1, 1 }, { 1, 1, 1, 1 } );
+  }
+
+  pattern_generation_params ps;
+  ps.compact_patterns = true;
+  pattern_generation_stats st;
+  pattern_generation( aig, sim, ps, &st );
+
+  CHECK( st.num_compacted_patterns >= 6u );
+  CHECK( sim.num_bits() <= 4u );
+
+  /* every gate still takes both values */
+  auto const tts = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+  aig.foreach_gate( [&]( auto const& n ) {
+    CHECK( !kitty::is_const0( tts[n] ) );
+    CHECK( !kitty::is_const0( ~tts[n] ) );
+  } );
+}
@@ -548,3 +548,56 @@ TEST_CASE( "Simulation-guided resubstitution", "[resubstitution]" )
   CHECK( aig.num_pos() == 1 );
   CHECK( aig.num_gates() == 1 );
 }
+
+TEST_CASE( "Parallel resubstitution on partitions", "[resubstitution]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> pis( 4u );
+  std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    auto const& a = pis[i];
+    auto const& b = pis[( i + 1 ) % 4];
+    fs.emplace_back( aig.create_and( a, aig.create_and( b, a ) ) );
+    aig.create_po( fs.back() );
+  }
+  aig.create_po( aig.create_and( fs[0], !fs[2] ) );
+  CHECK( aig.num_gates() == 9u );
+
+  auto const tts = simulate<kitty::static_truth_table<4u>>( aig );
+
+  resubstitution_params ps;
+  ps.num_threads = 3u;
+  ps.partition_size = 2u;
+
+  auto aig1 = aig.clone();
+  resubstitution_stats st;
+  aig_resubstitution( aig1, ps, &st );
+  CHECK( st.num_partitions == 5u );
+  CHECK( aig1.num_pis() == 4u );
+  CHECK( aig1.num_pos() == 5u );
+  CHECK( aig1.num_gates() == 5u );
+  CHECK( simulate<kitty::static_truth_table<4u>>( aig1 ) == tts );
+
+  auto aig2 = aig.clone();
+  sim_resubstitution( aig2, ps );
+  CHECK( aig2.num_gates() == 5u );
+  CHECK( simulate<kitty::static_truth_table<4u>>( aig2 ) == tts );
+
+  /* the result does not depend on the number of threads */
+  ps.num_threads = 2u;
+  auto aig3 = aig.clone();
+  sim_resubstitution( aig3, ps );
+  auto const fanins = []( aig_network const& ntk ) {
+    std::vector<aig_network::signal> fs;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fs.emplace_back( f );
+      } );
+    } );
+    return fs;
+  };
+  CHECK( fanins( aig3 ) == fanins( aig2 ) );
+}
@@ -234,3 +234,79 @@ TEST_CASE( "Synthesize XAGs for all 4-input functions", "[xag_resyn]" )
   CHECK( success_counter == 54622 );
   CHECK( failed_counter == 10914 );
 }
+
+TEST_CASE( "Batched XAG resynthesis of several targets", "[xag_resyn]" )
+{
+  using TT = kitty::partial_truth_table;
+  std::vector<TT> tts;
+  std::vector<uint32_t> divs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    tts.emplace_back( 256u );
+    kitty::create_random( tts.back(), i );
+    divs.emplace_back( i );
+  }
+
+  /* targets built from the divisors, with some random functions that cannot be resynthesized */
+  std::vector<TT> targets;
+  std::vector<uint32_t> max_sizes;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    auto const& a = tts[i];
+    auto const& b = tts[( i + 1 ) % 8];
+    auto const& c = tts[( i + 3 ) % 8];
+    targets.emplace_back( a );
+    targets.emplace_back( a & ~b );
+    targets.emplace_back( ( a ^ b ) | c );
+    targets.emplace_back( ( a & b ) | ( ~b & c ) );
+    targets.emplace_back( 256u );
+    kitty::create_random( targets.back(), 100u + i );
+  }
+  for ( auto i = 0u; i < targets.size(); ++i )
+  {
+    max_sizes.emplace_back( i % 4u );
+  }
+  TT care( 256u );
+  kitty::create_random( care, 42u );
+  care |= tts[2];
+
+  xag_resyn_stats st;
+  xag_resyn_decompose<TT, xag_resyn_static_params_default<TT>> engine( st );
+  auto const results = engine( targets, care, divs.begin(), divs.end(), tts, max_sizes );
+  REQUIRE( results.size() == targets.size() );
+
+  uint32_t num_solved{ 0 };
+  partial_simulator sim( tts );
+  for ( auto i = 0u; i < targets.size(); ++i )
+  {
+    /* same result as the single-target interface */
+    auto const single = engine( targets[i], care, divs.begin(), divs.end(), tts, max_sizes[i] );
+    CHECK( results[i].has_value() == single.has_value() );
+    if ( !results[i] || !single )
+    {
+      continue;
+    }
+    ++num_solved;
+    CHECK( results[i]->raw() == single->raw() );
+    CHECK( results[i]->num_gates() <= max_sizes[i] );
+
+    xag_network xag;
+    decode( xag, *results[i] );
+    auto const ans = simulate<TT, xag_network, partial_simulator>( xag, sim )[0];
+    CHECK( kitty::implies( targets[i] & care, ans ) );
+    CHECK( kitty::implies( ~targets[i] & care, ~ans ) );
+  }
+  CHECK( num_solved > 0u );
+
+  /* without size limits */
+  auto const unlimited = engine( targets, care, divs.begin(), divs.end(), tts );
+  for ( auto i = 0u; i < targets.size(); ++i )
+  {
+    auto const single = engine( targets[i], care, divs.begin(), divs.end(), tts );
+    CHECK( unlimited[i].has_value() == single.has_value() );
+    if ( unlimited[i] && single )
+    {
+      CHECK( unlimited[i]->raw() == single->raw() );
+    }
+  }
+}
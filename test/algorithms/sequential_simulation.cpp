@@ -0,0 +1,111 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/sequential_simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/sequential.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* 2-bit counter with enable, count bits are the outputs */
+sequential<aig_network> make_counter( uint8_t init0, uint8_t init1 )
+{
+  sequential<aig_network> aig;
+  auto const en = aig.create_pi();
+  auto const q0 = aig.create_ro();
+  auto const q1 = aig.create_ro();
+  aig.create_po( q0 );
+  aig.create_po( q1 );
+  aig.create_ri( aig.create_xor( q0, en ) );
+  aig.create_ri( aig.create_xor( q1, aig.create_and( q0, en ) ) );
+
+  mockturtle::register_t r0, r1;
+  r0.init = init0;
+  r1.init = init1;
+  aig.set_register( 0, r0 );
+  aig.set_register( 1, r1 );
+  return aig;
+}
+
+} // namespace
+
+TEST_CASE( "Sequential simulation of a counter", "[sequential_simulation]" )
+{
+  auto const aig = make_counter( 0, 0 );
+
+  sequential_simulation_params ps;
+  ps.num_traces = 100;
+  ps.count_toggles = true;
+  sequential_simulation<sequential<aig_network>> sim( aig, ps );
+
+  /* enable is active in all traces */
+  kitty::partial_truth_table one( ps.num_traces );
+  one = ~one;
+  for ( auto c = 0u; c < 8u; ++c )
+  {
+    sim.step( { one } );
+  }
+  CHECK( sim.num_cycles() == 8u );
+  for ( auto c = 0u; c < 8u; ++c )
+  {
+    auto const& sigs = sim.output_signatures( c );
+    CHECK( sigs[0] == ( ( c & 1 ) ? one : ~one ) );
+    CHECK( sigs[1] == ( ( c & 2 ) ? one : ~one ) );
+  }
+  CHECK( sim.switching_activity( aig.get_node( aig.po_at( 0 ) ) ) == 1.0 );
+  CHECK( sim.switching_activity( aig.get_node( aig.po_at( 1 ) ) ) == 3.0 / 7.0 );
+
+  /* continue with random enables: the state follows the number of enabled cycles */
+  sim.run( 5 );
+  CHECK( sim.num_cycles() == 13u );
+  CHECK( sim.current_state().size() == 2u );
+
+  /* restart from a given initial state */
+  kitty::partial_truth_table q0( ps.num_traces ), q1( ps.num_traces );
+  kitty::create_random( q0 );
+  kitty::create_random( q1 );
+  sim.set_initial_state( { q0, q1 } );
+  CHECK( sim.num_cycles() == 0u );
+  sim.step( { ~one } );
+  CHECK( sim.output_signatures( 0 )[0] == q0 );
+  CHECK( sim.output_signatures( 0 )[1] == q1 );
+  CHECK( sim.current_state()[0] == q0 );
+  CHECK( sim.current_state()[1] == q1 );
+}
+
+TEST_CASE( "Sequential simulation with reset values and random stimuli", "[sequential_simulation]" )
+{
+  auto const aig1 = make_counter( 1, 0 );
+  auto const aig2 = make_counter( 1, 0 );
+  auto const aig3 = make_counter( 1, 2 );
+
+  sequential_simulation<sequential<aig_network>> sim1( aig1 ), sim2( aig2 ), sim3( aig3 );
+  sim1.run( 3 );
+  sim2.run( 3 );
+  sim3.run( 3 );
+
+  for ( auto c = 0u; c < 3u; ++c )
+  {
+    /* identical networks produce identical signatures */
+    CHECK( sim1.output_signatures( c ) == sim2.output_signatures( c ) );
+  }
+  /* the first output does not depend on the unknown register */
+  CHECK( sim1.output_signatures( 2 )[0] == sim3.output_signatures( 2 )[0] );
+  CHECK( kitty::is_const0( sim1.output_signatures( 0 )[1] ) );
+  CHECK( !kitty::is_const0( sim3.output_signatures( 0 )[1] ) );
+
+  /* reset replays the same stimuli */
+  auto const sigs = sim1.output_signatures( 2 );
+  sim1.reset();
+  sim1.run( 3 );
+  CHECK( sim1.output_signatures( 2 ) == sigs );
+}
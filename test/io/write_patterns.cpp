@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <cstdio>
 #include <sstream>
 
 #include <mockturtle/algorithms/simulation.hpp>
@@ -30,3 +31,92 @@ TEST_CASE( "write patterns", "[write_patterns]" )
                       "0d4\n"
                       "19a\n" );
 }
+
+TEST_CASE( "write and stream binary patterns", "[write_patterns]" )
+{
+  partial_simulator sim( 5, 300 );
+  for ( auto i = 0u; i < 17u; ++i )
+  {
+    sim.add_pattern( { i % 2 == 0, i % 3 == 0, true, false, i % 5 == 0 } );
+  }
+  auto const patterns = sim.get_patterns();
+
+  std::stringstream ss;
+  write_binary_patterns( sim, ss, 128u );
+
+  binary_pattern_reader reader( ss );
+  CHECK( reader.is_valid() );
+  CHECK( reader.num_pis() == 5u );
+  CHECK( reader.num_patterns() == 317u );
+  CHECK( reader.block_size() == 128u );
+
+  std::vector<kitty::partial_truth_table> block;
+  std::vector<uint32_t> block_sizes;
+  while ( reader.read_block( block ) )
+  {
+    REQUIRE( block.size() == 5u );
+    for ( auto i = 0u; i < 5u; ++i )
+    {
+      for ( auto j = 0u; j < block[i].num_bits(); ++j )
+      {
+        CHECK( kitty::get_bit( block[i], j ) == kitty::get_bit( patterns[i], 128u * block_sizes.size() + j ) );
+      }
+    }
+    block_sizes.emplace_back( block[0].num_bits() );
+  }
+  CHECK( block_sizes == std::vector<uint32_t>{ 128u, 128u, 61u } );
+  CHECK( reader.num_read_patterns() == 317u );
+}
+
+TEST_CASE( "write binary patterns incrementally", "[write_patterns]" )
+{
+  partial_simulator sim( 3, 100 );
+  auto const patterns = sim.get_patterns();
+
+  std::stringstream ss;
+  {
+    binary_pattern_writer writer( ss, 3u, 64u );
+    writer.add_pattern( { true, false, true } );
+    writer.add_patterns( patterns );
+    writer.add_pattern( { false, true, true } );
+    CHECK( writer.num_patterns() == 102u );
+  }
+
+  binary_pattern_reader reader( ss );
+  CHECK( reader.num_patterns() == 102u );
+  std::vector<kitty::partial_truth_table> all( 3u, kitty::partial_truth_table( 0u ) );
+  while ( reader.append_block( all ) )
+    ;
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    REQUIRE( all[i].num_bits() == 102u );
+    CHECK( kitty::get_bit( all[i], 0 ) == ( i != 1u ) );
+    for ( auto j = 0u; j < 100u; ++j )
+    {
+      CHECK( kitty::get_bit( all[i], j + 1 ) == kitty::get_bit( patterns[i], j ) );
+    }
+    CHECK( kitty::get_bit( all[i], 101 ) == ( i != 0u ) );
+  }
+}
+
+TEST_CASE( "read binary pattern file into partial_simulator", "[write_patterns]" )
+{
+  partial_simulator sim( 4, 1000 );
+  write_binary_patterns( sim, "mockturtle-test-patterns.bin", 256u );
+  CHECK( is_binary_pattern_file( "mockturtle-test-patterns.bin" ) );
+
+  partial_simulator all( "mockturtle-test-patterns.bin" );
+  CHECK( all.num_bits() == 1000u );
+  CHECK( all.get_patterns() == sim.get_patterns() );
+
+  partial_simulator some( "mockturtle-test-patterns.bin", 300u );
+  CHECK( some.num_bits() == 300u );
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    auto tt = sim.get_patterns()[i];
+    tt.resize( 300u );
+    CHECK( some.get_patterns()[i] == tt );
+  }
+
+  std::remove( "mockturtle-test-patterns.bin" );
+}
@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <algorithm>
 #include <vector>
 
 #include <mockturtle/networks/klut.hpp>
@@ -8,6 +9,7 @@
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
 
 using namespace mockturtle;
 
@@ -235,6 +237,39 @@ TEST_CASE( "create nodes and compute a function in a k-LUT network", "[klut]" )
   CHECK( sim_xor == ( xs[0] ^ xs[1] ^ xs[2] ) );
 }
 
+TEST_CASE( "compute LUT functions on partial truth tables in a k-LUT network", "[klut]" )
+{
+  klut_network klut;
+
+  std::vector<klut_network::signal> pis( 8u );
+  std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+
+  std::vector<kitty::partial_truth_table> xs( 8u, kitty::partial_truth_table( 200u ) );
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    kitty::create_random( xs[i], i );
+  }
+
+  for ( auto k = 1u; k <= 8u; ++k )
+  {
+    kitty::dynamic_truth_table function( k );
+    kitty::create_random( function, k + 100u );
+    auto const f = klut.create_node( std::vector<klut_network::signal>( pis.begin(), pis.begin() + k ), function );
+
+    auto const sim = klut.compute( klut.get_node( f ), xs.begin(), xs.begin() + k );
+    CHECK( sim.num_bits() == 200u );
+    for ( auto j = 0u; j < 200u; ++j )
+    {
+      auto index = 0u;
+      for ( auto i = 0u; i < k; ++i )
+      {
+        index |= kitty::get_bit( xs[i], j ) << i;
+      }
+      CHECK( kitty::get_bit( sim, j ) == kitty::get_bit( function, index ) );
+    }
+  }
+}
+
 TEST_CASE( "hash nodes in K-LUT network", "[klut]" )
 {
   klut_network klut;
@@ -0,0 +1,169 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+
+#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/exact_synthesis_cache.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Store and load exact synthesis results", "[exact_synthesis_cache]" )
+{
+  auto const filename = "exact_synthesis_cache_test.bin";
+  std::remove( filename );
+
+  kitty::dynamic_truth_table maj( 3u );
+  kitty::create_majority( maj );
+  percy::spec spec;
+  spec.verbosity = 0;
+  spec.fanin = 2;
+  spec.set_primitive( percy::AIG );
+  spec[0] = maj;
+  percy::chain c;
+  REQUIRE( percy::synthesize( spec, c ) == percy::success );
+
+  auto const config = exact_synthesis_cache::configuration( "test" );
+  {
+    exact_synthesis_cache cache( filename );
+    CHECK( cache.size() == 0u );
+    CHECK( !cache.lookup( config, maj ) );
+    cache.insert( config, maj, exact_synthesis_cache::entry_status::complete, { c } );
+    cache.insert( config, ~maj, exact_synthesis_cache::entry_status::none, {} );
+    CHECK( cache.size() == 2u );
+  }
+
+  /* another cache sharing the file sees the appended records */
+  exact_synthesis_cache reader( filename );
+  exact_synthesis_cache writer( filename );
+  CHECK( reader.size() == 2u );
+  kitty::dynamic_truth_table _xor( 2u );
+  kitty::create_from_hex_string( _xor, "6" );
+  writer.insert( config, _xor, exact_synthesis_cache::entry_status::partial, { c, c } );
+  auto const e_xor = reader.lookup( config, _xor );
+  REQUIRE( e_xor );
+  CHECK( e_xor->status == exact_synthesis_cache::entry_status::partial );
+  CHECK( e_xor->chains.size() == 2u );
+
+  auto const e = reader.lookup( config, maj );
+  REQUIRE( e );
+  CHECK( e->status == exact_synthesis_cache::entry_status::complete );
+  REQUIRE( e->chains.size() == 1u );
+  auto loaded = e->chains[0];
+  CHECK( loaded.get_nr_steps() == c.get_nr_steps() );
+  CHECK( loaded.simulate()[0] == c.simulate()[0] );
+
+  auto const e_none = reader.lookup( config, ~maj );
+  REQUIRE( e_none );
+  CHECK( e_none->status == exact_synthesis_cache::entry_status::none );
+  CHECK( !reader.lookup( exact_synthesis_cache::configuration( "other" ), maj ) );
+
+  /* an incomplete record at the end of the file is ignored */
+  {
+    std::ofstream out( filename, std::ios::binary | std::ios::app );
+    out.write( "\x40\x00\x00\x00\x01\x02", 6 );
+  }
+  exact_synthesis_cache truncated( filename );
+  CHECK( truncated.size() == 3u );
+
+  std::remove( filename );
+}
+
+TEST_CASE( "Exact resynthesis with a persistent cache", "[exact_synthesis_cache]" )
+{
+  auto const filename = "exact_synthesis_cache_resyn_test.bin";
+  std::remove( filename );
+
+  /* NPN-equivalent functions of the same class */
+  std::vector<kitty::dynamic_truth_table> functions;
+  for ( auto const& hex : { "e8", "d4", "8e", "17", "b2" } )
+  {
+    functions.emplace_back( 3u );
+    kitty::create_from_hex_string( functions.back(), hex );
+  }
+
+  auto const run_aig = [&]( std::shared_ptr<exact_synthesis_cache> cache ) {
+    exact_resynthesis_params ps;
+    ps.persistent_cache = cache;
+    exact_aig_resynthesis<aig_network> resyn( false, ps );
+    for ( auto const& f : functions )
+    {
+      aig_network aig;
+      std::vector<aig_network::signal> pis = { aig.create_pi(), aig.create_pi(), aig.create_pi() };
+      resyn( aig, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+        aig.create_po( s );
+      } );
+      REQUIRE( aig.num_pos() == 1u );
+      CHECK( aig.num_gates() == 4u );
+      default_simulator<kitty::dynamic_truth_table> sim( 3u );
+      CHECK( simulate<kitty::dynamic_truth_table>( aig, sim )[0] == f );
+    }
+  };
+
+  auto cache = std::make_shared<exact_synthesis_cache>( filename );
+  run_aig( cache );
+  CHECK( cache->num_misses() == 1u );
+  CHECK( cache->num_hits() == functions.size() - 1u );
+
+  /* a new run reuses the stored result */
+  auto cache2 = std::make_shared<exact_synthesis_cache>( filename );
+  run_aig( cache2 );
+  CHECK( cache2->num_misses() == 0u );
+
+  /* k-LUT networks: negations are absorbed into the LUTs */
+  {
+    exact_resynthesis_params ps;
+    ps.persistent_cache = cache2;
+    exact_resynthesis<klut_network> resyn( 2u, ps );
+    for ( auto const& f : functions )
+    {
+      klut_network klut;
+      std::vector<klut_network::signal> pis = { klut.create_pi(), klut.create_pi(), klut.create_pi() };
+      resyn( klut, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+        klut.create_po( s );
+      } );
+      REQUIRE( klut.num_pos() == 1u );
+      default_simulator<kitty::dynamic_truth_table> sim( 3u );
+      CHECK( simulate<kitty::dynamic_truth_table>( klut, sim )[0] == f );
+    }
+  }
+
+  /* XMGs: the solutions are replayed, and completed when more are requested */
+  {
+    exact_xmg_resynthesis_params ps;
+    ps.num_candidates = 3u;
+    ps.persistent_cache = cache2;
+    exact_xmg_resynthesis<xmg_network> resyn( ps );
+    for ( auto const num_requested : { 1u, 3u, 3u } )
+    {
+      for ( auto const& f : functions )
+      {
+        xmg_network xmg;
+        std::vector<xmg_network::signal> pis = { xmg.create_pi(), xmg.create_pi(), xmg.create_pi() };
+        uint32_t counter{ 0 };
+        resyn( xmg, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+          xmg.create_po( s );
+          return ++counter < num_requested;
+        } );
+        REQUIRE( xmg.num_pos() >= 1u );
+        default_simulator<kitty::dynamic_truth_table> sim( 3u );
+        for ( auto const& tt : simulate<kitty::dynamic_truth_table>( xmg, sim ) )
+        {
+          CHECK( tt == f );
+        }
+      }
+    }
+  }
+
+  std::remove( filename );
+}
@@ -0,0 +1,154 @@
+#include <catch.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/index_list/compiled_simulator.hpp>
+#include <mockturtle/utils/index_list/index_list.hpp>
+
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+void check_compiled_network( Ntk const& ntk )
+{
+  auto const prog = compile_network( ntk );
+  CHECK( prog.num_inputs == ntk.num_pis() );
+  CHECK( prog.num_outputs() == ntk.num_pos() );
+
+  /* complete simulation */
+  std::vector<kitty::dynamic_truth_table> xs( ntk.num_pis(), kitty::dynamic_truth_table( ntk.num_pis() ) );
+  std::vector<kitty::dynamic_truth_table const*> xs_r;
+  for ( auto i = 0u; i < ntk.num_pis(); ++i )
+  {
+    kitty::create_nth_var( xs[i], i );
+    xs_r.emplace_back( &xs[i] );
+  }
+  compiled_simulator sim;
+  sim( prog, xs_r );
+
+  auto const expected = simulate<kitty::dynamic_truth_table>( ntk, default_simulator<kitty::dynamic_truth_table>( ntk.num_pis() ) );
+  for ( auto i = 0u; i < ntk.num_pos(); ++i )
+  {
+    kitty::dynamic_truth_table tt( ntk.num_pis() );
+    sim.get_output( tt, prog, i );
+    CHECK( tt == expected[i] );
+  }
+
+  /* partial simulation */
+  partial_simulator psim( ntk.num_pis(), 300 );
+  auto const patterns = psim.get_patterns();
+  std::vector<kitty::partial_truth_table const*> ps_r;
+  for ( auto i = 0u; i < ntk.num_pis(); ++i )
+  {
+    ps_r.emplace_back( &patterns[i] );
+  }
+  sim( prog, ps_r );
+  auto const pexpected = simulate<kitty::partial_truth_table>( ntk, psim );
+  for ( auto i = 0u; i < ntk.num_pos(); ++i )
+  {
+    kitty::partial_truth_table tt( 300 );
+    sim.get_output( tt, prog, i );
+    CHECK( tt == pexpected[i] );
+  }
+}
+
+template<class Ntk>
+Ntk make_adder()
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( 4u ), b( 4u );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.create_pi();
+  carry_ripple_adder_inplace( ntk, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  ntk.create_po( !carry );
+  ntk.create_po( ntk.get_constant( true ) );
+  ntk.create_po( !a[0] );
+  return ntk;
+}
+
+} // namespace
+
+TEST_CASE( "compiled simulation of networks", "[compiled_simulator]" )
+{
+  check_compiled_network( make_adder<aig_network>() );
+  check_compiled_network( make_adder<xag_network>() );
+  check_compiled_network( make_adder<mig_network>() );
+  check_compiled_network( make_adder<xmg_network>() );
+}
+
+TEST_CASE( "compiled simulation of index lists", "[compiled_simulator]" )
+{
+  xag_network xag;
+  auto const a = xag.create_pi();
+  auto const b = xag.create_pi();
+  auto const c = xag.create_pi();
+  auto const d = xag.create_pi();
+  auto const t0 = xag.create_and( a, !b );
+  auto const t1 = xag.create_and( c, d );
+  auto const t2 = xag.create_xor( t0, t1 );
+  xag.create_po( !t2 );
+  xag.create_po( t0 );
+
+  std::vector<kitty::static_truth_table<4u>> xs( 4u );
+  std::vector<kitty::static_truth_table<4u> const*> xs_r;
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    kitty::create_nth_var( xs[i], i );
+    xs_r.emplace_back( &xs[i] );
+  }
+  auto const expected = simulate<kitty::static_truth_table<4u>>( xag );
+
+  xag_index_list<true> list_separate;
+  encode( list_separate, xag );
+  xag_index_list<false> list_unified;
+  encode( list_unified, xag );
+
+  compiled_simulator sim;
+  for ( auto const& prog : { compile( list_separate ), compile( list_unified ) } )
+  {
+    CHECK( prog.instructions.size() == 3u );
+    sim( prog, xs_r );
+    for ( auto i = 0u; i < 2u; ++i )
+    {
+      kitty::static_truth_table<4u> tt;
+      sim.get_output( tt, prog, i );
+      CHECK( tt == expected[i] );
+    }
+  }
+
+  mig_network mig;
+  auto const x = mig.create_pi();
+  auto const y = mig.create_pi();
+  auto const z = mig.create_pi();
+  mig.create_po( mig.create_maj( x, !y, mig.create_and( y, z ) ) );
+  mig_index_list mig_list;
+  encode( mig_list, mig );
+  auto const mig_prog = compile( mig_list );
+  CHECK( mig_prog.instructions.size() == 2u );
+
+  std::vector<kitty::static_truth_table<3u>> ys( 3u );
+  std::vector<kitty::static_truth_table<3u> const*> ys_r;
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    kitty::create_nth_var( ys[i], i );
+    ys_r.emplace_back( &ys[i] );
+  }
+  sim( mig_prog, ys_r );
+  kitty::static_truth_table<3u> tt;
+  sim.get_output( tt, mig_prog, 0u );
+  CHECK( tt == simulate<kitty::static_truth_table<3u>>( mig )[0] );
+}
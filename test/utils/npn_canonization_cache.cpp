@@ -0,0 +1,44 @@
+#include <catch.hpp>
+
+#include <mockturtle/utils/npn_canonization_cache.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/static_truth_table.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Precomputed NPN canonization of 4-input functions", "[npn_canonization_cache]" )
+{
+  auto const& table = npn4_canonization_table::get();
+  CHECK( table.num_classes() == 222u );
+
+  kitty::static_truth_table<4u> tt;
+  do
+  {
+    CHECK( table( static_cast<uint16_t>( *tt.cbegin() ) ) == kitty::exact_npn_canonization( tt ) );
+    kitty::next_inplace( tt );
+  } while ( !kitty::is_const0( tt ) );
+}
+
+TEST_CASE( "Cache NPN canonization of larger functions", "[npn_canonization_cache]" )
+{
+  npn_canonization_cache<kitty::dynamic_truth_table> cache( 2u );
+
+  kitty::dynamic_truth_table f4( 4u ), f5( 5u ), g5( 5u ), h5( 5u );
+  kitty::create_from_hex_string( f4, "8ff0" );
+  kitty::create_from_hex_string( f5, "8ff0e8e8" );
+  kitty::create_from_hex_string( g5, "12345678" );
+  kitty::create_from_hex_string( h5, "fedcba98" );
+
+  for ( auto const& f : { f4, f5, g5, f5, h5, g5, f5 } )
+  {
+    CHECK( cache( f ) == kitty::exact_npn_canonization( f ) );
+  }
+
+  /* h5 evicts g5, which was used less recently than f5, and g5 then evicts f5 */
+  CHECK( cache.num_misses() == 5u );
+  CHECK( cache.num_hits() == 2u );
+}
@@ -0,0 +1,97 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/pattern_bank.hpp>
+
+#include <kitty/bit_operations.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Merge patterns with compatible care bits", "[pattern_bank]" )
+{
+  pattern_bank bank( 4u );
+  bank.add_pattern( { 1, 0, 0, 0 }, { 1, 1, 0, 0 } );
+  bank.add_pattern( { 0, 0, 1, 1 }, { 0, 0, 1, 1 } );
+  bank.add_pattern( { 0, 1, 0, 0 }, { 1, 1, 0, 0 } ); /* conflicts with 0, merged into 1 */
+  bank.add_pattern( { 1, 0, 1, 1 }, { 1, 1, 1, 1 } ); /* merged into 0 */
+  bank.add_pattern( { 0, 1, 0, 1 }, { 0, 0, 0, 1 } ); /* merged into 0 */
+
+  CHECK( bank.merge() == 3u );
+  CHECK( bank.num_patterns() == 2u );
+
+  auto const& patterns = bank.get_patterns();
+  auto const& care = bank.get_care();
+  std::vector<bool> const p0 = { 1, 0, 1, 1 }, p1 = { 0, 1, 1, 1 };
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    CHECK( kitty::get_bit( patterns[i], 0 ) == p0[i] );
+    CHECK( kitty::get_bit( patterns[i], 1 ) == p1[i] );
+    CHECK( kitty::get_bit( care[i], 0 ) );
+    CHECK( kitty::get_bit( care[i], 1 ) );
+  }
+}
+
+TEST_CASE( "Score and drop patterns", "[pattern_bank]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( f1, c );
+  aig.create_po( f2 );
+
+  pattern_bank bank( 3u );
+  bank.add_pattern( { 0, 0, 0 } );
+  bank.add_pattern( { 1, 1, 1 } ); /* splits {const} */
+  bank.add_pattern( { 1, 0, 0 } ); /* splits {a} */
+  bank.add_pattern( { 1, 0, 0 } ); /* no new information */
+  bank.add_pattern( { 0, 1, 0 } ); /* splits {b} */
+  bank.add_pattern( { 1, 1, 0 } ); /* splits {f1} */
+  bank.add_pattern( { 1, 1, 1 } ); /* no new information */
+
+  uint32_t num_classes{ 0 };
+  auto const scores = bank.score( aig, &num_classes );
+  CHECK( scores == std::vector<uint32_t>{ std::numeric_limits<uint32_t>::max(), 1u, 1u, 0u, 1u, 1u, 0u } );
+  CHECK( num_classes == 5u ); /* {const}, {a}, {b}, {c, f2}, {f1} */
+
+  pattern_bank_params ps;
+  ps.merge_patterns = false;
+  pattern_bank_stats st;
+  bank.compact( aig, ps, &st );
+  CHECK( st.num_dropped == 2u );
+  CHECK( st.num_classes == 5u );
+  CHECK( bank.num_patterns() == 5u );
+
+  /* with a limit, the first patterns with the highest scores are kept */
+  ps.max_patterns = 2u;
+  bank.compact( aig, ps, &st );
+  CHECK( bank.num_patterns() == 2u );
+  CHECK( !kitty::get_bit( bank.get_patterns()[0], 0 ) );
+  CHECK( kitty::get_bit( bank.get_patterns()[0], 1 ) );
+}
+
+TEST_CASE( "Save and load pattern banks", "[pattern_bank]" )
+{
+  partial_simulator sim( 5u, 100u );
+  pattern_bank bank( sim );
+  CHECK( bank.num_patterns() == 100u );
+
+  auto const filename = "pattern_bank_test.pat";
+  bank.save( filename );
+
+  pattern_bank loaded( 5u );
+  CHECK( loaded.load( filename ) );
+  CHECK( loaded.get_patterns() == sim.get_patterns() );
+
+  pattern_bank other( 4u );
+  CHECK( !other.load( filename ) );
+  CHECK( other.num_patterns() == 0u );
+
+  std::remove( filename );
+}
@@ -0,0 +1,123 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <mockturtle/utils/portfolio_solver.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* n+1 pigeons in n holes, unsatisfiable and hard for CDCL solvers */
+template<class Solver>
+void add_pigeonhole( Solver& solver, uint32_t n )
+{
+  std::vector<std::vector<bill::lit_type>> p( n + 1u );
+  for ( auto i = 0u; i <= n; ++i )
+  {
+    for ( auto j = 0u; j < n; ++j )
+    {
+      p[i].emplace_back( solver.add_variable(), bill::lit_type::polarities::positive );
+    }
+    solver.add_clause( p[i] );
+  }
+  for ( auto j = 0u; j < n; ++j )
+  {
+    for ( auto i = 0u; i <= n; ++i )
+    {
+      for ( auto k = i + 1u; k <= n; ++k )
+      {
+        solver.add_clause( std::vector<bill::lit_type>{ ~p[i][j], ~p[k][j] } );
+      }
+    }
+  }
+}
+
+/* x0 ^ x1 ^ ... ^ x(n-1) = 1 with an XOR chain, satisfiable */
+template<class Solver>
+std::vector<bill::var_type> add_parity( Solver& solver, uint32_t n )
+{
+  std::vector<bill::var_type> vars;
+  for ( auto i = 0u; i < n; ++i )
+  {
+    vars.emplace_back( solver.add_variable() );
+  }
+  auto acc = bill::lit_type( vars[0], bill::lit_type::polarities::positive );
+  for ( auto i = 1u; i < n; ++i )
+  {
+    auto const x = bill::lit_type( vars[i], bill::lit_type::polarities::positive );
+    auto const y = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    solver.add_clause( std::vector<bill::lit_type>{ ~y, acc, x } );
+    solver.add_clause( std::vector<bill::lit_type>{ ~y, ~acc, ~x } );
+    solver.add_clause( std::vector<bill::lit_type>{ y, ~acc, x } );
+    solver.add_clause( std::vector<bill::lit_type>{ y, acc, ~x } );
+    acc = y;
+  }
+  solver.add_clause( std::vector<bill::lit_type>{ acc } );
+  return vars;
+}
+
+} // namespace
+
+TEST_CASE( "Portfolio solver without additional solvers", "[portfolio_solver]" )
+{
+  portfolio_solver<bill::solvers::bsat2> solver;
+  auto const vars = add_parity( solver, 8u );
+  CHECK( solver.solve() == bill::result::states::satisfiable );
+  CHECK( solver.winner() == 0u );
+
+  auto const model = solver.get_model().model();
+  bool parity = false;
+  for ( auto const& v : vars )
+  {
+    parity ^= model.at( v ) == bill::lbool_type::true_;
+  }
+  CHECK( parity );
+
+  CHECK( solver.solve( { bill::lit_type( vars[0], bill::lit_type::polarities::positive ) } ) == bill::result::states::satisfiable );
+  CHECK( solver.get_model().model().at( vars[0] ) == bill::lbool_type::true_ );
+}
+
+TEST_CASE( "Portfolio solver decides hard problems with several solvers", "[portfolio_solver]" )
+{
+  std::vector<portfolio_member> const portfolio = { { bill::solvers::glucose_41 }, { bill::solvers::ghack }, { bill::solvers::bsat2, 7u } };
+
+  portfolio_solver<bill::solvers::bsat2> solver( portfolio );
+  add_pigeonhole( solver, 7u );
+  CHECK( solver.solve() == bill::result::states::unsatisfiable );
+
+  /* a satisfiable problem after restart, the model is taken from the winner */
+  solver.restart();
+  auto const vars = add_parity( solver, 16u );
+  CHECK( solver.solve() == bill::result::states::satisfiable );
+  auto const model = solver.get_model().model();
+  bool parity = false;
+  for ( auto const& v : vars )
+  {
+    parity ^= model.at( v ) == bill::lbool_type::true_;
+  }
+  CHECK( parity );
+
+  /* the conflict limit applies to every solver */
+  portfolio_solver<bill::solvers::glucose_41> limited( { { bill::solvers::bsat2 }, { bill::solvers::bsat2, 7u } } );
+  add_pigeonhole( limited, 10u );
+  CHECK( limited.solve( {}, 2000u ) == bill::result::states::undefined );
+}
+
+TEST_CASE( "Portfolio solver with push and pop", "[portfolio_solver]" )
+{
+  portfolio_solver<bill::solvers::bsat2> solver( { { bill::solvers::glucose_41 } } );
+  auto const a = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+  auto const b = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+  solver.add_clause( std::vector<bill::lit_type>{ a, b } );
+
+  solver.push();
+  add_pigeonhole( solver, 7u );
+  CHECK( solver.solve( { a } ) == bill::result::states::unsatisfiable );
+  solver.pop();
+
+  CHECK( solver.num_variables() == 2u );
+  CHECK( solver.solve( { ~a } ) == bill::result::states::satisfiable );
+  CHECK( solver.get_model().model().at( b.variable() ) == bill::lbool_type::true_ );
+}
@@ -0,0 +1,173 @@
+#include <catch.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/utils/simd_kernels.hpp>
+
+#include <vector>
+
+using namespace mockturtle;
+
+namespace
+{
+
+std::vector<simd::instruction_set> supported_instruction_sets()
+{
+  std::vector<simd::instruction_set> isas{ simd::instruction_set::scalar };
+  if ( static_cast<uint8_t>( simd::detect_instruction_set() ) >= static_cast<uint8_t>( simd::instruction_set::avx2 ) )
+  {
+    isas.emplace_back( simd::instruction_set::avx2 );
+  }
+  if ( simd::detect_instruction_set() == simd::instruction_set::avx512 )
+  {
+    isas.emplace_back( simd::instruction_set::avx512 );
+  }
+  return isas;
+}
+
+template<class TT>
+void check_kernels( TT const& a, TT const& b, TT const& c )
+{
+  auto r = a.construct();
+
+  for ( auto ca : { false, true } )
+  {
+    for ( auto cb : { false, true } )
+    {
+      simd::binary_and( r, a, b, ca, cb );
+      CHECK( r == ( ( ca ? ~a : a ) & ( cb ? ~b : b ) ) );
+      simd::binary_xor( r, a, b, ca, cb );
+      CHECK( r == ( ( ca ? ~a : a ) ^ ( cb ? ~b : b ) ) );
+      simd::ternary_majority( r, a, b, c, ca, cb, !ca );
+      CHECK( r == kitty::ternary_majority( ca ? ~a : a, cb ? ~b : b, !ca ? ~c : c ) );
+      simd::ternary_ite( r, a, b, c, ca, cb, !cb );
+      CHECK( r == kitty::ternary_ite( ca ? ~a : a, cb ? ~b : b, !cb ? ~c : c ) );
+
+      auto const f = ( ca ? ~a : a ) & ( cb ? ~b : b );
+      CHECK( simd::and_equals( a, b, f, ca, cb ) );
+      CHECK( simd::and_equals( a, b, ~f, ca, cb, true ) );
+      CHECK( simd::and_equals_under_care( a, b, f ^ ~c, c, ca, cb ) );
+      CHECK( simd::and_equals_under_care( a, b, f ^ c, c, ca, cb ) == kitty::is_const0( c ) );
+      CHECK( simd::and_is_empty( a, b, ca, cb ) == kitty::is_const0( f ) );
+      CHECK( simd::and_is_empty( a, b, c, ca, cb, true ) == kitty::is_const0( f & ~c ) );
+      CHECK( simd::count_ones_and( a, b, ca, cb ) == kitty::count_ones( f ) );
+    }
+  }
+
+  CHECK( simd::intersection_is_empty( a, b ) == kitty::is_const0( a & b ) );
+  CHECK( ( simd::intersection_is_empty<TT, false, true>( a, b ) ) == kitty::is_const0( ~a & b ) );
+  CHECK( ( simd::intersection_is_empty<TT, false, false>( a, b ) ) == kitty::is_const0( ~a & ~b ) );
+  CHECK( simd::intersection_is_empty( a, a & ~b, b ) );
+  CHECK( ( simd::intersection_is_empty<TT, true, false, true>( a, b, c ) ) == kitty::is_const0( a & ~b & c ) );
+  CHECK( simd::implies( a & b, a ) );
+  CHECK( simd::implies( a, a | c ) );
+
+  CHECK( simd::xor_equals( a, b, a ^ b ) );
+  CHECK( simd::xor_equals( a, b, ~( a ^ b ), true ) );
+  CHECK( simd::xor_equals_under_care( a, b, ( a ^ b ) ^ ~c, c ) );
+  CHECK( simd::equal_under_care( a, ( a & c ) | ( b & ~c ), c ) );
+
+  CHECK( simd::count_ones( a ) == kitty::count_ones( a ) );
+  CHECK( simd::count_ones( ~a ) == kitty::count_ones( ~a ) );
+  CHECK( simd::count_ones_intersection( a, b ) == kitty::count_ones( a & b ) );
+  CHECK( ( simd::count_ones_intersection<TT, false, false>( a, b ) ) == kitty::count_ones( ~a & ~b ) );
+}
+
+} // namespace
+
+TEST_CASE( "SIMD kernels on static truth tables", "[simd_kernels]" )
+{
+  kitty::static_truth_table<4> a4, b4, c4;
+  kitty::static_truth_table<9> a9, b9, c9;
+  kitty::create_random( a4, 1 );
+  kitty::create_random( b4, 2 );
+  kitty::create_random( c4, 3 );
+  kitty::create_random( a9, 4 );
+  kitty::create_random( b9, 5 );
+  kitty::create_random( c9, 6 );
+
+  for ( auto isa : supported_instruction_sets() )
+  {
+    CHECK( simd::set_instruction_set( isa ) );
+    check_kernels( a4, b4, c4 );
+    check_kernels( a9, b9, c9 );
+  }
+  simd::set_instruction_set( simd::detect_instruction_set() );
+}
+
+TEST_CASE( "SIMD kernels on dynamic truth tables", "[simd_kernels]" )
+{
+  for ( auto isa : supported_instruction_sets() )
+  {
+    CHECK( simd::set_instruction_set( isa ) );
+    for ( auto num_vars : { 3u, 6u, 8u, 10u, 12u } )
+    {
+      kitty::dynamic_truth_table a( num_vars ), b( num_vars ), c( num_vars );
+      kitty::create_random( a, num_vars );
+      kitty::create_random( b, num_vars + 1 );
+      kitty::create_random( c, num_vars + 2 );
+      check_kernels( a, b, c );
+    }
+  }
+  simd::set_instruction_set( simd::detect_instruction_set() );
+}
+
+TEST_CASE( "SIMD kernels on partial truth tables", "[simd_kernels]" )
+{
+  for ( auto isa : supported_instruction_sets() )
+  {
+    CHECK( simd::set_instruction_set( isa ) );
+    for ( auto num_bits : { 1u, 63u, 64u, 250u, 256u, 700u, 1029u } )
+    {
+      kitty::partial_truth_table a( num_bits ), b( num_bits ), c( num_bits );
+      kitty::create_random( a, num_bits );
+      kitty::create_random( b, num_bits + 1 );
+      kitty::create_random( c, num_bits + 2 );
+      check_kernels( a, b, c );
+
+      /* padding bits must not be observed by the predicates */
+      kitty::partial_truth_table zero( num_bits );
+      CHECK( simd::intersection_is_empty<kitty::partial_truth_table, false, false>( ~zero, ~zero ) );
+      CHECK( !simd::intersection_is_empty<kitty::partial_truth_table, false, false>( zero, zero ) );
+      CHECK( simd::count_ones( ~zero ) == num_bits );
+    }
+  }
+  simd::set_instruction_set( simd::detect_instruction_set() );
+}
+
+TEST_CASE( "SIMD LUT evaluation on partial truth tables", "[simd_kernels]" )
+{
+  for ( auto isa : supported_instruction_sets() )
+  {
+    CHECK( simd::set_instruction_set( isa ) );
+    for ( auto k = 0u; k <= 6u; ++k )
+    {
+      kitty::dynamic_truth_table function( k );
+      kitty::create_random( function, k );
+
+      std::vector<kitty::partial_truth_table> fanins( k, kitty::partial_truth_table( 700u ) );
+      for ( auto i = 0u; i < k; ++i )
+      {
+        kitty::create_random( fanins[i], i + 10u );
+      }
+
+      kitty::partial_truth_table r( 700u );
+      simd::lut( r, function, fanins.begin(), fanins.end() );
+      for ( auto j = 0u; j < 700u; ++j )
+      {
+        auto index = 0u;
+        for ( auto i = 0u; i < k; ++i )
+        {
+          index |= kitty::get_bit( fanins[i], j ) << i;
+        }
+        CHECK( kitty::get_bit( r, j ) == kitty::get_bit( function, index ) );
+      }
+      CHECK( simd::count_ones( r ) == kitty::count_ones( r ) );
+    }
+  }
+  simd::set_instruction_set( simd::detect_instruction_set() );
+}
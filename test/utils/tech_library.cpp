@@ -1,12 +1,19 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <tuple>
 #include <vector>
 
 #include <lorina/genlib.hpp>
 #include <lorina/super.hpp>
 #include <mockturtle/io/genlib_reader.hpp>
 #include <mockturtle/io/super_reader.hpp>
+#include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
+#include <mockturtle/networks/mig.hpp>
 #include <mockturtle/utils/super_utils.hpp>
 #include <mockturtle/utils/tech_library.hpp>
 
@@ -1114,4 +1121,225 @@ TEST_CASE( "Complete library generation", "[tech_library]" )
 
     kitty::exact_np_enumeration( tt, test_enumeration );
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Library generation with SC-configurations", "[tech_library]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  tech_library_params ps;
+  ps.load_minimum_size_only = false;
+  ps.remove_dominated_gates = false;
+
+  tech_library<4, classification_type::np_configurations> lib_np( gates, ps );
+
+  for ( auto max_candidates : { 256u, 2u } )
+  {
+    ps.max_sc_candidates = max_candidates;
+    tech_library<4, classification_type::sc_configurations> lib( gates, ps );
+
+    CHECK( lib.max_gate_size() == 4 );
+    CHECK( lib.get_inverter_info() == std::make_tuple( 1.0f, 0.9f, 2u ) );
+
+    for ( auto const& gate : gates )
+    {
+      const auto test_enumeration = [&]( auto const& tt, auto, auto ) {
+        auto const supergates = lib.get_supergates( kitty::extend_to<6>( tt ) );
+        REQUIRE( supergates != nullptr );
+
+        /* same matches as with NP-configurations up to the pin assignment of symmetric pins */
+        auto const supergates_np = lib_np.get_supergates( kitty::extend_to<6>( tt ) );
+        REQUIRE( supergates_np != nullptr );
+        const auto key = []( auto const& sgs ) {
+          std::vector<std::tuple<uint32_t, uint32_t, std::array<float, 4>>> keys;
+          for ( auto const& sg : sgs )
+          {
+            keys.emplace_back( sg.root->id, sg.polarity, sg.tdelay );
+          }
+          std::sort( keys.begin(), keys.end() );
+          return keys;
+        };
+        CHECK( key( *supergates ) == key( *supergates_np ) );
+
+        bool found = false;
+        for ( auto const& sg : *supergates )
+        {
+          found |= sg.root->id == gate.id;
+
+          /* leaf j is connected to pin permutation[j] with polarity bit j */
+          auto const& g = sg.root->function;
+          for ( auto x = 0u; x < ( 1u << tt.num_vars() ); ++x )
+          {
+            uint32_t z = 0u;
+            for ( auto j = 0u; j < g.num_vars(); ++j )
+            {
+              z |= ( ( ( x >> j ) ^ ( sg.polarity >> j ) ) & 1 ) << sg.permutation[j];
+            }
+            CHECK( kitty::get_bit( g, z ) == kitty::get_bit( tt, x ) );
+          }
+        }
+
+        CHECK( found );
+      };
+
+      kitty::exact_np_enumeration( gate.function, test_enumeration );
+    }
+  }
+}
+
+template<class Lib>
+static std::vector<std::tuple<uint32_t, float, std::vector<uint8_t>, uint16_t>> supergates_key( Lib const& lib, kitty::dynamic_truth_table const& tt )
+{
+  std::vector<std::tuple<uint32_t, float, std::vector<uint8_t>, uint16_t>> keys;
+  if ( auto const supergates = lib.get_supergates( kitty::extend_to<6>( tt ) ) )
+  {
+    for ( auto const& sg : *supergates )
+    {
+      keys.emplace_back( sg.root->id, sg.area, sg.permutation, sg.polarity );
+    }
+  }
+  return keys;
+}
+
+TEST_CASE( "Library cache", "[tech_library]" )
+{
+  auto const filename = "tech_library_cache_test.bin";
+  std::remove( filename );
+
+  std::vector<gate> gates;
+  std::istringstream in( test_library + "\n" + multioutput_test_library.substr( multioutput_test_library.find( "GATE   ha" ) ) );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library_params ps;
+  ps.load_minimum_size_only = false;
+  ps.remove_dominated_gates = false;
+  tech_library<4, classification_type::np_configurations> reference( gates, ps );
+  CHECK( !reference.loaded_from_cache() );
+
+  ps.cache_filename = filename;
+  tech_library<4, classification_type::np_configurations> generated( gates, ps );
+  CHECK( !generated.loaded_from_cache() );
+  tech_library<4, classification_type::np_configurations> loaded( gates, ps );
+  CHECK( loaded.loaded_from_cache() );
+
+  CHECK( loaded.max_gate_size() == reference.max_gate_size() );
+  CHECK( loaded.get_inverter_info() == reference.get_inverter_info() );
+  CHECK( loaded.get_buffer_info() == reference.get_buffer_info() );
+  CHECK( loaded.num_multioutput_gates() == reference.num_multioutput_gates() );
+  CHECK( loaded.num_multioutput_gates() > 0u );
+  CHECK( loaded.num_structural_gates() == reference.num_structural_gates() );
+
+  for ( auto const& g : gates )
+  {
+    kitty::exact_np_enumeration( g.function, [&]( auto const& tt, auto, auto ) {
+      CHECK( supergates_key( loaded, tt ) == supergates_key( reference, tt ) );
+      if ( tt.num_vars() == 2u )
+      {
+        CHECK( loaded.get_multi_function_id( kitty::extend_to<6>( tt )._bits ) == reference.get_multi_function_id( kitty::extend_to<6>( tt )._bits ) );
+      }
+    } );
+  }
+  CHECK( loaded.get_pattern_id( 3, 3 ) == reference.get_pattern_id( 3, 3 ) );
+  auto const pattern = reference.get_pattern_id( 3, 3 );
+  REQUIRE( pattern != UINT32_MAX );
+  REQUIRE( loaded.get_supergates_pattern( pattern, true ) != nullptr );
+  CHECK( loaded.get_supergates_pattern( pattern, true )->size() == reference.get_supergates_pattern( pattern, true )->size() );
+
+  /* the file is regenerated for different parameters */
+  ps.ignore_symmetries = true;
+  tech_library<4, classification_type::np_configurations> other( gates, ps );
+  CHECK( !other.loaded_from_cache() );
+  ps.ignore_symmetries = false;
+  tech_library<4, classification_type::np_configurations> loaded_again( gates, ps );
+  CHECK( !loaded_again.loaded_from_cache() );
+
+  /* a truncated file is ignored */
+  std::string content;
+  {
+    std::ifstream file( filename, std::ios::binary );
+    content.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+  }
+  {
+    std::ofstream file( filename, std::ios::binary | std::ios::trunc );
+    file.write( content.data(), content.size() / 2 );
+  }
+  tech_library<4, classification_type::np_configurations> truncated( gates, ps );
+  CHECK( !truncated.loaded_from_cache() );
+  for ( auto const& g : gates )
+  {
+    CHECK( supergates_key( truncated, g.function ) == supergates_key( reference, g.function ) );
+  }
+
+  /* SC-configurations */
+  std::remove( filename );
+  tech_library<4, classification_type::sc_configurations> sc_generated( gates, ps );
+  tech_library<4, classification_type::sc_configurations> sc_loaded( gates, ps );
+  CHECK( sc_loaded.loaded_from_cache() );
+  for ( auto const& g : gates )
+  {
+    kitty::exact_np_enumeration( g.function, [&]( auto const& tt, auto, auto ) {
+      CHECK( supergates_key( sc_loaded, tt ) == supergates_key( sc_generated, tt ) );
+    } );
+  }
+
+  std::remove( filename );
+}
+
+TEST_CASE( "Exact library cache", "[tech_library]" )
+{
+  auto const filename = "exact_library_cache_test.bin";
+  std::remove( filename );
+
+  mig_npn_resynthesis resyn{ true };
+  exact_library_params ps;
+  ps.compute_dc_classes = true;
+  exact_library<mig_network> reference( resyn, ps );
+
+  ps.cache_filename = filename;
+  exact_library<mig_network> generated( resyn, ps );
+  CHECK( !generated.loaded_from_cache() );
+  exact_library<mig_network> loaded( resyn, ps );
+  CHECK( loaded.loaded_from_cache() );
+  CHECK( loaded.get_database().num_gates() == reference.get_database().num_gates() );
+  CHECK( loaded.get_database().num_pos() == reference.get_database().num_pos() );
+
+  kitty::static_truth_table<4> tt;
+  do
+  {
+    auto const sg_ref = reference.get_supergates( tt );
+    auto const sg = loaded.get_supergates( tt );
+    REQUIRE( ( sg == nullptr ) == ( sg_ref == nullptr ) );
+    if ( sg != nullptr )
+    {
+      REQUIRE( sg->size() == sg_ref->size() );
+      for ( auto i = 0u; i < sg->size(); ++i )
+      {
+        CHECK( ( *sg )[i].root == ( *sg_ref )[i].root );
+        CHECK( ( *sg )[i].area == ( *sg_ref )[i].area );
+        CHECK( ( *sg )[i].polarity == ( *sg_ref )[i].polarity );
+        CHECK( ( *sg )[i].tdelay == ( *sg_ref )[i].tdelay );
+      }
+
+      /* don't care matches */
+      kitty::static_truth_table<4> dc;
+      dc._bits = 0x000f;
+      uint32_t phase = 0, phase_ref = 0;
+      std::vector<uint8_t> perm = { 0, 1, 2, 3 }, perm_ref = { 0, 1, 2, 3 };
+      auto const dc_sg = loaded.get_supergates( tt, dc, phase, perm );
+      auto const dc_sg_ref = reference.get_supergates( tt, dc, phase_ref, perm_ref );
+      REQUIRE( dc_sg != nullptr );
+      CHECK( dc_sg->front().root == dc_sg_ref->front().root );
+      CHECK( phase == phase_ref );
+      CHECK( perm == perm_ref );
+    }
+    kitty::next_inplace( tt );
+  } while ( !kitty::is_const0( tt ) );
+
+  std::remove( filename );
+}
@@ -0,0 +1,45 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <mockturtle/utils/thread_pool.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Parallel loops on a thread pool", "[thread_pool]" )
+{
+  thread_pool pool( 4u );
+  CHECK( pool.num_threads() == 4u );
+
+  for ( auto const grain : { 1u, 3u, 64u } )
+  {
+    std::vector<uint64_t> values( 1000u, 0u );
+    std::atomic<uint32_t> max_thread_id{ 0u };
+    pool.parallel_for(
+        values.size(), [&]( uint64_t i, uint32_t thread_id ) {
+          values[i] += i * i;
+          uint32_t current = max_thread_id.load();
+          while ( thread_id > current && !max_thread_id.compare_exchange_weak( current, thread_id ) )
+            ;
+        },
+        grain );
+
+    for ( auto i = 0u; i < values.size(); ++i )
+    {
+      CHECK( values[i] == uint64_t( i ) * i );
+    }
+    CHECK( max_thread_id < 4u );
+  }
+
+  /* empty loops and single-threaded pools */
+  pool.parallel_for( 0u, []( uint64_t, uint32_t ) { CHECK( false ); } );
+  thread_pool single( 1u );
+  uint64_t sum = 0u;
+  single.parallel_for( 10u, [&]( uint64_t i, uint32_t thread_id ) {
+    CHECK( thread_id == 0u );
+    sum += i;
+  } );
+  CHECK( sum == 45u );
+}